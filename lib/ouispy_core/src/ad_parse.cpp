@@ -0,0 +1,294 @@
+#include "ad_parse.h"
+#include "company_ids.h"
+
+const char* getCompanyName(uint16_t companyId) {
+    size_t lo = 0, hi = sizeof(COMPANY_IDS) / sizeof(COMPANY_IDS[0]);
+    while (lo < hi) {
+        const size_t mid = (lo + hi) / 2;
+        if (COMPANY_IDS[mid].id < companyId) lo = mid + 1;
+        else hi = mid;
+    }
+    if (lo < sizeof(COMPANY_IDS) / sizeof(COMPANY_IDS[0]) && COMPANY_IDS[lo].id == companyId) {
+        return COMPANY_IDS[lo].name;
+    }
+    return "Unknown";
+}
+
+constexpr bool companyIdsSorted() {
+    for (size_t i = 1; i < sizeof(COMPANY_IDS) / sizeof(COMPANY_IDS[0]); i++) {
+        if (COMPANY_IDS[i - 1].id >= COMPANY_IDS[i].id) return false;
+    }
+    return true;
+}
+static_assert(companyIdsSorted(), "COMPANY_IDS must be sorted by id for binary search");
+
+bool adParse(const uint8_t* payload, uint8_t length, AdView& v) {
+    memset(&v, 0, sizeof(v));
+    uint8_t pos = 0;
+    while (pos < length) {
+        const uint8_t len = payload[pos];
+        if (len == 0) break;                       // early terminator / padding
+        if (pos + 1 + len > length) {
+            v.malformed = true;
+            break;
+        }
+        const uint8_t type = payload[pos + 1];
+        const uint8_t* data = &payload[pos + 2];
+        const uint8_t dataLen = len - 1;
+        pos += len + 1;
+        
+        if (v.fieldCount < AD_MAX_FIELDS) {
+            v.fields[v.fieldCount++] = AdField{type, (uint8_t)(data - payload), dataLen};
+        } else {
+            v.malformed = true;
+        }
+        
+        switch (type) {
+            case 0x01:
+                if (dataLen >= 1) {
+                    v.flags = data[0];
+                    v.hasFlags = true;
+                }
+                break;
+            case 0x08:
+            case 0x09:   // Complete name wins over Shortened
+                if (dataLen && (type == 0x09 || !v.name.len)) {
+                    v.name = AdSpan{data, dataLen};
+                    v.nameComplete = type == 0x09;
+                }
+                break;
+            case 0x02: case 0x03:
+            case 0x04: case 0x05:
+            case 0x06: case 0x07: {
+                const uint8_t width = type <= 0x03 ? 2 : (type <= 0x05 ? 4 : 16);
+                if (v.uuidListCount < AD_MAX_UUID_LISTS && dataLen >= width) {
+                    v.uuids[v.uuidListCount++] = AdUuidList{data, (uint8_t)(dataLen / width), width,
+                                                            (type & 1) != 0};
+                }
+                break;
+            }
+            case 0x0A:
+                if (dataLen >= 1) {
+                    v.txPower = (int8_t)data[0];
+                    v.hasTxPower = true;
+                }
+                break;
+            case 0x16: case 0x20: case 0x21: {
+                const uint8_t width = type == 0x16 ? 2 : (type == 0x20 ? 4 : 16);
+                if (v.serviceDataCount < AD_MAX_SERVICE_DATA && dataLen >= width) {
+                    v.serviceData[v.serviceDataCount++] = AdServiceData{
+                        data, width, AdSpan{data + width, (uint8_t)(dataLen - width)}};
+                }
+                break;
+            }
+            case 0x19:
+                if (dataLen >= 2) {
+                    v.appearance = data[0] | (data[1] << 8);
+                    v.hasAppearance = true;
+                }
+                break;
+            case 0xFF:
+                if (dataLen >= 2 && !v.hasMfg) {
+                    v.companyId = data[0] | (data[1] << 8);
+                    v.mfgData = AdSpan{data + 2, (uint8_t)(dataLen - 2)};
+                    v.hasMfg = true;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return !v.malformed;
+}
+
+static void appendHex(String& out, const uint8_t* data, uint8_t n, bool spaced) {
+    char hex[4];
+    for (uint8_t i = 0; i < n; i++) {
+        snprintf(hex, sizeof(hex), spaced && i + 1 < n ? "%02X " : "%02X", data[i]);
+        out += hex;
+    }
+}
+
+// UUIDs are little-endian on air; print most significant byte first
+static void appendUuid(String& out, const uint8_t* uuid, uint8_t width) {
+    char hex[3];
+    out += "0x";
+    for (uint8_t i = width; i > 0; i--) {
+        snprintf(hex, sizeof(hex), width == 2 ? "%02x" : "%02X", uuid[i - 1]);
+        out += hex;
+    }
+}
+
+void appendFlagNames(String& out, uint8_t flags) {
+    static const char* const NAMES[] = {
+        "LE Limited", "LE General", "No BR/EDR", "LE+BR/EDR Controller", "LE+BR/EDR Host"
+    };
+    bool any = false;
+    for (uint8_t i = 0; i < 5; i++) {
+        if (!(flags & (1 << i))) continue;
+        if (any) out += ", ";
+        out += NAMES[i];
+        any = true;
+    }
+    if (!any) out += "None";
+}
+
+String formatHexDump(const uint8_t* data, uint8_t length) {
+
+    String dump;
+    dump.reserve(length * 5 + 100);
+    
+    dump += "  Offset  Hex                                              ASCII\n";
+    dump += "  ------  -----------------------------------------------  ----------------\n";
+    
+    for (uint8_t i = 0; i < length; i += 16) {
+        char line[100];
+        snprintf(line, sizeof(line), "  0x%04X  ", i);
+        dump += line;
+        
+        for (uint8_t j = 0; j < 16; j++) {
+            if (i + j < length) {
+                snprintf(line, sizeof(line), "%02X ", data[i + j]);
+                dump += line;
+            } else {
+                dump += "   ";
+            }
+            if (j == 7) dump += " ";
+        }
+        
+        dump += " ";
+        
+        for (uint8_t j = 0; j < 16 && i + j < length; j++) {
+            char c = data[i + j];
+            dump += (c >= 32 && c <= 126) ? c : '.';
+        }
+        
+        dump += "\n";
+    }
+    
+    return dump;
+}
+
+String formatAdStructures(const uint8_t* payload, const AdView& v) {
+    String parsed;
+    parsed.reserve(512);
+    
+    parsed += "  Legend:\n";
+    parsed += "    Flags | Name | UUIDs | Service Data | Mfg Data | Other\n";
+    parsed += "  ----------------\n";
+    
+    char line[64];
+    for (uint8_t f = 0; f < v.fieldCount; f++) {
+        const AdField& fld = v.fields[f];
+        const uint8_t* data = payload + fld.off;
+        const uint8_t dataLen = fld.len;
+        
+        snprintf(line, sizeof(line), "  [%u] Type 0x%02X: ", f + 1, fld.type);
+        parsed += line;
+        
+        switch (fld.type) {
+            case 0x01:
+                snprintf(line, sizeof(line), "Flags (Length: %u bytes)\n", dataLen);
+                parsed += line;
+                if (dataLen > 0) {
+                    snprintf(line, sizeof(line), "      Data: 0x%x (", data[0]);
+                    parsed += line;
+                    appendFlagNames(parsed, data[0]);
+                    parsed += ")\n";
+                }
+                break;
+                
+            case 0x08:
+            case 0x09:
+                snprintf(line, sizeof(line), "%s Local Name (Length: %u bytes)\n",
+                         fld.type == 0x08 ? "Shortened" : "Complete", dataLen);
+                parsed += line;
+                parsed += "      Name: \"";
+                for (uint8_t i = 0; i < dataLen; i++) parsed += (char)data[i];
+                parsed += "\"\n";
+                break;
+                
+            case 0xFF:
+                snprintf(line, sizeof(line), "Manufacturer Data (Length: %u bytes)\n", dataLen);
+                parsed += line;
+                if (dataLen >= 2) {
+                    const uint16_t companyId = data[0] | (data[1] << 8);
+                    snprintf(line, sizeof(line), "      Company: 0x%04x (", companyId);
+                    parsed += line;
+                    parsed += getCompanyName(companyId);
+                    parsed += ")";
+                    if (dataLen > 2) {
+                        parsed += ", Data: ";
+                        appendHex(parsed, data + 2, (dataLen < 32 ? dataLen : 32) - 2, false);
+                        if (dataLen > 32) parsed += "...";
+                    }
+                    parsed += "\n";
+                }
+                break;
+                
+            case 0x02: case 0x03:
+            case 0x04: case 0x05:
+            case 0x06: case 0x07: {
+                const uint8_t width = fld.type <= 0x03 ? 2 : (fld.type <= 0x05 ? 4 : 16);
+                snprintf(line, sizeof(line), "%s %u-bit UUIDs (Length: %u bytes)\n",
+                         (fld.type & 1) ? "Complete" : "Incomplete", width * 8, dataLen);
+                parsed += line;
+                parsed += "      UUIDs: ";
+                for (uint8_t i = 0; i + width <= dataLen; i += width) {
+                    if (i > 0) parsed += ", ";
+                    appendUuid(parsed, data + i, width);
+                }
+                parsed += "\n";
+                break;
+            }
+            
+            case 0x0A:
+                snprintf(line, sizeof(line), "TX Power Level (Length: %u bytes)\n", dataLen);
+                parsed += line;
+                if (dataLen > 0) {
+                    snprintf(line, sizeof(line), "      Level: %d dBm\n", (int8_t)data[0]);
+                    parsed += line;
+                }
+                break;
+                
+            case 0x16: case 0x20: case 0x21: {
+                const uint8_t width = fld.type == 0x16 ? 2 : (fld.type == 0x20 ? 4 : 16);
+                snprintf(line, sizeof(line), "Service Data - %u-bit UUID (Length: %u bytes)\n",
+                         width * 8, dataLen);
+                parsed += line;
+                if (dataLen >= width) {
+                    parsed += "      UUID: ";
+                    appendUuid(parsed, data, width);
+                    if (dataLen > width) {
+                        parsed += ", Data: ";
+                        const uint8_t n = dataLen - width;
+                        appendHex(parsed, data + width, n < 16 ? n : 16, false);
+                    }
+                    parsed += "\n";
+                }
+                break;
+            }
+            
+            case 0x19:
+                snprintf(line, sizeof(line), "Appearance (Length: %u bytes)\n", dataLen);
+                parsed += line;
+                if (dataLen >= 2) {
+                    snprintf(line, sizeof(line), "      Value: 0x%04X\n", data[0] | (data[1] << 8));
+                    parsed += line;
+                }
+                break;
+                
+            default:
+                snprintf(line, sizeof(line), "Unknown Type (Length: %u bytes)\n", dataLen);
+                parsed += line;
+                parsed += "      Raw Data: ";
+                appendHex(parsed, data, dataLen < 16 ? dataLen : 16, true);
+                if (dataLen > 16) parsed += "...";
+                parsed += "\n";
+                break;
+        }
+    }
+    if (v.malformed) parsed += "  (payload truncated or malformed after this point)\n";
+    
+    return parsed;
+}
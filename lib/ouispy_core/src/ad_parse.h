@@ -0,0 +1,75 @@
+// Advertisement payload parsing and its text rendering.
+// adParse() walks the AD structures once and fills a fixed-size AdView of
+// spans into the caller's payload: no heap, no copies. Consumers (name
+// lookup, rotation fingerprinting, content rules, text reports) all read the
+// same view.
+#pragma once
+
+#include "core_platform.h"
+
+static const uint8_t AD_MAX_FIELDS = 32;        // 64-byte payload / 2-byte minimum structure
+static const uint8_t AD_MAX_UUID_LISTS = 4;
+static const uint8_t AD_MAX_SERVICE_DATA = 4;
+
+struct AdSpan {
+    const uint8_t* data;
+    uint8_t len;
+};
+
+struct AdField {
+    uint8_t type;
+    uint8_t off;                 // value offset in the payload
+    uint8_t len;                 // value length (without the type byte)
+};
+
+struct AdUuidList {
+    const uint8_t* data;         // little-endian, `count` UUIDs of `width` bytes
+    uint8_t count;
+    uint8_t width;               // 2, 4 or 16
+    bool complete;
+};
+
+struct AdServiceData {
+    const uint8_t* uuid;
+    uint8_t uuidWidth;
+    AdSpan data;
+};
+
+struct AdView {
+    AdField fields[AD_MAX_FIELDS];   // every structure, in payload order
+    uint8_t fieldCount;
+    bool malformed;              // length overran the payload or too many fields
+    
+    bool hasFlags;
+    uint8_t flags;
+    bool hasTxPower;
+    int8_t txPower;
+    bool hasAppearance;
+    uint16_t appearance;
+    
+    AdSpan name;                 // not NUL-terminated
+    bool nameComplete;
+    
+    AdUuidList uuids[AD_MAX_UUID_LISTS];
+    uint8_t uuidListCount;
+    
+    bool hasMfg;                 // first Manufacturer Specific Data structure
+    uint16_t companyId;
+    AdSpan mfgData;              // after the company ID
+    
+    AdServiceData serviceData[AD_MAX_SERVICE_DATA];
+    uint8_t serviceDataCount;
+};
+
+// Single pass over the AD structures; every span points into `payload`, which
+// must outlive the view. Structures past a malformed length byte are ignored.
+bool adParse(const uint8_t* payload, uint8_t length, AdView& v);
+
+// Bluetooth SIG company name, "Unknown" if not in company_ids.h
+const char* getCompanyName(uint16_t companyId);
+
+void appendFlagNames(String& out, uint8_t flags);
+String formatHexDump(const uint8_t* data, uint8_t length);
+
+// Text rendering of an AdView for the detailed report
+String formatAdStructures(const uint8_t* payload, const AdView& v);
@@ -0,0 +1,74 @@
+#include "capture_format.h"
+#include "text_util.h"
+
+size_t encodeCaptureRecord(const DeviceTable& table, uint32_t slot, uint8_t* out) {
+    const DeviceRecord& obs = table.hot[slot];
+    const uint64_t mac48 = table.macAt(slot);
+    
+    CaptureRecordHead head;
+    for (int i = 0; i < 6; i++) head.mac[i] = (uint8_t)(mac48 >> (40 - 8 * i));
+    head.addrType = obs.addrType;
+    head.flags = obs.flags;
+    head.rssi = (int8_t)(obs.rssi < -128 ? -128 : obs.rssi);
+    head.reserved = 0;
+    head.lastSeenMs = obs.lastSeenMs;
+    
+    size_t n = sizeof(head);
+    if (obs.flags & DEV_HAS_WIFI_META) {
+        memcpy(out + n, &table.wifi[slot], sizeof(WiFiMeta));
+        n += sizeof(WiFiMeta);
+    }
+    
+    const char* nm = table.name(slot);
+    size_t nameLen = strlen(nm);
+    if (nameLen > 255) nameLen = 255;
+    out[n++] = (uint8_t)nameLen;
+    memcpy(out + n, nm, nameLen);
+    n += nameLen;
+    
+    const uint8_t payloadLen = (obs.flags & DEV_HAS_PAYLOAD) ? obs.payloadLength : 0;
+    out[n++] = payloadLen;
+    if (payloadLen) {
+        memcpy(out + n, table.payload(slot), payloadLen);
+        n += payloadLen;
+    }
+    
+    head.recLen = (uint16_t)(n - sizeof(head.recLen));
+    memcpy(out, &head, sizeof(head));
+    return n;
+}
+
+size_t decodeCaptureRecord(const uint8_t* in, size_t avail, CaptureRecordView& r) {
+    CaptureRecordHead head;
+    if (avail < sizeof(head)) return 0;
+    memcpy(&head, in, sizeof(head));
+    const size_t total = sizeof(head.recLen) + head.recLen;
+    if (total > avail || total < sizeof(head) + 2) return 0;
+    
+    r.mac48 = macFromBytes(head.mac);
+    r.lastSeenMs = head.lastSeenMs;
+    r.addrType = head.addrType;
+    r.flags = head.flags;
+    r.rssi = head.rssi;
+    memset(&r.wifi, 0, sizeof(r.wifi));
+    
+    size_t n = sizeof(head);
+    if (head.flags & DEV_HAS_WIFI_META) {
+        if (n + sizeof(WiFiMeta) + 2 > total) return 0;
+        memcpy(&r.wifi, in + n, sizeof(WiFiMeta));
+        n += sizeof(WiFiMeta);
+    }
+    
+    r.nameLen = in[n++];
+    r.name = in + n;
+    n += r.nameLen;
+    if (n + 1 > total) return 0;
+    
+    r.payloadLen = in[n++];
+    r.payload = in + n;
+    n += r.payloadLen;
+    if (n > total || r.payloadLen > Config::MAX_PAYLOAD_SIZE) return 0;
+    
+    // Bytes past the known fields belong to later format versions
+    return total;
+}
@@ -0,0 +1,61 @@
+// Binary baseline capture format (/baseline_results.bin, /capture.bin and
+// the capture log), shared with the host replay harness.
+#pragma once
+
+#include "core_platform.h"
+#include "device_table.h"
+
+// Binary baseline capture. All fields little-endian, MACs in printed order.
+// File = CaptureHeader, then recordCount records of:
+//   CaptureRecordHead | WiFiMeta (if CAP_* DEV_HAS_WIFI_META) |
+//   u8 nameLen, name | u8 payloadLen, raw AD bytes
+// recLen counts every byte after the recLen field, so decoders can skip
+// records (and trailing fields added by later versions) without parsing.
+static const uint32_t CAPTURE_MAGIC = 0x3150434F;   // "OCP1"
+static const uint16_t CAPTURE_VERSION = 1;
+
+struct __attribute__((packed)) CaptureHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t headerLen;
+    uint8_t mode;             // BaselineMode
+    uint8_t capturePayload;
+    int16_t rssiThreshold;
+    uint32_t durationSecs;
+    uint32_t builtMs;
+    uint32_t recordCount;
+};
+
+struct __attribute__((packed)) CaptureRecordHead {
+    uint16_t recLen;
+    uint8_t mac[6];
+    uint8_t addrType;
+    uint8_t flags;            // DEV_*
+    int8_t rssi;
+    uint8_t reserved;
+    uint32_t lastSeenMs;
+};
+
+static const size_t CAPTURE_RECORD_MAX = sizeof(CaptureRecordHead) + sizeof(WiFiMeta) + 2 + 255 +
+                                         Config::MAX_PAYLOAD_SIZE;
+
+// Encodes one table entry; `out` must hold CAPTURE_RECORD_MAX bytes
+size_t encodeCaptureRecord(const DeviceTable& table, uint32_t slot, uint8_t* out);
+
+// One record as decoded; name and payload point into the input buffer
+struct CaptureRecordView {
+    uint64_t mac48;
+    uint32_t lastSeenMs;
+    uint8_t addrType;
+    uint8_t flags;            // DEV_*
+    int8_t rssi;
+    WiFiMeta wifi;            // valid with DEV_HAS_WIFI_META
+    const uint8_t* name;
+    uint8_t nameLen;
+    const uint8_t* payload;
+    uint8_t payloadLen;
+};
+
+// Decodes the record starting at its recLen field, `avail` bytes readable.
+// Returns the bytes consumed, 0 if truncated or inconsistent.
+size_t decodeCaptureRecord(const uint8_t* in, size_t avail, CaptureRecordView& r);
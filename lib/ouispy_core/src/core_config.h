@@ -0,0 +1,19 @@
+// Limits of the shared core; the firmware's other settings live in main.cpp
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace Config {
+    // Advertisement payloads (legacy AD + scan response)
+    static const uint8_t MAX_PAYLOAD_SIZE = 64;
+    static const size_t MAX_PAYLOAD_MEMORY = 10240;   // per device table
+
+    // Device tables (open addressing, PSRAM). Capacity must be a power of two.
+    static const uint8_t DEVICE_TABLE_MAX_LOAD_PCT = 75;
+    static const uint8_t DEVICE_TABLE_PROBE_LIMIT = 32;
+    static const uint32_t NAME_POOL_BYTES = 32768;   // < 64K, refs are uint16
+    
+    // Content-rule hit counters, shared by the live and retired filter indexes
+    static const uint16_t RULE_HIT_SLOTS = 256;
+}
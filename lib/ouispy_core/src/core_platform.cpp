@@ -0,0 +1,15 @@
+#include "core_platform.h"
+
+#ifdef ARDUINO
+#include "esp_heap_caps.h"
+#endif
+
+void* psramAlloc(size_t bytes) {
+#if defined(ARDUINO) && defined(BOARD_HAS_PSRAM)
+    if (psramFound()) {
+        void* p = heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        if (p) return p;
+    }
+#endif
+    return malloc(bytes);
+}
@@ -0,0 +1,55 @@
+// Platform layer for the radio-independent core (parsing, filters, device
+// table, reports). On the board this is just Arduino + ESP-IDF; on a host
+// (PlatformIO env:native) it supplies the few pieces the core borrows from
+// them: Arduino String, the ESP-IDF Wi-Fi enums and psramAlloc().
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+
+#ifdef ARDUINO
+
+#include <Arduino.h>
+#include "esp_wifi_types.h"
+
+#else
+
+#include "native_string.h"
+
+// Values as in ESP-IDF esp_wifi_types.h; captures store them as raw bytes
+typedef enum {
+    WIFI_AUTH_OPEN = 0,
+    WIFI_AUTH_WEP,
+    WIFI_AUTH_WPA_PSK,
+    WIFI_AUTH_WPA2_PSK,
+    WIFI_AUTH_WPA_WPA2_PSK,
+    WIFI_AUTH_WPA2_ENTERPRISE,
+    WIFI_AUTH_WPA3_PSK,
+    WIFI_AUTH_WPA2_WPA3_PSK,
+    WIFI_AUTH_WAPI_PSK,
+    WIFI_AUTH_MAX
+} wifi_auth_mode_t;
+
+typedef enum {
+    WIFI_CIPHER_TYPE_NONE = 0,
+    WIFI_CIPHER_TYPE_WEP40,
+    WIFI_CIPHER_TYPE_WEP104,
+    WIFI_CIPHER_TYPE_TKIP,
+    WIFI_CIPHER_TYPE_CCMP,
+    WIFI_CIPHER_TYPE_TKIP_CCMP,
+    WIFI_CIPHER_TYPE_AES_CMAC128,
+    WIFI_CIPHER_TYPE_SMS4,
+    WIFI_CIPHER_TYPE_GCMP,
+    WIFI_CIPHER_TYPE_GCMP256,
+    WIFI_CIPHER_TYPE_UNKNOWN
+} wifi_cipher_type_t;
+
+#endif
+
+// Large, long-lived tables go to PSRAM when the module has it (plain malloc
+// on hosts). Free with free().
+void* psramAlloc(size_t bytes);
@@ -0,0 +1,154 @@
+#include "device_table.h"
+#include <algorithm>
+
+bool StringPool::init(uint32_t bytes) {
+    data = (char*)psramAlloc(bytes);
+    buckets = (uint16_t*)psramAlloc(BUCKETS * sizeof(uint16_t));
+    if (!data || !buckets) {
+        free(data);
+        free(buckets);
+        data = nullptr;
+        buckets = nullptr;
+        return false;
+    }
+    size = bytes;
+    clear();
+    return true;
+}
+
+bool DeviceTable::init(uint32_t cap) {
+    if (keys) return true;
+    keys = (uint64_t*)psramAlloc(cap * sizeof(uint64_t));
+    hot = (DeviceRecord*)psramAlloc(cap * sizeof(DeviceRecord));
+    wifi = (WiFiMeta*)psramAlloc(cap * sizeof(WiFiMeta));
+    seq = (uint32_t*)psramAlloc(cap * sizeof(uint32_t));
+    stats = (DeviceStats*)psramAlloc(cap * sizeof(DeviceStats));
+    if (!keys || !hot || !wifi || !seq || !stats ||
+        !names.init(Config::NAME_POOL_BYTES) ||
+        !payloads.init(Config::MAX_PAYLOAD_MEMORY)) {
+        release();
+        return false;
+    }
+    capacity = cap;
+    mask = cap - 1;
+    loadLimit = (uint32_t)((uint64_t)cap * Config::DEVICE_TABLE_MAX_LOAD_PCT / 100);
+    clear();
+    return true;
+}
+
+void DeviceTable::release() {
+    free(keys);
+    free(hot);
+    free(wifi);
+    free(seq);
+    free(stats);
+    free(names.data);
+    free(names.buckets);
+    free(payloads.data);
+    *this = DeviceTable();
+}
+
+DeviceRecord* observeBleAdvert(DeviceTable& t, uint64_t mac48, int rssi, uint8_t addrType, uint32_t now,
+                               const AdView& ad, bool ruleMatch, bool* created) {
+    DeviceRecord* rec = t.upsert(mac48, created);
+    if (!rec) return nullptr;
+    
+    DeviceRecord &o = *rec;
+    setBestRssiEnhanced(o, rssi);
+    t.noteSample(rec, rssi, now);
+    o.lastSeenMs = now;
+    o.addrType = addrType;
+    if (ruleMatch) o.flags |= DEV_RULE_MATCH;
+    t.touch(rec);
+    
+    if (!o.nameRef && ad.name.len) {
+        t.setName(rec, (const char*)ad.name.data, ad.name.len);
+    }
+    return rec;
+}
+
+DeviceRecord* observeWiFiAp(DeviceTable& t, uint64_t mac48, int rssi, uint32_t now,
+                            const char* ssid, size_t ssidLen, const WiFiMeta& meta, bool* newMeta) {
+    DeviceRecord* rec = t.upsert(mac48);
+    if (!rec) return nullptr;
+    
+    DeviceRecord &o = *rec;
+    o.flags |= DEV_WIFI;
+    setBestRssiEnhanced(o, rssi);
+    t.noteSample(rec, rssi, now);
+    o.lastSeenMs = now;
+    t.touch(rec);
+    
+    if (ssidLen > 0 && !o.nameRef) {
+        t.setName(rec, ssid, ssidLen);
+    }
+    
+    const bool fresh = !(o.flags & DEV_HAS_WIFI_META);
+    if (fresh) {
+        o.flags |= DEV_HAS_WIFI_META;
+        if (ssidLen == 0) o.flags |= DEV_HIDDEN;
+        t.wifi[t.slotOf(rec)] = meta;
+    }
+    if (newMeta) *newMeta = fresh;
+    return rec;
+}
+
+const char* const RESULTS_SORT_KEYS[(size_t)ResultsSort::COUNT] = {
+    "rssi", "mean", "samples", "steadiest", "last_seen", "first_seen", "vendor", "channel"
+};
+
+ResultsSort parseResultsSort(const String& s, ResultsSort fallback) {
+    for (size_t i = 0; i < (size_t)ResultsSort::COUNT; i++) {
+        if (s == RESULTS_SORT_KEYS[i]) return (ResultsSort)i;
+    }
+    return fallback;
+}
+
+int64_t resultsSortKey(const DeviceTable& t, uint32_t slot, ResultsSort key) {
+    const DeviceStats& st = t.stats[slot];
+    // Grouping keys: group ascending in the high bits, RSSI in the low 16
+    const int64_t rssiLow = (int64_t)t.hot[slot].rssi + 32768;
+    switch (key) {
+        case ResultsSort::MEAN_RSSI:  return st.samples ? st.meanQ8 : INT32_MIN;
+        case ResultsSort::SAMPLES:    return st.samples;
+        case ResultsSort::STEADIEST:  return st.samples > 1 ? -rssiVarianceQ16(st) : INT64_MIN;
+        case ResultsSort::LAST_SEEN:  return t.hot[slot].lastSeenMs;
+        case ResultsSort::FIRST_SEEN: return -(int64_t)st.firstSeenMs;
+        case ResultsSort::VENDOR: {
+            const int64_t oui = (int64_t)((t.keys[slot] & 0xFFFFFFFFFFFFULL) >> 24);
+            return -oui * 65536 + rssiLow;
+        }
+        case ResultsSort::CHANNEL: {
+            const int64_t ch = (t.hot[slot].flags & DEV_HAS_WIFI_META) ? t.wifi[slot].channel : 256;
+            return -ch * 65536 + rssiLow;
+        }
+        default:                      return t.hot[slot].rssi;
+    }
+}
+
+void collectResultRows(const DeviceTable& t, ResultsSort key, std::vector<uint32_t>& rows, size_t top) {
+    // Keys are computed once per row rather than per comparison: they read
+    // the PSRAM-resident hot/stats arrays, which dominate the sort otherwise
+    struct Keyed {
+        int64_t key;
+        uint32_t slot;
+    };
+    std::vector<Keyed> keyed;
+    keyed.reserve(t.count);
+    for (uint32_t slot = 0; slot < t.capacity; ++slot) {
+        if (t.used(slot)) keyed.push_back({resultsSortKey(t, slot, key), slot});
+    }
+    
+    const auto before = [](const Keyed& a, const Keyed& b) -> bool {
+        return a.key != b.key ? a.key > b.key : a.slot < b.slot;
+    };
+    if (top < keyed.size()) {
+        std::partial_sort(keyed.begin(), keyed.begin() + top, keyed.end(), before);
+    } else {
+        std::sort(keyed.begin(), keyed.end(), before);
+    }
+    
+    rows.clear();
+    rows.reserve(keyed.size());
+    for (const Keyed& k : keyed) rows.push_back(k.slot);
+}
@@ -0,0 +1,324 @@
+// Per-device storage shared by every scan mode: the open-addressing
+// DeviceTable with its name pool and payload arena, the per-device sighting
+// statistics, the aggregation steps that fold one sighting into a record and
+// the result orderings.
+#pragma once
+
+#include "core_platform.h"
+#include "core_config.h"
+#include "ad_parse.h"
+#include <math.h>
+#include <vector>
+
+// ---- Per-device storage, split by access pattern ----
+// Hot: touched on every advertisement and by the results sort (16 bytes).
+// Cold: Wi-Fi metadata in a parallel array, names interned in a StringPool,
+// raw payloads in a bump PayloadArena bounded by MAX_PAYLOAD_MEMORY.
+
+enum : uint8_t {
+    DEV_HAS_RSSI      = 0x01,
+    DEV_WIFI          = 0x02,   // source: Wi-Fi AP (otherwise BLE)
+    DEV_HAS_PAYLOAD   = 0x04,
+    DEV_HAS_WIFI_META = 0x08,
+    DEV_HIDDEN        = 0x10,
+    DEV_RULE_MATCH    = 0x20,   // an advert matched a content filter rule
+};
+
+struct DeviceRecord {
+    uint32_t lastSeenMs;
+    int16_t rssi;
+    uint16_t nameRef;        // StringPool ref, 0 = no name
+    uint16_t payloadOff;     // PayloadArena offset
+    uint8_t payloadLength;   // 0 = no payload
+    uint8_t addrType;
+    uint8_t flags;           // DEV_*
+    uint8_t reserved;
+    uint16_t cluster;        // RotationCluster id, 0 = not correlated
+};
+
+struct WiFiMeta {
+    uint8_t channel;
+    uint8_t authMode;        // wifi_auth_mode_t
+    uint8_t pairwiseCipher;  // wifi_cipher_type_t
+    uint8_t groupCipher;     // wifi_cipher_type_t
+};
+
+// Sighting statistics, parallel to `hot`. Welford's running mean/variance in
+// fixed point (mean Q8, M2 Q16), so ingest is integer-only and constant-space.
+struct DeviceStats {
+    int64_t m2Q16;           // sum of squared deviations, dB^2 * 65536
+    uint32_t firstSeenMs;
+    uint32_t samples;
+    uint32_t snapSamples;    // samples at the last survey snapshot
+    int32_t meanQ8;          // dB * 256
+    int8_t rssiMin;
+    int8_t rssiMax;
+    uint8_t reserved[2];
+};
+
+inline int rssiMean(const DeviceStats& st) {
+    return st.meanQ8 >= 0 ? (st.meanQ8 + 128) >> 8 : -((-st.meanQ8 + 128) >> 8);
+}
+
+// Sample variance in dB^2 * 65536; 0 with fewer than two samples
+inline int64_t rssiVarianceQ16(const DeviceStats& st) {
+    return st.samples > 1 ? st.m2Q16 / (int64_t)(st.samples - 1) : 0;
+}
+
+// Reporting only; the sqrt stays out of the ingest path
+inline float rssiStdDev(const DeviceStats& st) {
+    return sqrtf((float)rssiVarianceQ16(st)) / 256.0f;
+}
+
+// Deduplicating bump allocator for NUL-terminated names. Refs are offset + 1.
+struct StringPool {
+    static const uint16_t BUCKETS = 1024;
+    
+    char* data;
+    uint16_t* buckets;       // ref per bucket, 0 = empty
+    uint32_t size;
+    uint32_t used;
+    
+    StringPool() : data(nullptr), buckets(nullptr), size(0), used(0) {}
+    
+    bool init(uint32_t bytes);
+    
+    void clear() {
+        used = 0;
+        if (buckets) memset(buckets, 0, BUCKETS * sizeof(uint16_t));
+    }
+    
+    const char* get(uint16_t ref) const { return ref ? data + ref - 1 : ""; }
+    
+    // Returns 0 if the pool is full
+    uint16_t intern(const char* s, size_t len) {
+        if (!data || len == 0) return 0;
+        
+        uint32_t h = 2166136261u;
+        for (size_t i = 0; i < len; i++) h = (h ^ (uint8_t)s[i]) * 16777619u;
+        
+        uint16_t b = h & (BUCKETS - 1);
+        for (uint16_t i = 0; i < BUCKETS; i++) {
+            const uint16_t ref = buckets[b];
+            if (ref == 0) break;
+            const char* cand = data + ref - 1;
+            if (strncmp(cand, s, len) == 0 && cand[len] == '\0') return ref;
+            b = (b + 1) & (BUCKETS - 1);
+        }
+        
+        if (used + len + 1 > size || used + 1 > 0xFFFF) return 0;
+        memcpy(data + used, s, len);
+        data[used + len] = '\0';
+        const uint16_t ref = (uint16_t)(used + 1);
+        used += len + 1;
+        if (buckets[b] == 0) buckets[b] = ref;   // table full: still stored, just not deduped
+        return ref;
+    }
+};
+
+struct PayloadArena {
+    uint8_t* data;
+    uint32_t size;
+    uint32_t used;
+    
+    PayloadArena() : data(nullptr), size(0), used(0) {}
+    
+    bool init(uint32_t bytes) {
+        data = (uint8_t*)psramAlloc(bytes);
+        size = data ? bytes : 0;
+        used = 0;
+        return data != nullptr;
+    }
+    
+    // Returns the offset, or -1 when the arena is exhausted
+    int32_t store(const uint8_t* bytes, uint8_t len) {
+        if (!data || used + len > size) return -1;
+        memcpy(data + used, bytes, len);
+        used += len;
+        return (int32_t)(used - len);
+    }
+};
+
+// Fixed-capacity device table keyed by the 48-bit MAC, allocated once in
+// PSRAM. Linear probing, no deletes (clear() resets the whole run).
+// Eviction: a new MAC takes the first free slot within PROBE_LIMIT of its
+// home slot while the table is under MAX_LOAD_PCT; otherwise it replaces the
+// least-recently-seen entry among the slots it probed. Every probed slot is
+// occupied, so lookups of both old and new keys stay correct. Names and
+// payloads of evicted devices stay in the pool/arena until clear().
+struct DeviceTable {
+    static const uint64_t SLOT_USED = 1ULL << 63;
+    
+    uint64_t* keys;              // SLOT_USED | mac48, 0 = empty
+    DeviceRecord* hot;
+    WiFiMeta* wifi;
+    uint32_t* seq;               // change sequence per slot, see touch()
+    DeviceStats* stats;
+    StringPool names;
+    PayloadArena payloads;
+    uint32_t capacity;
+    uint32_t mask;
+    uint32_t count;
+    uint32_t loadLimit;
+    uint32_t evictions;
+    uint32_t seqCounter;         // last sequence handed out; 0 = nothing yet
+    
+    DeviceTable() : keys(nullptr), hot(nullptr), wifi(nullptr), seq(nullptr), stats(nullptr), capacity(0), mask(0),
+                    count(0), loadLimit(0), evictions(0), seqCounter(0) {}
+    
+    bool init(uint32_t cap);
+    void release();
+    
+    void clear() {
+        if (keys) memset(keys, 0, capacity * sizeof(uint64_t));
+        names.clear();
+        payloads.used = 0;
+        count = 0;
+        evictions = 0;
+        seqCounter = 0;
+    }
+    
+    inline uint32_t home(uint64_t mac48) const {
+        return (uint32_t)((mac48 * 0x9E3779B97F4A7C15ULL) >> 40) & mask;
+    }
+    
+    inline bool used(uint32_t slot) const { return keys[slot] != 0; }
+    inline uint64_t macAt(uint32_t slot) const { return keys[slot] & ~SLOT_USED; }
+    inline uint32_t slotOf(const DeviceRecord* r) const { return (uint32_t)(r - hot); }
+    
+    // Marks a record as changed for /baseline_live readers
+    inline void touch(const DeviceRecord* r) { seq[slotOf(r)] = ++seqCounter; }
+    
+    // One RSSI sighting; call alongside setBestRssiEnhanced
+    void noteSample(const DeviceRecord* r, int rssi, uint32_t now) {
+        DeviceStats& st = stats[slotOf(r)];
+        const int8_t v = (int8_t)(rssi < -128 ? -128 : (rssi > 127 ? 127 : rssi));
+        if (st.samples == 0) {
+            st.firstSeenMs = now;
+            st.rssiMin = v;
+            st.rssiMax = v;
+        } else {
+            if (v < st.rssiMin) st.rssiMin = v;
+            if (v > st.rssiMax) st.rssiMax = v;
+        }
+        st.samples++;
+        const int32_t x = (int32_t)v * 256;   // Q8; a shift of a negative value is UB
+        const int32_t delta = x - st.meanQ8;
+        st.meanQ8 += delta / (int32_t)st.samples;
+        st.m2Q16 += (int64_t)delta * (x - st.meanQ8);
+    }
+    
+    inline const char* name(uint32_t slot) const { return names.get(hot[slot].nameRef); }
+    inline const uint8_t* payload(uint32_t slot) const { return payloads.data + hot[slot].payloadOff; }
+    
+    void setName(DeviceRecord* r, const char* s, size_t len) {
+        uint16_t ref = names.intern(s, len);
+        if (ref) r->nameRef = ref;
+    }
+    
+    bool setPayload(DeviceRecord* r, const uint8_t* bytes, uint8_t len) {
+        int32_t off = payloads.store(bytes, len);
+        if (off < 0) return false;
+        r->payloadOff = (uint16_t)off;
+        r->payloadLength = len;
+        r->flags |= DEV_HAS_PAYLOAD;
+        return true;
+    }
+    
+    DeviceRecord* find(uint64_t mac48) {
+        if (!capacity) return nullptr;
+        const uint64_t key = SLOT_USED | mac48;
+        uint32_t slot = home(mac48);
+        for (uint8_t i = 0; i < Config::DEVICE_TABLE_PROBE_LIMIT; i++) {
+            if (keys[slot] == key) return &hot[slot];
+            if (keys[slot] == 0) return nullptr;
+            slot = (slot + 1) & mask;
+        }
+        return nullptr;
+    }
+    
+    // Returns the record for mac48, creating (or evicting for) it if needed.
+    // Null only if the table was never allocated.
+    DeviceRecord* upsert(uint64_t mac48, bool* created = nullptr) {
+        if (!capacity) return nullptr;
+        const uint64_t key = SLOT_USED | mac48;
+        uint32_t slot = home(mac48);
+        uint32_t victim = slot;
+        bool fresh = false;
+        
+        for (uint8_t i = 0; i < Config::DEVICE_TABLE_PROBE_LIMIT; i++) {
+            if (keys[slot] == key) {
+                if (created) *created = false;
+                return &hot[slot];
+            }
+            if (keys[slot] == 0) {
+                // An empty home slot has nothing to evict, so take it regardless
+                if (count < loadLimit || i == 0) {
+                    victim = slot;
+                    fresh = true;
+                }
+                break;
+            }
+            if (hot[slot].lastSeenMs < hot[victim].lastSeenMs) victim = slot;
+            slot = (slot + 1) & mask;
+        }
+        
+        if (fresh) {
+            count++;
+        } else {
+            evictions++;
+        }
+        keys[victim] = key;
+        memset(&hot[victim], 0, sizeof(DeviceRecord));
+        hot[victim].rssi = -127;
+        memset(&wifi[victim], 0, sizeof(WiFiMeta));
+        memset(&stats[victim], 0, sizeof(DeviceStats));
+        if (created) *created = true;
+        return &hot[victim];
+    }
+};
+
+inline void setBestRssiEnhanced(DeviceRecord &o, int rssiDbm) {
+    if (!(o.flags & DEV_HAS_RSSI) || rssiDbm > o.rssi) {
+        o.rssi = (int16_t)rssiDbm;
+        o.flags |= DEV_HAS_RSSI;
+    }
+}
+
+inline const char* deviceSource(const DeviceRecord& o) {
+    return (o.flags & DEV_WIFI) ? "Wi-Fi" : "BLE";
+}
+
+// ---- Aggregation ----
+// Both fold one sighting into the table and mark the record changed. Callers
+// hold whatever lock guards the table. Null only if the table was never
+// allocated.
+
+DeviceRecord* observeBleAdvert(DeviceTable& t, uint64_t mac48, int rssi, uint8_t addrType, uint32_t now,
+                               const AdView& ad, bool ruleMatch, bool* created = nullptr);
+
+// `meta` is stored on the first sighting only; *newMeta reports whether it was
+DeviceRecord* observeWiFiAp(DeviceTable& t, uint64_t mac48, int rssi, uint32_t now,
+                            const char* ssid, size_t ssidLen, const WiFiMeta& meta, bool* newMeta = nullptr);
+
+// ---- Result ordering ----
+enum class ResultsSort : uint8_t {
+    BEST_RSSI, MEAN_RSSI, SAMPLES, STEADIEST, LAST_SEEN, FIRST_SEEN,
+    VENDOR,      // OUI ascending, strongest first within one
+    CHANNEL,     // Wi-Fi channel ascending, BLE after; strongest first within one
+    COUNT
+};
+
+extern const char* const RESULTS_SORT_KEYS[(size_t)ResultsSort::COUNT];
+
+ResultsSort parseResultsSort(const String& s, ResultsSort fallback);
+
+// Integer sort key, larger sorts first
+int64_t resultsSortKey(const DeviceTable& t, uint32_t slot, ResultsSort key);
+
+// Replaces `rows` with the used slots of `t`, highest key first (ties by
+// slot, so paging over an unchanged table is stable). With `top` below the
+// row count only the first `top` rows are ordered (partial sort); the rest
+// follow in no particular order.
+void collectResultRows(const DeviceTable& t, ResultsSort key, std::vector<uint32_t>& rows,
+                       size_t top = SIZE_MAX);
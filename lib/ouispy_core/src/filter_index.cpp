@@ -0,0 +1,319 @@
+#include "filter_index.h"
+#include "text_util.h"
+#include <algorithm>
+#include <new>
+
+int parseHexBytes(const String& s, uint8_t* out, size_t max) {
+    size_t n = 0;
+    int hi = -1;
+    for (size_t i = 0; i < s.length(); i++) {
+        const char c = s[i];
+        if (c == '-') continue;
+        if (!isxdigit(c)) return -1;
+        const int v = c <= '9' ? c - '0' : (toupper(c) - 'A' + 10);
+        if (hi < 0) {
+            hi = v;
+        } else {
+            if (n >= max) return -1;
+            out[n++] = (uint8_t)(hi << 4 | v);
+            hi = -1;
+        }
+    }
+    return hi < 0 ? (int)n : -1;
+}
+
+bool parseContentRule(const String& entry, ContentRule& r) {
+    memset(&r, 0, sizeof(r));
+    const int colon = entry.indexOf(':');
+    if (colon < 0) return false;
+    String kind = entry.substring(0, colon);
+    kind.toLowerCase();
+    String arg = entry.substring(colon + 1);
+    arg.trim();
+    if (!arg.length()) return false;
+    
+    if (kind == "name") {
+        if (arg.length() > sizeof(r.value)) return false;
+        r.kind = RuleKind::NAME;
+        r.len = arg.length();
+        for (uint8_t i = 0; i < r.len; i++) r.value[i] = (uint8_t)tolower(arg[i]);
+        return true;
+    }
+    
+    if (kind == "uuid") {
+        uint8_t be[16];
+        const int n = parseHexBytes(arg, be, sizeof(be));
+        if (n == 2) {
+            r.kind = RuleKind::UUID16;
+            r.id = (uint16_t)(be[0] << 8 | be[1]);
+            return true;
+        }
+        if (n == 16) {
+            r.kind = RuleKind::UUID128;
+            for (int i = 0; i < 16; i++) r.value[i] = be[15 - i];
+            return true;
+        }
+        return false;
+    }
+    
+    if (kind == "mfg") {
+        const int c2 = arg.indexOf(':');
+        uint8_t idBytes[2];
+        if (parseHexBytes(c2 < 0 ? arg : arg.substring(0, c2), idBytes, sizeof(idBytes)) != 2) return false;
+        r.kind = RuleKind::MFG;
+        r.id = (uint16_t)(idBytes[0] << 8 | idBytes[1]);
+        if (c2 < 0) return true;
+        
+        String prefix = arg.substring(c2 + 1);
+        String mask;
+        const int slash = prefix.indexOf('/');
+        if (slash >= 0) {
+            mask = prefix.substring(slash + 1);
+            prefix = prefix.substring(0, slash);
+        }
+        const int n = parseHexBytes(prefix, r.value, sizeof(r.value));
+        if (n <= 0) return false;
+        r.len = n;
+        if (slash < 0) {
+            memset(r.mask, 0xFF, r.len);
+        } else if (parseHexBytes(mask, r.mask, sizeof(r.mask)) != n) {
+            return false;
+        }
+        for (uint8_t i = 0; i < r.len; i++) r.value[i] &= r.mask[i];
+        return true;
+    }
+    return false;
+}
+
+bool isValidFilterEntry(const String& entry) {
+    ContentRule r;
+    return parseContentRule(entry, r) || isValidMAC(entry);
+}
+
+String formatContentRule(const ContentRule& r) {
+    char buf[80];
+    switch (r.kind) {
+        case RuleKind::NAME: {
+            String out = "name:";
+            for (uint8_t i = 0; i < r.len; i++) out += (char)r.value[i];
+            return out;
+        }
+        case RuleKind::UUID16:
+            snprintf(buf, sizeof(buf), "uuid:%04X", r.id);
+            return String(buf);
+        case RuleKind::UUID128: {
+            String out = "uuid:";
+            for (int i = 15; i >= 0; i--) {
+                snprintf(buf, sizeof(buf), "%02X", r.value[i]);
+                out += buf;
+                if (i == 12 || i == 10 || i == 8 || i == 6) out += "-";
+            }
+            return out;
+        }
+        default: {
+            snprintf(buf, sizeof(buf), "mfg:%04X", r.id);
+            String out = buf;
+            if (!r.len) return out;
+            out += ":";
+            bool masked = false;
+            for (uint8_t i = 0; i < r.len; i++) {
+                snprintf(buf, sizeof(buf), "%02X", r.value[i]);
+                out += buf;
+                masked |= r.mask[i] != 0xFF;
+            }
+            if (masked) {
+                out += "/";
+                for (uint8_t i = 0; i < r.len; i++) {
+                    snprintf(buf, sizeof(buf), "%02X", r.mask[i]);
+                    out += buf;
+                }
+            }
+            return out;
+        }
+    }
+}
+
+static int compareRules(const ContentRule& a, const ContentRule& b) {
+    return memcmp(&a, &b, sizeof(ContentRule));
+}
+
+// Position of `r` in t.byRule, or where it would go
+static uint16_t ruleHitFind(const RuleHitTable& t, const ContentRule& r, bool& found) {
+    const uint16_t* it = std::lower_bound(t.byRule, t.byRule + t.used, r,
+        [&t](uint16_t id, const ContentRule& v) { return compareRules(t.rules[id], v) < 0; });
+    const uint16_t pos = (uint16_t)(it - t.byRule);
+    found = pos < t.used && compareRules(t.rules[*it], r) == 0;
+    return pos;
+}
+
+uint16_t ruleHitAcquire(RuleHitTable& t, const ContentRule& r) {
+    bool found = false;
+    const uint16_t pos = ruleHitFind(t, r, found);
+    if (found) {
+        const uint16_t id = t.byRule[pos];
+        t.refs[id]++;
+        return id;
+    }
+    
+    uint16_t id = 0;
+    while (id < Config::RULE_HIT_SLOTS && t.refs[id]) id++;
+    if (id == Config::RULE_HIT_SLOTS) return RuleHitTable::NO_ID;
+    
+    // Free ids have no index left that could still count on them
+    t.rules[id] = r;
+    t.hits[id] = 0;
+    t.refs[id] = 1;
+    memmove(t.byRule + pos + 1, t.byRule + pos, (t.used - pos) * sizeof(uint16_t));
+    t.byRule[pos] = id;
+    t.used++;
+    return id;
+}
+
+void ruleHitRelease(RuleHitTable& t, uint16_t id) {
+    if (id >= Config::RULE_HIT_SLOTS || !t.refs[id] || --t.refs[id]) return;
+    bool found = false;
+    const uint16_t pos = ruleHitFind(t, t.rules[id], found);
+    if (!found) return;
+    memmove(t.byRule + pos, t.byRule + pos + 1, (t.used - pos - 1) * sizeof(uint16_t));
+    t.used--;
+}
+
+FilterIndex* compileFilterIndex(const std::vector<String>& filters, const uint64_t* watchKeys,
+                                uint32_t watchCount, RuleHitTable* hits) {
+    FilterIndex* next = new (std::nothrow) FilterIndex();
+    const uint32_t maxEntries = filters.size() + watchCount;
+    if (next && maxEntries > 0) {
+        next->ouis = (uint32_t*)psramAlloc(maxEntries * sizeof(uint32_t));
+        next->macs = (uint64_t*)psramAlloc(maxEntries * sizeof(uint64_t));
+    }
+    if (next && !filters.empty()) {
+        next->rules = (ContentRule*)psramAlloc(filters.size() * sizeof(ContentRule));
+        next->ruleIds = (uint16_t*)psramAlloc(filters.size() * sizeof(uint16_t));
+    }
+    if (!next || (maxEntries > 0 && (!next->ouis || !next->macs)) ||
+        (!filters.empty() && (!next->rules || !next->ruleIds))) {
+        delete next;
+        return nullptr;
+    }
+    
+    for (size_t i = 0; i < filters.size(); ++i) {
+        if (parseContentRule(filters[i], next->rules[next->ruleCount])) {
+            next->ruleCount++;
+            continue;
+        }
+        uint64_t v = 0;
+        uint8_t digits = parseMacFilter(filters[i], v);
+        if (digits == 6) {
+            next->ouis[next->ouiCount++] = (uint32_t)v;
+        } else if (digits == 12) {
+            next->macs[next->macCount++] = v;
+        }
+    }
+    
+    for (uint32_t i = 0; i < watchCount; ++i) {
+        const uint64_t key = watchKeys[i];
+        if ((key & ~WATCH_VALUE_MASK) == WATCH_KEY_OUI) {
+            next->ouis[next->ouiCount++] = (uint32_t)(key & WATCH_VALUE_MASK);
+        } else {
+            next->macs[next->macCount++] = key & WATCH_VALUE_MASK;
+        }
+    }
+    
+    std::sort(next->ouis, next->ouis + next->ouiCount);
+    next->ouiCount = std::unique(next->ouis, next->ouis + next->ouiCount) - next->ouis;
+    std::sort(next->macs, next->macs + next->macCount);
+    next->macCount = std::unique(next->macs, next->macs + next->macCount) - next->macs;
+    
+    ContentRule* rules = next->rules;
+    std::sort(rules, rules + next->ruleCount, [](const ContentRule& a, const ContentRule& b) {
+        return a.kind != b.kind ? a.kind < b.kind : a.id < b.id;
+    });
+    uint16_t i = 0;
+    while (i < next->ruleCount && rules[i].kind == RuleKind::MFG) i++;
+    next->mfgEnd = i;
+    while (i < next->ruleCount && rules[i].kind == RuleKind::UUID16) i++;
+    next->uuid16End = i;
+    while (i < next->ruleCount && rules[i].kind == RuleKind::UUID128) i++;
+    next->uuid128End = i;
+    
+    // Rules that survived the edit keep their id, and with it their count
+    next->hits = hits;
+    for (uint16_t r = 0; hits && r < next->ruleCount; r++) {
+        next->ruleIds[r] = ruleHitAcquire(*hits, rules[r]);
+    }
+    return next;
+}
+
+bool filterIndexMatchesMac(const FilterIndex* idx, uint64_t mac48) {
+    if (!idx) return false;
+    
+    if (idx->macCount && std::binary_search(idx->macs, idx->macs + idx->macCount, mac48)) {
+        return true;
+    }
+    
+    return idx->ouiCount &&
+           std::binary_search(idx->ouis, idx->ouis + idx->ouiCount, (uint32_t)(mac48 >> 24));
+}
+
+static int matchUuid16Rule(const FilterIndex* idx, uint16_t uuid) {
+    const ContentRule* lo = idx->rules + idx->mfgEnd;
+    const ContentRule* hi = idx->rules + idx->uuid16End;
+    const ContentRule* it = std::lower_bound(lo, hi, uuid,
+        [](const ContentRule& r, uint16_t v) { return r.id < v; });
+    return (it != hi && it->id == uuid) ? (int)(it - idx->rules) : -1;
+}
+
+static int matchUuid128Rule(const FilterIndex* idx, const uint8_t* uuid) {
+    for (uint16_t r = idx->uuid16End; r < idx->uuid128End; r++) {
+        if (memcmp(idx->rules[r].value, uuid, 16) == 0) return r;
+    }
+    return -1;
+}
+
+static int matchUuidRule(const FilterIndex* idx, const uint8_t* uuid, uint8_t width) {
+    if (width == 2) return matchUuid16Rule(idx, uuid[0] | (uuid[1] << 8));
+    if (width == 4) return (uuid[2] | uuid[3]) ? -1 : matchUuid16Rule(idx, uuid[0] | (uuid[1] << 8));
+    return matchUuid128Rule(idx, uuid);
+}
+
+int filterIndexMatchContent(const FilterIndex* idx, const AdView& ad) {
+    if (!idx || !idx->ruleCount) return -1;
+    int hit = -1;
+    
+    if (ad.hasMfg && idx->mfgEnd) {
+        const ContentRule* end = idx->rules + idx->mfgEnd;
+        const ContentRule* it = std::lower_bound((const ContentRule*)idx->rules, end, ad.companyId,
+            [](const ContentRule& r, uint16_t v) { return r.id < v; });
+        for (; hit < 0 && it != end && it->id == ad.companyId; ++it) {
+            if (it->len > ad.mfgData.len) continue;
+            uint8_t i = 0;
+            while (i < it->len && (ad.mfgData.data[i] & it->mask[i]) == it->value[i]) i++;
+            if (i == it->len) hit = it - idx->rules;
+        }
+    }
+    
+    if (hit < 0 && idx->uuid128End > idx->mfgEnd) {
+        for (uint8_t l = 0; hit < 0 && l < ad.uuidListCount; l++) {
+            const AdUuidList& list = ad.uuids[l];
+            for (uint8_t u = 0; hit < 0 && u < list.count; u++) {
+                hit = matchUuidRule(idx, list.data + u * list.width, list.width);
+            }
+        }
+        for (uint8_t d = 0; hit < 0 && d < ad.serviceDataCount; d++) {
+            hit = matchUuidRule(idx, ad.serviceData[d].uuid, ad.serviceData[d].uuidWidth);
+        }
+    }
+    
+    if (hit < 0 && ad.name.len) {
+        for (uint16_t r = idx->uuid128End; hit < 0 && r < idx->ruleCount; r++) {
+            const ContentRule& rule = idx->rules[r];
+            if (rule.len > ad.name.len) continue;
+            uint8_t i = 0;
+            while (i < rule.len && tolower(ad.name.data[i]) == rule.value[i]) i++;
+            if (i == rule.len) hit = r;
+        }
+    }
+    
+    if (hit >= 0 && idx->hits && idx->ruleIds[hit] != RuleHitTable::NO_ID) idx->hits->hits[idx->ruleIds[hit]]++;
+    return hit;
+}
@@ -0,0 +1,99 @@
+// Filter matching. The text filter list (OUIs, full MACs and content rules)
+// plus the watchlist keys compile into one immutable FilterIndex of sorted
+// integer arrays, so a MAC lookup is two binary searches with no lock and no
+// allocation. Publishing and retiring indexes is up to the caller.
+#pragma once
+
+#include "core_platform.h"
+#include "core_config.h"
+#include "ad_parse.h"
+#include <vector>
+
+// ---- Content rules ----
+// Filter lines "mfg:<id>[:<hex prefix>[/<hex mask>]]", "uuid:<16 or 128-bit>"
+// and "name:<prefix>" match on advertisement content, so they still work
+// when the address is randomized. They are compiled into a decision table in
+// the same FilterIndex: rules grouped by kind, MFG and UUID16 sorted by ID
+// for binary search.
+
+enum class RuleKind : uint8_t { MFG, UUID16, UUID128, NAME };
+
+struct ContentRule {
+    RuleKind kind;
+    uint8_t len;                 // MFG: prefix bytes, NAME: chars
+    uint16_t id;                 // MFG: company ID, UUID16: UUID
+    uint8_t value[16];           // MFG prefix, UUID128 (little-endian) or lowercase NAME
+    uint8_t mask[16];            // MFG prefix mask
+};
+
+// Hex digits to bytes, ignoring '-'. Returns byte count, -1 if invalid.
+int parseHexBytes(const String& s, uint8_t* out, size_t max);
+bool parseContentRule(const String& entry, ContentRule& r);
+bool isValidFilterEntry(const String& entry);
+String formatContentRule(const ContentRule& r);
+
+// Watchlist keys are packed as (prefix bits << 48) | value, so one sorted
+// uint64 array holds both OUIs (24 bits) and full MACs (48 bits).
+static const uint64_t WATCH_KEY_OUI = 24ULL << 48;
+static const uint64_t WATCH_KEY_MAC = 48ULL << 48;
+static const uint64_t WATCH_VALUE_MASK = 0xFFFFFFFFFFFFULL;
+
+// Content-rule hit counters live outside the immutable index, so a
+// republish carries nothing over and hits counted on the outgoing index are
+// not lost. Each distinct rule holds a stable id while any index uses it.
+// Ids are acquired by compileFilterIndex() and released when an index is
+// destroyed, both under the caller's filter lock; `hits` has a single
+// writer, the task calling filterIndexMatchContent().
+struct RuleHitTable {
+    static const uint16_t NO_ID = 0xFFFF;    // table full, the rule is not counted
+    
+    ContentRule rules[Config::RULE_HIT_SLOTS];   // by id
+    uint32_t hits[Config::RULE_HIT_SLOTS];       // matching adverts per id
+    uint16_t refs[Config::RULE_HIT_SLOTS];       // indexes using the id, 0 = free
+    uint16_t byRule[Config::RULE_HIT_SLOTS];     // used ids sorted by rule bytes
+    uint16_t used;
+};
+
+uint16_t ruleHitAcquire(RuleHitTable& t, const ContentRule& r);
+void ruleHitRelease(RuleHitTable& t, uint16_t id);
+
+struct FilterIndex {
+    uint32_t* ouis;       // 24-bit OUIs, sorted
+    uint64_t* macs;       // 48-bit full MACs, sorted
+    uint32_t ouiCount;
+    uint32_t macCount;
+    ContentRule* rules;   // grouped by kind: MFG | UUID16 | UUID128 | NAME
+    uint16_t* ruleIds;    // RuleHitTable id per rule
+    RuleHitTable* hits;   // null = hits are not counted
+    uint16_t ruleCount;
+    uint16_t mfgEnd;      // kind boundaries in `rules`
+    uint16_t uuid16End;
+    uint16_t uuid128End;
+    
+    FilterIndex() : ouis(nullptr), macs(nullptr), ouiCount(0), macCount(0), rules(nullptr),
+                    ruleIds(nullptr), hits(nullptr), ruleCount(0), mfgEnd(0), uuid16End(0), uuid128End(0) {}
+    ~FilterIndex() {
+        for (uint16_t r = 0; hits && ruleIds && r < ruleCount; r++) ruleHitRelease(*hits, ruleIds[r]);
+        free(ouis);
+        free(macs);
+        free(rules);
+        free(ruleIds);
+    }
+    
+    uint32_t ruleHitCount(uint16_t r) const {
+        return (hits && ruleIds[r] != RuleHitTable::NO_ID) ? hits->hits[ruleIds[r]] : 0;
+    }
+};
+
+// Compiles the text filters and the watchlist keys into a new index whose
+// rules count hits in `hits` (may be null). Null when out of memory; delete
+// the result when done, under the same lock as the compile.
+FilterIndex* compileFilterIndex(const std::vector<String>& filters, const uint64_t* watchKeys,
+                                uint32_t watchCount, RuleHitTable* hits);
+
+// No allocation; safe from the radio callbacks
+bool filterIndexMatchesMac(const FilterIndex* idx, uint64_t mac48);
+
+// First matching content rule, -1 if none. Counts the hit, so all indexes
+// sharing a RuleHitTable need a single caller (hit counters have a single writer).
+int filterIndexMatchContent(const FilterIndex* idx, const AdView& ad);
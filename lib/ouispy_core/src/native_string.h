@@ -0,0 +1,148 @@
+// Host stand-in for the Arduino String subset the core uses. Same semantics
+// where they differ from std::string (numeric constructors, clamped
+// substring(), in-place toLowerCase()/trim()/replace()). Not used on the board.
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <string>
+
+class String {
+public:
+    String() {}
+    String(const char* s) : s_(s ? s : "") {}
+    String(const std::string& s) : s_(s) {}
+    explicit String(char c) : s_(1, c) {}
+    explicit String(unsigned char v, unsigned char base = 10) { setNum((unsigned long long)v, base); }
+    explicit String(int v, unsigned char base = 10) { setSigned(v, base); }
+    explicit String(unsigned int v, unsigned char base = 10) { setNum(v, base); }
+    explicit String(long v, unsigned char base = 10) { setSigned(v, base); }
+    explicit String(unsigned long v, unsigned char base = 10) { setNum(v, base); }
+    explicit String(long long v, unsigned char base = 10) { setSigned(v, base); }
+    explicit String(unsigned long long v, unsigned char base = 10) { setNum(v, base); }
+    explicit String(float v, unsigned int decimals = 2) { setFloat(v, decimals); }
+    explicit String(double v, unsigned int decimals = 2) { setFloat(v, decimals); }
+
+    unsigned int length() const { return (unsigned int)s_.size(); }
+    bool isEmpty() const { return s_.empty(); }
+    const char* c_str() const { return s_.c_str(); }
+    bool reserve(unsigned int n) { s_.reserve(n); return true; }
+
+    char operator[](unsigned int i) const { return i < s_.size() ? s_[i] : '\0'; }
+    char& operator[](unsigned int i) { return s_[i]; }
+    char charAt(unsigned int i) const { return (*this)[i]; }
+
+    bool concat(const String& o) { s_ += o.s_; return true; }
+    bool concat(const char* o) { if (o) s_ += o; return o != nullptr; }
+    bool concat(const char* o, unsigned int n) { if (o) s_.append(o, n); return o != nullptr; }
+    bool concat(char c) { s_ += c; return true; }
+    bool concat(unsigned char v) { return concat(String(v)); }
+    bool concat(int v) { return concat(String(v)); }
+    bool concat(unsigned int v) { return concat(String(v)); }
+    bool concat(long v) { return concat(String(v)); }
+    bool concat(unsigned long v) { return concat(String(v)); }
+    bool concat(long long v) { return concat(String(v)); }
+    bool concat(unsigned long long v) { return concat(String(v)); }
+    bool concat(float v) { return concat(String(v)); }
+    bool concat(double v) { return concat(String(v)); }
+
+    template <typename T>
+    String& operator+=(const T& v) { concat(v); return *this; }
+
+    friend String operator+(const String& a, const String& b) { String r(a); r.concat(b); return r; }
+    friend String operator+(const String& a, const char* b) { String r(a); r.concat(b); return r; }
+    friend String operator+(const char* a, const String& b) { String r(a); r.concat(b); return r; }
+    friend String operator+(const String& a, char b) { String r(a); r.concat(b); return r; }
+
+    bool equals(const String& o) const { return s_ == o.s_; }
+    bool equals(const char* o) const { return s_ == (o ? o : ""); }
+    bool operator==(const String& o) const { return equals(o); }
+    bool operator==(const char* o) const { return equals(o); }
+    bool operator!=(const String& o) const { return !equals(o); }
+    bool operator!=(const char* o) const { return !equals(o); }
+    bool operator<(const String& o) const { return s_ < o.s_; }
+
+    bool equalsIgnoreCase(const String& o) const {
+        if (o.s_.size() != s_.size()) return false;
+        for (size_t i = 0; i < s_.size(); i++) {
+            if (tolower((unsigned char)s_[i]) != tolower((unsigned char)o.s_[i])) return false;
+        }
+        return true;
+    }
+    bool startsWith(const String& p) const { return s_.compare(0, p.s_.size(), p.s_) == 0; }
+    bool endsWith(const String& p) const {
+        return s_.size() >= p.s_.size() && s_.compare(s_.size() - p.s_.size(), p.s_.size(), p.s_) == 0;
+    }
+
+    int indexOf(char c, unsigned int from = 0) const { return pos(s_.find(c, from)); }
+    int indexOf(const String& t, unsigned int from = 0) const { return pos(s_.find(t.s_, from)); }
+    int lastIndexOf(char c) const { return pos(s_.rfind(c)); }
+
+    String substring(unsigned int left) const { return substring(left, length()); }
+    String substring(unsigned int left, unsigned int right) const {
+        if (left > right) {
+            const unsigned int t = left;
+            left = right;
+            right = t;
+        }
+        if (left >= s_.size()) return String();
+        if (right > s_.size()) right = (unsigned int)s_.size();
+        return String(s_.substr(left, right - left));
+    }
+
+    void toLowerCase() { for (char& c : s_) c = (char)tolower((unsigned char)c); }
+    void toUpperCase() { for (char& c : s_) c = (char)toupper((unsigned char)c); }
+    void trim() {
+        size_t a = 0, b = s_.size();
+        while (a < b && isspace((unsigned char)s_[a])) a++;
+        while (b > a && isspace((unsigned char)s_[b - 1])) b--;
+        s_ = s_.substr(a, b - a);
+    }
+    void replace(const String& find, const String& with) {
+        if (find.s_.empty()) return;
+        size_t at = 0;
+        while ((at = s_.find(find.s_, at)) != std::string::npos) {
+            s_.replace(at, find.s_.size(), with.s_);
+            at += with.s_.size();
+        }
+    }
+
+    long toInt() const { return strtol(s_.c_str(), nullptr, 10); }
+    float toFloat() const { return strtof(s_.c_str(), nullptr); }
+
+private:
+    std::string s_;
+
+    static int pos(size_t p) { return p == std::string::npos ? -1 : (int)p; }
+
+    void setNum(unsigned long long v, unsigned char base) {
+        char buf[66];
+        char* p = buf + sizeof(buf) - 1;
+        *p = '\0';
+        if (base < 2 || base > 36) base = 10;
+        do {
+            const unsigned d = (unsigned)(v % base);
+            *--p = (char)(d < 10 ? '0' + d : 'a' + d - 10);
+            v /= base;
+        } while (v);
+        s_ = p;
+    }
+
+    void setSigned(long long v, unsigned char base) {
+        if (v < 0 && base == 10) {
+            setNum(0ULL - (unsigned long long)v, base);
+            s_.insert(s_.begin(), '-');
+        } else {
+            setNum((unsigned long long)v, base);
+        }
+    }
+
+    void setFloat(double v, unsigned int decimals) {
+        char buf[64];
+        snprintf(buf, sizeof(buf), "%.*f", (int)decimals, v);
+        s_ = buf;
+    }
+};
@@ -0,0 +1,221 @@
+#include "reports.h"
+#include "text_util.h"
+
+// Helper function: Get encryption type string
+const char* getEncryptionType(wifi_auth_mode_t authMode) {
+    switch(authMode) {
+        case WIFI_AUTH_OPEN: return "Open";
+        case WIFI_AUTH_WEP: return "WEP";
+        case WIFI_AUTH_WPA_PSK: return "WPA-PSK";
+        case WIFI_AUTH_WPA2_PSK: return "WPA2-PSK";
+        case WIFI_AUTH_WPA_WPA2_PSK: return "WPA/WPA2-PSK";
+        case WIFI_AUTH_WPA2_ENTERPRISE: return "WPA2-Enterprise";
+        case WIFI_AUTH_WPA3_PSK: return "WPA3-PSK";
+        case WIFI_AUTH_WPA2_WPA3_PSK: return "WPA2/WPA3-PSK";
+        case WIFI_AUTH_WAPI_PSK: return "WAPI-PSK";
+        default: return "Unknown";
+    }
+}
+
+// Helper function: Get cipher type string
+const char* getCipherType(wifi_cipher_type_t cipher) {
+    switch(cipher) {
+        case WIFI_CIPHER_TYPE_NONE: return "None";
+        case WIFI_CIPHER_TYPE_WEP40: return "WEP40";
+        case WIFI_CIPHER_TYPE_WEP104: return "WEP104";
+        case WIFI_CIPHER_TYPE_TKIP: return "TKIP";
+        case WIFI_CIPHER_TYPE_CCMP: return "CCMP (AES)";
+        case WIFI_CIPHER_TYPE_TKIP_CCMP: return "TKIP/CCMP";
+        default: return "Unknown";
+    }
+}
+
+// Helper function: Get band from channel
+const char* getBandFromChannel(uint8_t channel) {
+    if (channel >= 1 && channel <= 14) return "2.4 GHz";
+    if (channel >= 36 && channel <= 165) return "5 GHz";
+    return "Unknown";
+}
+
+// Helper function: Check if channel suggests 40MHz width
+bool isLikely40MHz(uint8_t channel, uint8_t secondaryChannel) {
+    // ESP32 doesn't directly expose this, but we can infer from channel
+    // This is a simplified check
+    return false; // Would need more detailed scan data
+}
+
+void appendSightingsReport(String& report, const DeviceTable& t, uint32_t slot) {
+    const DeviceStats& st = t.stats[slot];
+    if (!st.samples) return;
+    report += "  Sightings:    " + String(st.samples) + " (mean " + String(st.meanQ8 / 256.0f, 1) +
+              ", min " + String(st.rssiMin) + ", max " + String(st.rssiMax) +
+              ", sd " + String(rssiStdDev(st), 1) + " dBm)\n";
+    report += "  Seen:         " + String(st.firstSeenMs / 1000) + "s - " +
+              String(t.hot[slot].lastSeenMs / 1000) + "s since boot\n";
+}
+
+String generateDeviceReport(const DeviceTable& t, uint32_t slot) {
+    const DeviceRecord& obs = t.hot[slot];
+    const String macP = macPrettyU64(t.macAt(slot));
+    String report;
+    report.reserve(1024);
+    
+    report += "================================================================================\n";
+    report += "[BLE-DEVICE] " + macP + "\n";
+    report += "================================================================================\n";
+    
+    report += "[BASIC-INFO]\n";
+    report += "  MAC Address:  " + macP + "\n";
+    report += "  RSSI:         " + String(obs.rssi) + " dBm\n";
+    report += "  Address Type: " + String(obs.addrType == 0 ? "Public" : "Random") + "\n";
+    if (obs.cluster) report += "  Cluster:      #" + String(obs.cluster) + " (rotating address)\n";
+    if (obs.flags & DEV_RULE_MATCH) report += "  Rule Match:   Yes (content filter)\n";
+    appendSightingsReport(report, t, slot);
+    
+    if (obs.nameRef) {
+        report += "  Device Name:  " + String(t.name(slot)) + "\n";
+    }
+    
+    if ((obs.flags & DEV_HAS_PAYLOAD) && obs.payloadLength > 0) {
+        report += "[RAW-PAYLOAD]\n";
+        report += "  Total Length: " + String(obs.payloadLength) + " bytes\n";
+        report += "  Complete Advertisement:\n";
+        report += formatHexDump(t.payload(slot), obs.payloadLength);
+        
+        AdView ad;
+        adParse(t.payload(slot), obs.payloadLength, ad);
+        report += "[AD-STRUCTURES] Advertisement Data Structures:\n";
+        report += formatAdStructures(t.payload(slot), ad);
+    }
+    
+    report += "================================================================================\n\n";
+    
+    return report;
+}
+
+String generateWiFiDeviceReport(const DeviceTable& t, uint32_t slot) {
+    const DeviceRecord& obs = t.hot[slot];
+    const WiFiMeta& meta = t.wifi[slot];
+    const wifi_auth_mode_t authMode = (wifi_auth_mode_t)meta.authMode;
+    const String macP = macPrettyU64(t.macAt(slot));
+    String report;
+    report.reserve(512);
+    
+    report += "================================================================================\n";
+    report += "[WiFi-AP] " + macP + "\n";
+    report += "================================================================================\n";
+    
+    report += "[BASIC-INFO]\n";
+    report += "  MAC Address:  " + macP + "\n";
+    report += "  RSSI:         " + String(obs.rssi) + " dBm\n";
+    report += "  SSID:         " + String(obs.nameRef ? t.name(slot) : "UNKNOWN/HIDDEN") + "\n";
+    appendSightingsReport(report, t, slot);
+    
+    if (obs.flags & DEV_HAS_WIFI_META) {
+        report += "[NETWORK-INFO]\n";
+        report += "  Channel:      " + String(meta.channel) + " (" + String(getBandFromChannel(meta.channel)) + ")\n";
+        report += "  Encryption:   " + String(getEncryptionType(authMode)) + "\n";
+        
+        if (authMode != WIFI_AUTH_OPEN) {
+            report += "  Pairwise:     " + String(getCipherType((wifi_cipher_type_t)meta.pairwiseCipher)) + "\n";
+            report += "  Group:        " + String(getCipherType((wifi_cipher_type_t)meta.groupCipher)) + "\n";
+        }
+        
+        report += "  Hidden SSID:  " + String((obs.flags & DEV_HIDDEN) ? "Yes" : "No") + "\n";
+        
+        report += "[SIGNAL-ANALYSIS]\n";
+        if (obs.rssi >= -50) {
+            report += "  Quality:      Excellent (very close)\n";
+        } else if (obs.rssi >= -60) {
+            report += "  Quality:      Good (close proximity)\n";
+        } else if (obs.rssi >= -70) {
+            report += "  Quality:      Fair (medium range)\n";
+        } else {
+            report += "  Quality:      Weak (far away)\n";
+        }
+        
+        if (strcmp(getBandFromChannel(meta.channel), "2.4 GHz") == 0) {
+            if (meta.channel == 1 || meta.channel == 6 || meta.channel == 11) {
+                report += "  Channel:      Standard (non-overlapping)\n";
+            } else {
+                report += "  Channel:      Non-standard (may overlap)\n";
+            }
+        }
+        
+        report += "[SECURITY-ANALYSIS]\n";
+        if (authMode == WIFI_AUTH_OPEN) {
+            report += "  Status:       INSECURE - Open network\n";
+        } else if (authMode == WIFI_AUTH_WEP) {
+            report += "  Status:       WEAK - WEP is outdated\n";
+        } else if (authMode == WIFI_AUTH_WPA_PSK) {
+            report += "  Status:       WEAK - WPA1 is deprecated\n";
+        } else if (authMode == WIFI_AUTH_WPA2_PSK) {
+            report += "  Status:       GOOD - WPA2 standard\n";
+        } else if (authMode == WIFI_AUTH_WPA3_PSK || authMode == WIFI_AUTH_WPA2_WPA3_PSK) {
+            report += "  Status:       EXCELLENT - WPA3 enabled\n";
+        } else if (authMode == WIFI_AUTH_WPA2_ENTERPRISE) {
+            report += "  Status:       ENTERPRISE - Advanced security\n";
+        }
+    }
+    
+    report += "================================================================================\n\n";
+    return report;
+}
+
+void appendCsvHeader(String& out, bool capturePayload) {
+    out += "MAC,Source,RSSI,Channel,Band,Encryption,Pairwise Cipher,Group Cipher,Hidden,Name,"
+           "Samples,Mean RSSI,Min RSSI,Max RSSI,RSSI StdDev,First Seen ms,Last Seen ms,Cluster,Rule Match";
+    if (capturePayload) out += ",Has Payload,Payload Length";
+    out += "\n";
+}
+
+void appendCsvRow(String& out, const DeviceTable& table, uint32_t slot, bool capturePayload) {
+    const DeviceRecord& obs = table.hot[slot];
+    const WiFiMeta& meta = table.wifi[slot];
+    
+    out += "\"" + macPrettyU64(table.macAt(slot)) + "\",";
+    out += "\"";
+    out += deviceSource(obs);
+    out += "\",";
+    if (obs.flags & DEV_HAS_RSSI) out += String(obs.rssi);
+    out += ",";
+    
+    if (obs.flags & DEV_HAS_WIFI_META) {
+        out += String(meta.channel) + ",";
+        out += "\"";
+        out += getBandFromChannel(meta.channel);
+        out += "\",\"";
+        out += getEncryptionType((wifi_auth_mode_t)meta.authMode);
+        out += "\",\"";
+        out += getCipherType((wifi_cipher_type_t)meta.pairwiseCipher);
+        out += "\",\"";
+        out += getCipherType((wifi_cipher_type_t)meta.groupCipher);
+        out += "\",";
+        out += (obs.flags & DEV_HIDDEN) ? "Yes" : "No";
+    } else {
+        out += ",,,,,"; // 5 empty cells for BLE devices
+    }
+    out += ",";
+    
+    String nm = obs.nameRef ? String(table.name(slot)) : "UNKNOWN";
+    nm.replace("\"", "\"\"");
+    out += "\"" + nm + "\"";
+    
+    const DeviceStats& st = table.stats[slot];
+    out += "," + String(st.samples) + ",";
+    if (st.samples) {
+        out += String(st.meanQ8 / 256.0f, 1) + "," + String(st.rssiMin) + "," + String(st.rssiMax) + ",";
+        out += String(rssiStdDev(st), 2);
+    } else {
+        out += ",,,";
+    }
+    out += "," + String(st.firstSeenMs) + "," + String(obs.lastSeenMs) + ",";
+    if (obs.cluster) out += String(obs.cluster);
+    out += (obs.flags & DEV_RULE_MATCH) ? ",Yes" : ",No";
+    
+    if (capturePayload) {
+        out += (obs.flags & DEV_HAS_PAYLOAD) ? ",Yes," : ",No,";
+        out += String(obs.payloadLength);
+    }
+    out += "\n";
+}
@@ -0,0 +1,20 @@
+// Text renderings of device table entries: the detailed TXT report blocks
+// and CSV rows served by /baseline_results.*, plus the Wi-Fi field names
+// they share.
+#pragma once
+
+#include "core_platform.h"
+#include "device_table.h"
+
+const char* getEncryptionType(wifi_auth_mode_t authMode);
+const char* getCipherType(wifi_cipher_type_t cipher);
+const char* getBandFromChannel(uint8_t channel);
+bool isLikely40MHz(uint8_t channel, uint8_t secondaryChannel);
+
+void appendSightingsReport(String& report, const DeviceTable& t, uint32_t slot);
+String generateDeviceReport(const DeviceTable& t, uint32_t slot);
+String generateWiFiDeviceReport(const DeviceTable& t, uint32_t slot);
+
+// /baseline_results.csv: one header line, then one row per device
+void appendCsvHeader(String& out, bool capturePayload);
+void appendCsvRow(String& out, const DeviceTable& table, uint32_t slot, bool capturePayload);
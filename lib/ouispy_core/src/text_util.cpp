@@ -0,0 +1,110 @@
+#include "text_util.h"
+
+String htmlEscape(const String& str) {
+    String escaped;
+    escaped.reserve(str.length() + 10);
+    
+    for (size_t i = 0; i < str.length(); i++) {
+        switch (str[i]) {
+            case '&': escaped += "&amp;"; break;
+            case '<': escaped += "&lt;"; break;
+            case '>': escaped += "&gt;"; break;
+            case '"': escaped += "&quot;"; break;
+            case '\'': escaped += "&#39;"; break;
+            default: escaped += str[i];
+        }
+    }
+    return escaped;
+}
+
+String jsonEscape(const char* str) {
+    String out;
+    for (const char* p = str; *p; p++) {
+        const char c = *p;
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if ((uint8_t)c < 0x20) {
+            char esc[7];
+            snprintf(esc, sizeof(esc), "\\u%04x", (uint8_t)c);
+            out += esc;
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+String toUpperNoDelim(const String &s) {
+    String out;
+    out.reserve(12);
+    
+    for (size_t i = 0; i < s.length() && out.length() < 12; ++i) {
+        char c = s[i];
+        if (c == ':' || c == '-' || c == ' ' || c == '\r' || c == '\n' || c == '\t') 
+            continue;
+        out += (char)toupper(c);
+    }
+    return out;
+}
+
+bool isValidMAC(const String& mac) {
+    String clean = toUpperNoDelim(mac);
+    
+    if (clean.length() != 6 && clean.length() != 12) {
+        return false;
+    }
+    
+    for (size_t i = 0; i < clean.length(); i++) {
+        if (!isxdigit(clean[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+String macPretty(const String& macNoDelim12) {
+    if (macNoDelim12.length() < 12) return macNoDelim12;
+    
+    String p;
+    p.reserve(17);
+    for (int i = 0; i < 12; i += 2) {
+        if (i) p += ':';
+        p += macNoDelim12.substring(i, i + 2);
+    }
+    return p;
+}
+
+String macPrettyU64(uint64_t mac48) {
+    char buf[18];
+    snprintf(buf, sizeof(buf), "%02X:%02X:%02X:%02X:%02X:%02X",
+             (unsigned)(mac48 >> 40) & 0xFF, (unsigned)(mac48 >> 32) & 0xFF,
+             (unsigned)(mac48 >> 24) & 0xFF, (unsigned)(mac48 >> 16) & 0xFF,
+             (unsigned)(mac48 >> 8) & 0xFF,  (unsigned)mac48 & 0xFF);
+    return String(buf);
+}
+
+void formatMacNoDelim(uint64_t mac48, char out[13]) {
+    snprintf(out, 13, "%04X%08X", (unsigned)(mac48 >> 32) & 0xFFFF, (unsigned)(mac48 & 0xFFFFFFFF));
+}
+
+uint8_t parseMacFilter(const String& entry, uint64_t& value) {
+    String clean = toUpperNoDelim(entry);
+    if (clean.length() != 6 && clean.length() != 12) return 0;
+    
+    uint64_t v = 0;
+    for (size_t i = 0; i < clean.length(); i++) {
+        char c = clean[i];
+        if (!isxdigit(c)) return 0;
+        v = (v << 4) | (uint64_t)(c <= '9' ? c - '0' : c - 'A' + 10);
+    }
+    value = v;
+    return (uint8_t)clean.length();
+}
+
+void safeCopy(char* dest, size_t destSize, const String& src) {
+    size_t len = src.length();
+    if (len >= destSize) len = destSize - 1;
+    memcpy(dest, src.c_str(), len);
+    dest[len] = '\0';
+}
@@ -0,0 +1,27 @@
+// String and MAC helpers shared by the firmware and the host harness
+#pragma once
+
+#include "core_platform.h"
+
+String htmlEscape(const String& str);
+String jsonEscape(const char* str);
+
+// Drops ':', '-' and whitespace and upper-cases, keeping at most 12 characters
+String toUpperNoDelim(const String& s);
+bool isValidMAC(const String& mac);
+String macPretty(const String& macNoDelim12);
+
+// MACs are carried as 48-bit integers, most significant byte = first octet
+// as printed ("AA:BB:CC:..." -> 0xAABBCC......).
+inline uint64_t macFromBytes(const uint8_t* b) {
+    return ((uint64_t)b[0] << 40) | ((uint64_t)b[1] << 32) | ((uint64_t)b[2] << 24) |
+           ((uint64_t)b[3] << 16) | ((uint64_t)b[4] << 8)  |  (uint64_t)b[5];
+}
+
+String macPrettyU64(uint64_t mac48);
+void formatMacNoDelim(uint64_t mac48, char out[13]);
+
+// Parses a 6 (OUI) or 12 (full MAC) hex-digit filter. Returns digit count, 0 if invalid.
+uint8_t parseMacFilter(const String& entry, uint64_t& value);
+
+void safeCopy(char* dest, size_t destSize, const String& src);
@@ -12,16 +12,32 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/semphr.h"
+#include "freertos/queue.h"
 #include "esp_task_wdt.h"
 #include <WiFi.h>
 #include "esp_wifi.h"
+#include "esp_event.h"
 #include <AsyncTCP.h>
 #include <ESPAsyncWebServer.h>
 #include <Preferences.h>
+#include <LittleFS.h>
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "esp_pm.h"
 #include <NimBLEDevice.h>
+// Radio-independent core (lib/ouispy_core), also built on the host by env:native
+#include "text_util.h"
+#include "ad_parse.h"
+#include "device_table.h"
+#include "filter_index.h"
+#include "reports.h"
+#include "capture_format.h"
+#include "web_assets.h"
 #include <vector>
+#include <memory>
 #include <map>
 #include <algorithm>
+#include <atomic>
 
 // ================================
 // CONFIGURATION CONSTANTS
@@ -32,6 +48,9 @@ namespace Config {
     
     static const uint8_t BUZZER_PIN = 3;
     static const uint8_t LED_PIN = 21;
+    static const uint8_t BUTTON_PIN = 0;                  // BOOT, active low
+    static const uint32_t BUTTON_DEBOUNCE_MS = 40;
+    static const uint16_t MODE_RUN_MAX_MIN = 1440;        // timed return-to-AP upper bound
     static const uint8_t BUZZER_CHANNEL = 3;
     static const uint8_t LEDC_RESOLUTION_BITS = 8;
     
@@ -39,24 +58,68 @@ namespace Config {
     static const uint8_t BUZZER_DUTY = 127;
     static const uint16_t BEEP_DURATION_MS = 200;
     static const uint16_t BEEP_PAUSE_MS = 150;
-    
-    static const uint32_t WIFI_SCAN_INTERVAL_MS = 3000;
+    static const uint8_t OUTPUT_QUEUE_LEN = 8;             // pending beep/flash requests
+    
+    static const uint16_t WIFI_SCAN_MAX_APS = 96;          // per sweep
+    static const uint32_t WIFI_SCAN_POLL_MS = 20;          // scanComplete() poll while a sweep runs
+    static const uint32_t WIFI_SCAN_DRAIN_MS = 500;        // wait for SCAN_DONE after a stop
+    static const uint16_t WIFI_SCAN_DWELL_MS = 120;        // per channel
+    static const uint16_t WIFI_SCAN_DWELL_MIN_MS = 30;
+    static const uint16_t WIFI_SCAN_DWELL_MAX_MS = 1500;
     static const uint32_t WIFI_MODE_CHANGE_DELAY_MS = 100;
+    
+    // Promiscuous capture (detect mode)
+    static const uint8_t PROMISC_MAX_CHANNEL = 13;
+    static const uint32_t PROMISC_DWELL_MS = 200;          // uniform dwell; cycle = 13x this
+    static const uint32_t PROMISC_DWELL_FLOOR_MS = 60;     // weighted: minimum per channel
+    static const float PROMISC_ACTIVITY_ALPHA = 0.3f;      // EMA weight of the latest dwell
+    static const float PROMISC_HIT_WEIGHT = 50.0f;         // one filter hit ~ 50 frames/s
+    static const float PROMISC_SEED_PER_AP = 5.0f;         // baseline AP -> initial activity
+    static const uint16_t PROMISC_HIT_QUEUE_LEN = 32;
+    static const uint32_t PROMISC_HOLDOFF_MS = 50;         // same MAC back-to-back
+    static const uint32_t PROMISC_LOG_INTERVAL_MS = 1000;  // per-hit log throttle
     static const uint32_t DETECT_DEBOUNCE_MS = 250;
     static const uint32_t DETECT_PRESENCE_MS = 3000;
     static const uint32_t DETECT_STALE_MS = 12000;
+    
+    // Battery detect runs (power plan): scan in bursts, sleep in between
+    static const uint32_t POWER_BURST_MS = 2000;          // radios on per burst
+    static const uint32_t POWER_GAP_MIN_MS = 500;         // first gap after a hit or start
+    static const uint16_t POWER_LATENCY_MIN_S = 1;        // longest gap the backoff may reach
+    static const uint16_t POWER_LATENCY_MAX_S = 60;
+    static const uint32_t POWER_HOLD_MS = 30000;          // continuous scanning after a hit
+    static const uint32_t POWER_SLEEP_SLICE_MS = 1000;    // gap sleeps in slices (stop, watchdog)
+    static const uint32_t POWER_POLL_MS = 250;            // BLE-only detect loop while on
+    static const uint32_t POWER_REPORT_MS = 60000;        // serial summary
+    static const int POWER_MAX_MHZ = 160;                 // DFS range while the plan runs
+    static const int POWER_MIN_MHZ = 40;
+    static const uint32_t POWER_STATIC_MHZ = 80;          // no esp_pm: fixed, lowest with radios
+    static const uint32_t LOOP_MS = 10;                   // loop() period
+    static const uint32_t LOOP_POWER_MS = 100;            // ... during a power-plan run
     static const uint32_t FOX_BEEP_DUR_MS = 60;
     static const uint32_t FOX_LOST_TIMEOUT_MS = 4000;
-    
-    static const uint32_t DETECTION_STACK_SIZE = 12288;
-    static const uint32_t BASELINE_STACK_SIZE = 16384;  // Increased for payload processing
-    static const UBaseType_t TASK_PRIORITY = 1;
-    static const BaseType_t TASK_CORE = 1;
-    
-    static const uint16_t BLE_SCAN_INTERVAL = 45;
-    static const uint16_t BLE_SCAN_WINDOW = 15;
-    static const uint16_t BLE_FAST_SCAN_INTERVAL = 16;
-    static const uint16_t BLE_FAST_SCAN_WINDOW = 15;
+    static const uint16_t FOX_TONE_HZ = 1000;
+    static const uint32_t FOX_SOLID_RECHECK_MS = 100;      // solid tone: re-evaluate cadence
+    static const uint32_t FOX_SOLID_OVERLAP_MS = 30;       // each solid tone outlasts the recheck
+    static const float FOX_KALMAN_Q = 4.0f;                // dB^2 per second of drift
+    static const float FOX_KALMAN_R = 16.0f;               // dB^2 measurement noise (~4 dB sd)
+    static const uint32_t FOX_TREND_WINDOW_MS = 1500;
+    static const float FOX_TREND_DB = 2.0f;                // change needed for warmer/colder
+    static const uint8_t FOX_MAX_TARGETS = 8;
+    static const float FOX_FOCUS_HYSTERESIS_DB = 6.0f;     // auto focus: margin to switch target
+    static const uint32_t FOX_RATE_WINDOW_MS = 2000;
+    
+    // Task placement, see TASK_SPECS. Wi-Fi driver and NimBLE host run on core 0.
+    static const BaseType_t RADIO_CORE = 0;
+    static const BaseType_t WORKER_CORE = 1;
+    
+    // Raw advertisement ring (NimBLE host task -> consumer task)
+    static const uint32_t ADV_RING_SLOTS = 512;          // power of two
+    
+    // BLE scan profiles, see SCAN_PROFILES
+    static const char* const SCAN_STATS_NAMESPACE = "scanstats";
+    static const uint32_t SCAN_METER_WINDOW_MS = 60000;    // distinct-MAC window
+    static const uint32_t SCAN_STATS_SAVE_MS = 300000;     // NVS write interval on long runs
     
     static const int16_t RSSI_GREEN = -55;
     static const int16_t RSSI_YELLOW = -67;
@@ -65,10 +128,78 @@ namespace Config {
     static const char* const PREFS_NAMESPACE = "ouispy";
     static const uint16_t MAX_FILTERS = 100;
     
-    // Enhanced baseline settings
+    // Bulk watchlist (LittleFS)
+    static const char* const WATCHLIST_PATH = "/watchlist.bin";
+    static const char* const WATCHLIST_TMP_PATH = "/watchlist.tmp";
+    static const char* const WATCHLIST_JOURNAL_PATH = "/watchlist.jnl";
+    static const uint32_t WATCHLIST_MAX_ENTRIES = 20000;
+    static const uint8_t FILTER_INDEX_RETIRED_MAX = 4;     // retired indexes before a publish waits
+    static const uint32_t FILTER_INDEX_GRACE_WAIT_MS = 50; // ... for the in-flight lookups to finish
+    static const uint32_t WATCHLIST_COMPACT_OPS = 256;   // journal records before rewriting the blob
+    
+    // Binary baseline capture (LittleFS copy of /baseline_results.bin)
+    static const char* const CAPTURE_PATH = "/capture.bin";
+    static const char* const CAPTURE_TMP_PATH = "/capture.tmp";
+    
+    // Capture log: every baseline, kept across reboots
+    static const char* const CAPLOG_DIR = "/log";
+    static const char* const CAPLOG_INDEX_PATH = "/log/index.bin";
+    static const char* const CAPLOG_INDEX_TMP_PATH = "/log/index.tmp";
+    static const uint32_t CAPLOG_SEGMENT_BYTES = 65536;
+    static const uint8_t CAPLOG_MAX_SEGMENTS = 6;        // ~384 KB of flash
+    static const uint16_t CAPLOG_MAX_SESSIONS = 64;
+    static const uint16_t CAPLOG_WRITE_BYTES = 4096;     // one flash sector
+    
+    // Enhanced baseline settings (payload and table limits: core_config.h)
     static const uint16_t MAX_PAYLOAD_DEVICES = 50;
-    static const uint8_t MAX_PAYLOAD_SIZE = 64;
-    static const size_t MAX_PAYLOAD_MEMORY = 10240;
+    
+    // Device tables (open addressing, PSRAM). Capacity must be a power of two.
+    static const uint32_t DEVICE_TABLE_CAPACITY = 4096;
+    static const uint16_t LIVE_PAGE_LIMIT = 100;      // records per /baseline_live response
+    static const uint16_t RESULTS_PAGE_LIMIT = 200;   // default rows per /baseline_results page
+    static const uint16_t RESULTS_SECTION_ROWS = 50;  // rows on the landing page
+    
+    // Server-sent events (/events)
+    static const uint32_t EVENTS_INTERVAL_MS = 500;   // coalescing window per push
+    static const uint32_t EVENTS_STATUS_MS = 5000;
+    static const uint32_t EVENTS_RETRY_MS = 3000;     // browser reconnect delay
+    static const uint8_t EVENTS_DEVICE_LIMIT = 8;     // newest changes per baseline event
+    static const uint8_t EVENTS_MAX_QUEUED = 4;       // per-client backlog before a push is skipped
+    
+    // Benchmark (/bench_start)
+    static const uint32_t BENCH_TABLE_CAPACITY = 16384;  // power of two; fits the 10k build at 75% load
+    static const uint32_t BENCH_RATE = 5000;             // adverts/s per phase, 0 = flood
+    static const uint32_t BENCH_MAX_RATE = 200000;
+    static const uint16_t BENCH_UNIQUES = 1000;
+    static const uint16_t BENCH_MAX_UNIQUES = 10000;
+    static const uint8_t BENCH_PAYLOAD_BYTES = 26;
+    static const uint8_t BENCH_HIT_PCT = 10;
+    static const uint8_t BENCH_PHASE_SECS = 5;
+    static const uint8_t BENCH_MAX_PHASE_SECS = 60;
+    static const uint16_t BENCH_BATCH = 256;             // reports per tick at most
+    static const uint16_t BENCH_WIFI_APS = 200;
+    static const uint8_t BENCH_WIFI_SWEEPS = 20;
+    static const uint8_t BENCH_HIT_KEYS = 16;            // filter entries the hits are drawn from
+    static const uint16_t BENCH_CHUNK_BYTES = 1436;      // one TCP segment, like a web response
+    
+    // Metrics (/metrics, /metrics.json)
+    static const uint8_t METRICS_HIST_BUCKETS = 14;   // x4 per bucket from 1 us, last is +Inf
+    static const uint32_t METRICS_TICK_MS = 1000;     // rate window
+    
+    // Continuous survey snapshots
+    static const uint32_t SURVEY_RING_BYTES = 262144;  // PSRAM
+    static const uint16_t SURVEY_SNAPSHOT_SECS = 60;
+    static const uint16_t SURVEY_SNAPSHOT_MIN_SECS = 10;
+    static const uint16_t SURVEY_SNAPSHOT_MAX_SECS = 3600;
+    static const uint32_t SURVEY_BATCH_SLOTS = 256;    // slots walked per liveMutex hold
+    
+    // BLE address rotation correlation
+    static const uint16_t ROTATION_MAX_CLUSTERS = 1024;
+    static const uint32_t ROTATION_INDEX_SLOTS = 2048;  // power of two
+    static const uint8_t ROTATION_INDEX_PROBES = 16;
+    static const uint8_t ROTATION_MFG_PREFIX = 2;       // manufacturer bytes after the company ID
+    static const uint32_t ROTATION_MIN_GAP_MS = 200;
+    static const uint32_t ROTATION_MAX_GAP_MS = 15000;
 }
 
 // ================================
@@ -80,11 +211,14 @@ Preferences prefs;
 SemaphoreHandle_t detectMutex = nullptr;
 SemaphoreHandle_t filtersMutex = nullptr;
 SemaphoreHandle_t resultsMutex = nullptr;
+SemaphoreHandle_t liveMutex = nullptr;      // guards the baseline table being collected
+SemaphoreHandle_t surveyMutex = nullptr;    // guards the survey snapshot ring
 
 // ================================
 // ENUMS & STRUCTS
 // ================================
 enum class BaselineMode { WIFI_ONLY, BLE_ONLY, WIFI_AND_BLE };
+enum class ScanProfile : uint8_t { PASSIVE_LOW, BALANCED, MAX_CAPTURE, ACTIVE_SCAN_RSP, COUNT };
 using DetectionMode = BaselineMode;
 enum class RunMode { STOPPED = 0, DETECT = 1, FOXHUNT = 2 };
 
@@ -100,82 +234,6 @@ struct Observed {
     }
 };
 
-// Enhanced struct with Wi-Fi metadata
-struct ObservedEnhanced {
-    char name[64];
-    char source[8];
-    int16_t rssi;
-    bool hasRssi;
-    
-    // BLE payload
-    bool hasPayload;
-    uint8_t payloadData[Config::MAX_PAYLOAD_SIZE];
-    uint8_t payloadLength;
-    uint8_t addrType;
-    
-    // Wi-Fi metadata (NEW)
-    bool hasWiFiMeta;
-    uint8_t channel;
-    wifi_auth_mode_t authMode;
-    wifi_cipher_type_t pairwiseCipher;
-    wifi_cipher_type_t groupCipher;
-    bool isHidden;
-    
-    ObservedEnhanced() : rssi(-127), hasRssi(false), hasPayload(false), 
-                         payloadLength(0), addrType(0), hasWiFiMeta(false),
-                         channel(0), authMode(WIFI_AUTH_OPEN), 
-                         pairwiseCipher(WIFI_CIPHER_TYPE_NONE),
-                         groupCipher(WIFI_CIPHER_TYPE_NONE), isHidden(false) {
-        name[0] = '\0';
-        source[0] = '\0';
-        memset(payloadData, 0, Config::MAX_PAYLOAD_SIZE);
-    }
-};
-
-// Helper function: Get encryption type string
-const char* getEncryptionType(wifi_auth_mode_t authMode) {
-    switch(authMode) {
-        case WIFI_AUTH_OPEN: return "Open";
-        case WIFI_AUTH_WEP: return "WEP";
-        case WIFI_AUTH_WPA_PSK: return "WPA-PSK";
-        case WIFI_AUTH_WPA2_PSK: return "WPA2-PSK";
-        case WIFI_AUTH_WPA_WPA2_PSK: return "WPA/WPA2-PSK";
-        case WIFI_AUTH_WPA2_ENTERPRISE: return "WPA2-Enterprise";
-        case WIFI_AUTH_WPA3_PSK: return "WPA3-PSK";
-        case WIFI_AUTH_WPA2_WPA3_PSK: return "WPA2/WPA3-PSK";
-        case WIFI_AUTH_WAPI_PSK: return "WAPI-PSK";
-        default: return "Unknown";
-    }
-}
-
-// Helper function: Get cipher type string
-const char* getCipherType(wifi_cipher_type_t cipher) {
-    switch(cipher) {
-        case WIFI_CIPHER_TYPE_NONE: return "None";
-        case WIFI_CIPHER_TYPE_WEP40: return "WEP40";
-        case WIFI_CIPHER_TYPE_WEP104: return "WEP104";
-        case WIFI_CIPHER_TYPE_TKIP: return "TKIP";
-        case WIFI_CIPHER_TYPE_CCMP: return "CCMP (AES)";
-        case WIFI_CIPHER_TYPE_TKIP_CCMP: return "TKIP/CCMP";
-        default: return "Unknown";
-    }
-}
-
-// Helper function: Get band from channel
-const char* getBandFromChannel(uint8_t channel) {
-    if (channel >= 1 && channel <= 14) return "2.4 GHz";
-    if (channel >= 36 && channel <= 165) return "5 GHz";
-    return "Unknown";
-}
-
-// Helper function: Check if channel suggests 40MHz width
-bool isLikely40MHz(uint8_t channel, uint8_t secondaryChannel) {
-    // ESP32 doesn't directly expose this, but we can infer from channel
-    // This is a simplified check
-    return false; // Would need more detailed scan data
-}
-
-
 // ================================
 // STRUCTS & STATE (continued)
 // ================================
@@ -201,44 +259,175 @@ struct DetectionState {
     }
 };
 
+// 1-D Kalman estimate of a target's RSSI. Process noise scales with the time
+// between samples, so bursty advertisers don't tighten the estimate faster.
+struct RssiKalman {
+    float x;
+    float p;
+    bool primed;
+    
+    RssiKalman() : x(-100.0f), p(0.0f), primed(false) {}
+    
+    void reset() {
+        x = -100.0f;
+        p = 0.0f;
+        primed = false;
+    }
+    
+    float update(float z, uint32_t dtMs, float q, float r) {
+        if (!primed) {
+            x = z;
+            p = r;
+            primed = true;
+            return x;
+        }
+        p += q * dtMs / 1000.0f;
+        const float k = p / (p + r);
+        x += k * (z - x);
+        p *= 1.0f - k;
+        return x;
+    }
+};
+
+enum class FoxTrend : int8_t { COLDER = -1, STEADY = 0, WARMER = 1 };
+
+// One tracked hunt target. Written by the consumer task under detectMutex.
+struct FoxTarget {
+    uint64_t mac48;                 // 0 = free slot
+    RssiKalman filter;
+    float trendRef;
+    uint32_t trendRefMs;
+    uint32_t firstSeenMs;
+    uint32_t lastSeenMs;
+    uint32_t hits;
+    uint32_t windowStartMs;         // hit-rate window
+    uint16_t windowHits;
+    uint16_t hitRateX10;            // adverts/s * 10 over the last full window
+    int16_t rssi;                   // filtered
+    int16_t rawRssi;
+    FoxTrend trend;
+};
+
 struct FoxHuntState {
     volatile bool running;
-    volatile int16_t rssi;
+    volatile int16_t rssi;          // focus target, mirrored for the beeper
+    volatile int16_t rawRssi;
+    volatile FoxTrend trend;
     volatile bool hasTarget;
     volatile uint32_t lastSeenMs;
     volatile bool firstSessionBeeped;
     volatile bool startBeepsPending;
-    bool isBeeping;
-    uint32_t beepStartMs;
+    FoxTarget targets[Config::FOX_MAX_TARGETS];
+    int8_t focusIdx;                // -1 = none yet
+    uint64_t focusMac;              // user pick, 0 = auto (strongest)
+    float filterQ;
+    float filterR;
     
-    FoxHuntState() : running(false), rssi(-100), hasTarget(false), 
-                     lastSeenMs(0), firstSessionBeeped(false), 
-                     startBeepsPending(false), isBeeping(false), beepStartMs(0) {}
+    FoxHuntState() : running(false), rssi(-100), rawRssi(-100), trend(FoxTrend::STEADY),
+                     hasTarget(false), lastSeenMs(0), firstSessionBeeped(false),
+                     startBeepsPending(false), targets(), focusIdx(-1), focusMac(0),
+                     filterQ(Config::FOX_KALMAN_Q), filterR(Config::FOX_KALMAN_R) {}
     
     void reset() {
         running = false;
         rssi = -100;
+        rawRssi = -100;
+        trend = FoxTrend::STEADY;
         hasTarget = false;
         lastSeenMs = 0;
         firstSessionBeeped = false;
         startBeepsPending = false;
-        isBeeping = false;
-        beepStartMs = 0;
+        for (FoxTarget& t : targets) t = FoxTarget();
+        focusIdx = -1;
+        focusMac = 0;
     }
 };
 
+// Watchlist entries use the WATCH_KEY_* packing from filter_index.h.
+// On flash: WatchlistHeader followed by `count` little-endian uint64 keys.
+// The journal is a sequence of uint64 records: (op << 56) | key.
+static const uint32_t WATCHLIST_MAGIC = 0x314C574F;  // "OWL1"
+static const uint16_t WATCHLIST_VERSION = 1;
+static const uint8_t WATCH_OP_ADD = 1;
+static const uint8_t WATCH_OP_REMOVE = 2;
+
+struct WatchlistHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t count;
+};
+
+// Continuous-survey snapshot, little-endian, followed by `records` entries:
+//   mac[6] | u8 flags (DEV_*) | varint firstSeenAgoS | varint lastSeenAgoDs |
+//   varint samplesDelta | i8 rssiMin | i8 rssiMax | i8 rssiMean
+// Ages are relative to timeMs; samplesDelta counts sightings since the
+// device's previous snapshot, and only devices seen since then are listed.
+// Decode with tools/decode_survey.py.
+static const uint32_t SURVEY_MAGIC = 0x3153534F;   // "OSS1"
+static const uint8_t SURVEY_TRUNCATED = 0x01;      // size cap or a busy table; the next snapshot continues
+
+struct __attribute__((packed)) SurveySnapshotHeader {
+    uint32_t magic;
+    uint32_t totalLen;        // header + records
+    uint32_t snapshotId;
+    uint32_t timeMs;
+    uint16_t records;
+    uint16_t intervalSecs;
+    uint8_t flags;            // SURVEY_*
+    uint8_t reserved[3];
+};
+
+static const size_t SURVEY_RECORD_MAX = 6 + 1 + 3 * 5 + 3;
+
+struct Watchlist {
+    uint64_t* keys;         // sorted, PSRAM when available
+    uint32_t count;
+    uint32_t capacity;
+    uint32_t journalOps;
+    bool fsReady;
+    
+    Watchlist() : keys(nullptr), count(0), capacity(0), journalOps(0), fsReady(false) {}
+};
+
+enum class WatchlistResult { ADDED, REMOVED, EXISTS, NOT_FOUND, INVALID, FULL, BUSY };
+
 struct BaselineConfig {
     BaselineMode mode;
     uint32_t durationSecs;
     int16_t rssiThreshold;
     bool capturePayload;
+    bool saveCapture;         // write the binary capture to LittleFS when done
+    bool passiveScan;         // Wi-Fi: listen for beacons only, no probe requests
+    uint16_t dwellMs;         // Wi-Fi: per-channel dwell time
+    ScanProfile bleProfile;
+    bool continuous;          // ignore durationSecs, run until /baseline_stop
+    uint16_t snapshotSecs;    // continuous: survey snapshot interval
+    ResultsSort sortKey;      // published row order
+};
+
+// Published alongside resultsTable; everything the report headers need
+struct ResultsSummary {
+    BaselineConfig config;
+    uint32_t builtMs;
+    uint16_t wifiCount;
+    uint16_t bleCount;
+    uint16_t bleWithPayload;
+    uint16_t bleLogical;     // BLE devices after merging rotated addresses
+    
+    ResultsSummary() : config{BaselineMode::WIFI_AND_BLE, 0, 0, false, false, false, Config::WIFI_SCAN_DWELL_MS}, builtMs(0),
+                       wifiCount(0), bleCount(0), bleWithPayload(0), bleLogical(0) {}
 };
 
 // ================================
 // GLOBAL STATE
 // ================================
 static std::vector<String> filters;
+static Watchlist watchlist;   // guarded by filtersMutex
 static volatile bool baselineRunning = false;
+static volatile bool baselineStopRequested = false;
+static volatile bool benchRunning = false;
+static volatile bool benchStopRequested = false;
 static volatile bool stealthMode = false;
 static volatile RunMode runMode = RunMode::STOPPED;
 
@@ -247,15 +436,29 @@ static FoxHuntState foxState;
 
 // Results storage (basic)
 static std::vector<std::pair<String, Observed>> lastResultsRows;
-static String lastResultsHTMLFull;
-static String lastResultsCSV;
 
 // Enhanced results storage
-static std::vector<std::pair<String, ObservedEnhanced>> enhancedResultsRows;
-static String detailedReportTxt;
+static const DeviceTable* resultsTable = nullptr;        // published baseline, guarded by resultsMutex
+static std::vector<uint32_t> enhancedResultsRows;  // slots of resultsTable, in config.sortKey order
+static uint32_t resultsGeneration = 0;             // bumped on every publish
+static ResultsSummary resultsSummary;
 static size_t currentPayloadMemory = 0;
 static BaselineConfig currentBaselineConfig;
 
+// Preallocated at boot; reused (cleared) by every baseline run. The two
+// baseline tables alternate: one holds the published results while the
+// other collects the next run. The collecting table is the live source of
+// truth: BLE (consumer task) and Wi-Fi (baseline task) write straight into
+// it under liveMutex, and publishing it is just a pointer swap + sort.
+static DeviceTable baselineTables[2];
+static DeviceTable* liveTable = nullptr;   // table /baseline_live reads, guarded by liveMutex
+static uint32_t liveRunId = 0;             // bumped when a run starts; clients reset on change
+
+// Only one baseline runs at a time, so only one table is ever being collected
+inline DeviceTable& workingBaselineTable() {
+    return (resultsTable == &baselineTables[0]) ? baselineTables[1] : baselineTables[0];
+}
+
 // ================================
 // FORWARD DECLARATIONS
 // ================================
@@ -265,108 +468,180 @@ void clearFilters();
 bool addFilterIfNew(const String& entry);
 void setupWeb();
 void buildResultsArtifacts(const std::map<String, Observed>& macMap);
-String renderIndexResultsSection();
-String buildIndex();
 void startBaseline(BaselineMode mode, uint32_t secs);
-bool matchesAnyFilter(const String& macNoDelim, std::vector<String>& localCopy);
+bool matchesCompiledFilter(uint64_t mac48);
+void rebuildFilterIndexLocked();
+void watchlistInit();
+WatchlistResult watchlistAdd(const String& entry);
+WatchlistResult watchlistRemove(const String& entry);
 void detectionTask(void* pv);
 void foxHuntTask(void* pv);
 
 // Enhanced baseline functions
-void startEnhancedBaseline(BaselineMode mode, uint32_t secs, int16_t rssiThreshold, bool capturePayload);
-void buildEnhancedResults(const std::map<String, ObservedEnhanced>& macMap, const BaselineConfig& config);
+void startEnhancedBaseline(BaselineConfig cfg);
+void buildEnhancedResults(const DeviceTable& table, const BaselineConfig& config);
+bool saveCaptureFile(const DeviceTable& table, const BaselineConfig& config);
+bool captureLogSession(const DeviceTable& table, const BaselineConfig& config);
 void enhancedBaselineTask(void* pv);
-void captureWiFiMetadata(std::map<String, ObservedEnhanced>& macMap, const BaselineConfig& config, uint32_t startMs, uint32_t durMs);
-String generateDeviceReport(const String& mac, const ObservedEnhanced& obs);
-String generateWiFiDeviceReport(const String& mac, const ObservedEnhanced& obs);
-const char* getCompanyName(uint16_t companyId);
-const char* getEncryptionType(wifi_auth_mode_t authMode);
-const char* getCipherType(wifi_cipher_type_t cipher);
-const char* getBandFromChannel(uint8_t channel);
-String parseFlags(uint8_t flags);
-String formatHexDump(const uint8_t* data, uint8_t length);
-String parseAdStructures(const uint8_t* payload, uint8_t length);
+void captureWiFiMetadata(DeviceTable& table, const BaselineConfig& config, uint32_t startMs, uint32_t durMs);
+inline bool baselineKeepRunning(const BaselineConfig& config, uint32_t startMs, uint32_t durMs);
+void surveyTick(DeviceTable& t, const BaselineConfig& config);
 
 // ================================
 // UTILITY FUNCTIONS
 // ================================
 
-String htmlEscape(const String& str) {
-    String escaped;
-    escaped.reserve(str.length() + 10);
-    
-    for (size_t i = 0; i < str.length(); i++) {
-        switch (str[i]) {
-            case '&': escaped += "&amp;"; break;
-            case '<': escaped += "&lt;"; break;
-            case '>': escaped += "&gt;"; break;
-            case '"': escaped += "&quot;"; break;
-            case '\'': escaped += "&#39;"; break;
-            default: escaped += str[i];
-        }
+inline void setBestRssi(Observed &o, int rssiDbm) {
+    if (!o.hasRssi || rssiDbm > o.rssi) {
+        o.rssi = (int16_t)rssiDbm;
+        o.hasRssi = true;
     }
-    return escaped;
 }
 
-String toUpperNoDelim(const String &s) {
-    String out;
-    out.reserve(12);
-    
-    for (size_t i = 0; i < s.length() && out.length() < 12; ++i) {
-        char c = s[i];
-        if (c == ':' || c == '-' || c == ' ' || c == '\r' || c == '\n' || c == '\t') 
-            continue;
-        out += (char)toupper(c);
-    }
-    return out;
+// NimBLE keeps the address little-endian (val[0] is the last printed octet)
+inline uint64_t macFromNimble(const NimBLEAddress& addr) {
+    const uint8_t* v = addr.getNative();
+    return ((uint64_t)v[5] << 40) | ((uint64_t)v[4] << 32) | ((uint64_t)v[3] << 24) |
+           ((uint64_t)v[2] << 16) | ((uint64_t)v[1] << 8)  |  (uint64_t)v[0];
 }
 
-bool isValidMAC(const String& mac) {
-    String clean = toUpperNoDelim(mac);
-    
-    if (clean.length() != 6 && clean.length() != 12) {
-        return false;
-    }
-    
-    for (size_t i = 0; i < clean.length(); i++) {
-        if (!isxdigit(clean[i])) {
-            return false;
-        }
-    }
-    return true;
+// ================================
+// METRICS
+// ================================
+// Counters and latency histograms written from callbacks and tasks without
+// locks (relaxed 32-bit atomics; they wrap like any Prometheus counter).
+// metricsTick() folds the counters into per-second rates from loop(), the
+// web side renders everything as JSON or Prometheus text.
+
+// Bucket i holds samples below 4^i us (1 us .. 16.8 s); the last is +Inf
+struct LatencyHist {
+    std::atomic<uint32_t> buckets[Config::METRICS_HIST_BUCKETS];
+    std::atomic<uint32_t> count;
+    std::atomic<uint32_t> sumUs;
+    std::atomic<uint32_t> maxUs;
+};
+
+enum class LockId : uint8_t { DETECT, FILTERS, RESULTS, LIVE, COUNT };
+
+static const char* const LOCK_NAMES[(size_t)LockId::COUNT] = {
+    "detect", "filters", "results", "live"
+};
+
+struct LockStats {
+    LatencyHist waitUs;
+    std::atomic<uint32_t> timeouts;
+};
+
+struct AdvertRates {
+    uint32_t received;
+    uint32_t matched;
+    uint32_t dropped;
+};
+
+struct Metrics {
+    std::atomic<uint32_t> advReceived;   // every scan callback
+    std::atomic<uint32_t> advMatched;    // accepted by the running mode's consumer
+    std::atomic<uint32_t> advDropped;    // ring full or consumer lock timeout
+    LatencyHist onResultUs;
+    LatencyHist wifiScanUs;              // one sweep, start to SCAN_DONE
+    LatencyHist resultsBuildUs;          // publish + sort after a baseline
+    LatencyHist resultsChunkUs;          // one chunk of a streamed report
+    LockStats locks[(size_t)LockId::COUNT];
+    
+    // loop() only
+    AdvertRates perSec;
+    AdvertRates last;
+    uint32_t lastTimeouts[(size_t)LockId::COUNT];
+    uint32_t lastTickMs;
+};
+
+static Metrics metrics;
+
+inline uint8_t histBucket(uint32_t us) {
+    const uint8_t b = us ? (uint8_t)((33 - __builtin_clz(us)) / 2) : 0;
+    return b < Config::METRICS_HIST_BUCKETS ? b : Config::METRICS_HIST_BUCKETS - 1;
 }
 
-String macPretty(const String& macNoDelim12) {
-    if (macNoDelim12.length() < 12) return macNoDelim12;
-    
-    String p;
-    p.reserve(17);
-    for (int i = 0; i < 12; i += 2) {
-        if (i) p += ':';
-        p += macNoDelim12.substring(i, i + 2);
-    }
-    return p;
+inline void histRecord(LatencyHist& h, uint32_t us) {
+    h.buckets[histBucket(us)].fetch_add(1, std::memory_order_relaxed);
+    h.count.fetch_add(1, std::memory_order_relaxed);
+    h.sumUs.fetch_add(us, std::memory_order_relaxed);
+    uint32_t prev = h.maxUs.load(std::memory_order_relaxed);
+    while (us > prev && !h.maxUs.compare_exchange_weak(prev, us, std::memory_order_relaxed)) {}
 }
 
-inline void setBestRssi(Observed &o, int rssiDbm) {
-    if (!o.hasRssi || rssiDbm > o.rssi) {
-        o.rssi = (int16_t)rssiDbm;
-        o.hasRssi = true;
-    }
+inline void histRecordSince(LatencyHist& h, int64_t startUs) {
+    const int64_t d = esp_timer_get_time() - startUs;
+    histRecord(h, d > (int64_t)UINT32_MAX ? UINT32_MAX : (uint32_t)d);
 }
 
-inline void setBestRssiEnhanced(ObservedEnhanced &o, int rssiDbm) {
-    if (!o.hasRssi || rssiDbm > o.rssi) {
-        o.rssi = (int16_t)rssiDbm;
-        o.hasRssi = true;
+// Upper bound of the bucket holding the q-th quantile, 0 when empty
+uint32_t histQuantileUs(const LatencyHist& h, float q) {
+    uint32_t counts[Config::METRICS_HIST_BUCKETS];
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < Config::METRICS_HIST_BUCKETS; i++) {
+        counts[i] = h.buckets[i].load(std::memory_order_relaxed);
+        total += counts[i];
     }
+    if (!total) return 0;
+    const uint32_t rank = (uint32_t)(q * total);
+    uint32_t seen = 0;
+    for (uint8_t i = 0; i + 1 < Config::METRICS_HIST_BUCKETS; i++) {
+        seen += counts[i];
+        if (seen > rank) return 1UL << (2 * i);
+    }
+    return h.maxUs.load(std::memory_order_relaxed);
+}
+
+// Times its scope into a histogram; for callbacks with early returns
+class ScopedLatency {
+public:
+    explicit ScopedLatency(LatencyHist& h) : hist(h), startUs(esp_timer_get_time()) {}
+    ~ScopedLatency() { histRecordSince(hist, startUs); }
+private:
+    LatencyHist& hist;
+    const int64_t startUs;
+};
+
+inline void metricsCount(std::atomic<uint32_t>& c) {
+    c.fetch_add(1, std::memory_order_relaxed);
 }
 
-void safeCopy(char* dest, size_t destSize, const String& src) {
-    size_t len = src.length();
-    if (len >= destSize) len = destSize - 1;
-    memcpy(dest, src.c_str(), len);
-    dest[len] = '\0';
+// xSemaphoreTake() that records the wait and counts timeouts
+inline bool lockTake(LockId id, SemaphoreHandle_t m, TickType_t wait) {
+    LockStats& ls = metrics.locks[(size_t)id];
+    const int64_t startUs = esp_timer_get_time();
+    const bool ok = xSemaphoreTake(m, wait) == pdTRUE;
+    histRecordSince(ls.waitUs, startUs);
+    if (!ok) metricsCount(ls.timeouts);
+    return ok;
+}
+
+// loop(): per-second advert rates, and a log line for lock timeouts that the
+// callers handled quietly
+void metricsTick(uint32_t now) {
+    const uint32_t elapsed = now - metrics.lastTickMs;
+    if (elapsed < Config::METRICS_TICK_MS) return;
+    metrics.lastTickMs = now;
+    
+    const AdvertRates cur = {
+        metrics.advReceived.load(std::memory_order_relaxed),
+        metrics.advMatched.load(std::memory_order_relaxed),
+        metrics.advDropped.load(std::memory_order_relaxed)
+    };
+    metrics.perSec.received = (uint32_t)((uint64_t)(cur.received - metrics.last.received) * 1000 / elapsed);
+    metrics.perSec.matched = (uint32_t)((uint64_t)(cur.matched - metrics.last.matched) * 1000 / elapsed);
+    metrics.perSec.dropped = (uint32_t)((uint64_t)(cur.dropped - metrics.last.dropped) * 1000 / elapsed);
+    metrics.last = cur;
+    
+    for (size_t i = 0; i < (size_t)LockId::COUNT; i++) {
+        const uint32_t t = metrics.locks[i].timeouts.load(std::memory_order_relaxed);
+        if (t != metrics.lastTimeouts[i]) {
+            Serial.printf("[METRICS] %sMutex: %u lock timeouts in %u ms\n", LOCK_NAMES[i],
+                          (unsigned)(t - metrics.lastTimeouts[i]), (unsigned)elapsed);
+            metrics.lastTimeouts[i] = t;
+        }
+    }
 }
 
 // ================================
@@ -382,54 +657,6 @@ namespace Hardware {
         pinMode(Config::LED_PIN, OUTPUT);
         digitalWrite(Config::LED_PIN, HIGH);
     }
-    
-    void ledFlashOnce(uint16_t ms = 80) {
-        ledOn();
-        if (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED) {
-            vTaskDelay(pdMS_TO_TICKS(ms));
-        } else {
-            delay(ms);
-        }
-        ledOff();
-    }
-    
-    void buzzerOn(int freq = Config::BUZZER_FREQ, uint8_t duty = Config::BUZZER_DUTY) {
-        pinMode(Config::BUZZER_PIN, OUTPUT);
-        ledcAttachPin(Config::BUZZER_PIN, Config::BUZZER_CHANNEL);
-        ledcSetup(Config::BUZZER_CHANNEL, freq, Config::LEDC_RESOLUTION_BITS);
-        ledcWrite(Config::BUZZER_CHANNEL, duty);
-    }
-    
-    void buzzerOff() {
-        ledcWrite(Config::BUZZER_CHANNEL, 0);
-    }
-    
-    void beepOnce(int durMs = Config::BEEP_DURATION_MS, 
-                  int freq = Config::BUZZER_FREQ, 
-                  uint8_t duty = Config::BUZZER_DUTY) {
-        if (stealthMode) {
-            ledOn();
-            delay(durMs);
-            ledOff();
-            return;
-        }
-        buzzerOn(freq, duty);
-        ledOn();
-        delay(durMs);
-        buzzerOff();
-        ledOff();
-    }
-    
-    void beepPattern(uint8_t count = 2) {
-        for (uint8_t i = 0; i < count; i++) {
-            beepOnce();
-            if (i + 1 < count) delay(Config::BEEP_PAUSE_MS);
-        }
-    }
-    
-    void startupBeep() { beepPattern(2); }
-    void baselineDoneBeep() { beepPattern(3); }
-    void detectBeep() { beepPattern(1); }
 }
 
 // ================================
@@ -451,8 +678,8 @@ String rssiCellHtml(const Observed& o) {
            String(o.rssi) + " dBm</span>";
 }
 
-String rssiCellHtmlEnhanced(const ObservedEnhanced& o) {
-    if (!o.hasRssi) {
+String rssiCellHtmlEnhanced(const DeviceRecord& o) {
+    if (!(o.flags & DEV_HAS_RSSI)) {
         return String("<span class='rssi rssi-unk'>-</span>");
     }
     return "<span class='rssi " + String(rssiClass(true, o.rssi)) + "'>" + 
@@ -460,367 +687,168 @@ String rssiCellHtmlEnhanced(const ObservedEnhanced& o) {
 }
 
 // ================================
-// ENHANCED PAYLOAD PARSING
+// WI-FI METADATA CAPTURE
 // ================================
 
-const char* getCompanyName(uint16_t companyId) {
-    switch(companyId) {
-        case 0x004C: return "Apple Inc.";
-        case 0x0006: return "Microsoft";
-        case 0x00E0: return "Google";
-        case 0x0075: return "Samsung";
-        case 0x0087: return "Garmin";
-        case 0x0157: return "Xiaomi";
-        case 0x02E5: return "Fitbit";
-        case 0x0499: return "Ruuvi Innovations";
-        case 0x0059: return "Nordic Semiconductor";
-        case 0x00D7: return "Huawei";
-        case 0x0171: return "Amazon";
-        default: return "Unknown";
-    }
-}
+// ---- Async scan engine ----
+// The scan has one owner, arduino-esp32's WiFiScanClass: its SCAN_DONE
+// handler fetches the driver's AP list, and we only read that copy
+// (scanComplete() / getScanInfoByIndex()) from the baseline task. Each
+// finished sweep is copied into a preallocated buffer and the Arduino list
+// released, then the next sweep is started before the copy is aggregated,
+// so the radio keeps scanning while records are merged.
 
-String parseFlags(uint8_t flags) {
-    String result = "";
-    if (flags & 0x01) result += "LE Limited, ";
-    if (flags & 0x02) result += "LE General, ";
-    if (flags & 0x04) result += "No BR/EDR, ";
-    if (flags & 0x08) result += "LE+BR/EDR Controller, ";
-    if (flags & 0x10) result += "LE+BR/EDR Host, ";
-    if (result.length() > 2) result = result.substring(0, result.length() - 2);
-    return result.length() ? result : "None";
-}
+static wifi_ap_record_t* scanBuf = nullptr;   // baseline task only
+static int64_t scanStartUs = 0;
 
-String formatHexDump(const uint8_t* data, uint8_t length) {
-    String dump;
-    dump.reserve(length * 5 + 100);
-    
-    dump += "  Offset  Hex                                              ASCII\n";
-    dump += "  ------  -----------------------------------------------  ----------------\n";
-    
-    for (uint8_t i = 0; i < length; i += 16) {
-        char line[100];
-        snprintf(line, sizeof(line), "  0x%04X  ", i);
-        dump += line;
-        
-        for (uint8_t j = 0; j < 16; j++) {
-            if (i + j < length) {
-                snprintf(line, sizeof(line), "%02X ", data[i + j]);
-                dump += line;
-            } else {
-                dump += "   ";
-            }
-            if (j == 7) dump += " ";
-        }
-        
-        dump += " ";
-        
-        for (uint8_t j = 0; j < 16 && i + j < length; j++) {
-            char c = data[i + j];
-            dump += (c >= 32 && c <= 126) ? c : '.';
-        }
-        
-        dump += "\n";
+bool wifiScanEngineInit() {
+    scanBuf = (wifi_ap_record_t*)psramAlloc(Config::WIFI_SCAN_MAX_APS * sizeof(wifi_ap_record_t));
+    if (!scanBuf) {
+        Serial.println("[ERROR] Failed to allocate Wi-Fi scan buffer");
+        return false;
     }
-    
-    return dump;
+    return true;
 }
 
-String parseAdStructures(const uint8_t* payload, uint8_t length) {
-    String parsed;
-    parsed.reserve(512);
-    
-    parsed += "  Legend:\n";
-    parsed += "    Flags | Name | UUIDs | Service Data | Mfg Data | Other\n";
-    parsed += "  ----------------\n";
-    
-    uint8_t pos = 0;
-    uint8_t structNum = 1;
-    
-    while (pos < length) {
-        uint8_t len = payload[pos];
-        if (len == 0 || pos + len >= length) break;
-        
-        uint8_t type = payload[pos + 1];
-        const uint8_t* data = &payload[pos + 2];
-        uint8_t dataLen = len - 1;
-        
-        char header[50];
-        snprintf(header, sizeof(header), "  [%d] Type 0x%02X: ", structNum++, type);
-        parsed += header;
-        
-        switch(type) {
-            case 0x01: {
-                parsed += "Flags (Length: " + String(dataLen) + " bytes)\n";
-                if (dataLen > 0) {
-                    parsed += "      Data: 0x" + String(data[0], HEX);
-                    parsed += " (" + parseFlags(data[0]) + ")\n";
-                }
-                break;
-            }
-            
-            case 0x08:
-            case 0x09: {
-                parsed += (type == 0x08 ? "Shortened" : "Complete");
-                parsed += " Local Name (Length: " + String(dataLen) + " bytes)\n";
-                parsed += "      Name: \"";
-                for (uint8_t i = 0; i < dataLen; i++) {
-                    parsed += (char)data[i];
-                }
-                parsed += "\"\n";
-                break;
-            }
-            
-            case 0xFF: {
-                parsed += "Manufacturer Data (Length: " + String(dataLen) + " bytes)\n";
-                if (dataLen >= 2) {
-                    uint16_t companyId = data[0] | (data[1] << 8);
-                    parsed += "      Company: 0x" + String(companyId, HEX);
-                    parsed += " (" + String(getCompanyName(companyId)) + ")";
-                    
-                    if (dataLen > 2) {
-                        parsed += ", Data: ";
-                        for (uint8_t i = 2; i < dataLen && i < 32; i++) {
-                            char hex[3];
-                            snprintf(hex, sizeof(hex), "%02X", data[i]);
-                            parsed += hex;
-                        }
-                        if (dataLen > 32) parsed += "...";
-                    }
-                    parsed += "\n";
-                }
-                break;
-            }
-            
-            case 0x02:
-            case 0x03: {
-                parsed += (type == 0x02 ? "Incomplete" : "Complete");
-                parsed += " 16-bit UUIDs (Length: " + String(dataLen) + " bytes)\n";
-                parsed += "      UUIDs: ";
-                for (uint8_t i = 0; i < dataLen; i += 2) {
-                    if (i > 0) parsed += ", ";
-                    uint16_t uuid = data[i] | (data[i+1] << 8);
-                    parsed += "0x" + String(uuid, HEX);
-                }
-                parsed += "\n";
-                break;
-            }
-            
-            case 0x16: {
-                parsed += "Service Data - 16-bit UUID (Length: " + String(dataLen) + " bytes)\n";
-                if (dataLen >= 2) {
-                    uint16_t uuid = data[0] | (data[1] << 8);
-                    parsed += "      UUID: 0x" + String(uuid, HEX);
-                    if (dataLen > 2) {
-                        parsed += ", Data: ";
-                        for (uint8_t i = 2; i < dataLen && i < 18; i++) {
-                            char hex[3];
-                            snprintf(hex, sizeof(hex), "%02X", data[i]);
-                            parsed += hex;
-                        }
-                    }
-                    parsed += "\n";
-                }
-                break;
-            }
-            
-            default: {
-                parsed += "Unknown Type (Length: " + String(dataLen) + " bytes)\n";
-                parsed += "      Raw Data: ";
-                for (uint8_t i = 0; i < dataLen && i < 16; i++) {
-                    char hex[3];
-                    snprintf(hex, sizeof(hex), "%02X", data[i]);
-                    parsed += hex;
-                    if (i < dataLen - 1) parsed += " ";
-                }
-                if (dataLen > 16) parsed += "...";
-                parsed += "\n";
-                break;
-            }
-        }
-        
-        pos += len + 1;
+bool startAsyncWiFiScan(const BaselineConfig& config) {
+    // Arduino's active scans use a fixed 100 ms minimum per channel
+    const uint32_t dwellMs = (!config.passiveScan && config.dwellMs < 100) ? 100 : config.dwellMs;
+    scanStartUs = esp_timer_get_time();
+    if (WiFi.scanNetworks(true, true, config.passiveScan, dwellMs) != WIFI_SCAN_RUNNING) {
+        Serial.println("[WARN] Wi-Fi scan start failed");
+        return false;
     }
-    
-    return parsed;
+    return true;
 }
 
-String generateDeviceReport(const String& mac, const ObservedEnhanced& obs) {
-    String report;
-    report.reserve(1024);
-    
-    report += "================================================================================\n";
-    report += "[BLE-DEVICE] " + macPretty(mac) + "\n";
-    report += "================================================================================\n";
-    
-    report += "[BASIC-INFO]\n";
-    report += "  MAC Address:  " + macPretty(mac) + "\n";
-    report += "  RSSI:         " + String(obs.rssi) + " dBm\n";
-    report += "  Address Type: " + String(obs.addrType == 0 ? "Public" : "Random") + "\n";
-    
-    if (obs.name[0] != '\0') {
-        report += "  Device Name:  " + String(obs.name) + "\n";
-    }
-    
-    if (obs.hasPayload && obs.payloadLength > 0) {
-        report += "[RAW-PAYLOAD]\n";
-        report += "  Total Length: " + String(obs.payloadLength) + " bytes\n";
-        report += "  Complete Advertisement:\n";
-        report += formatHexDump(obs.payloadData, obs.payloadLength);
-        
-        report += "[AD-STRUCTURES] Advertisement Data Structures:\n";
-        report += parseAdStructures(obs.payloadData, obs.payloadLength);
+// Copies a finished sweep out of the Arduino list and frees it
+uint16_t takeWiFiScanResults(int16_t found) {
+    uint16_t n = 0;
+    for (int16_t i = 0; i < found && n < Config::WIFI_SCAN_MAX_APS; i++) {
+        const wifi_ap_record_t* ap = (const wifi_ap_record_t*)WiFi.getScanInfoByIndex(i);
+        if (ap) scanBuf[n++] = *ap;
     }
-    
-    report += "================================================================================\n\n";
-    
-    return report;
+    WiFi.scanDelete();
+    return n;
 }
 
-// ================================
-// WI-FI METADATA CAPTURE & REPORT
-// ================================
+// After esp_wifi_scan_stop(): the stop still produces SCAN_DONE. Wait for
+// Arduino to take it and discard the partial list, so it is not mistaken
+// for the next sweep.
+void drainStoppedWiFiScan() {
+    const uint32_t t0 = millis();
+    while (WiFi.scanComplete() == WIFI_SCAN_RUNNING && millis() - t0 < Config::WIFI_SCAN_DRAIN_MS) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    WiFi.scanDelete();
+}
 
-String generateWiFiDeviceReport(const String& mac, const ObservedEnhanced& obs) {
-    String report;
-    report.reserve(512);
-    
-    report += "================================================================================\n";
-    report += "[WiFi-AP] " + macPretty(mac) + "\n";
-    report += "================================================================================\n";
-    
-    report += "[BASIC-INFO]\n";
-    report += "  MAC Address:  " + macPretty(mac) + "\n";
-    report += "  RSSI:         " + String(obs.rssi) + " dBm\n";
-    report += "  SSID:         " + String(obs.name[0] ? obs.name : "UNKNOWN/HIDDEN") + "\n";
-    
-    if (obs.hasWiFiMeta) {
-        report += "[NETWORK-INFO]\n";
-        report += "  Channel:      " + String(obs.channel) + " (" + String(getBandFromChannel(obs.channel)) + ")\n";
-        report += "  Encryption:   " + String(getEncryptionType(obs.authMode)) + "\n";
-        
-        if (obs.authMode != WIFI_AUTH_OPEN) {
-            report += "  Pairwise:     " + String(getCipherType(obs.pairwiseCipher)) + "\n";
-            report += "  Group:        " + String(getCipherType(obs.groupCipher)) + "\n";
-        }
-        
-        report += "  Hidden SSID:  " + String(obs.isHidden ? "Yes" : "No") + "\n";
-        
-        report += "[SIGNAL-ANALYSIS]\n";
-        if (obs.rssi >= -50) {
-            report += "  Quality:      Excellent (very close)\n";
-        } else if (obs.rssi >= -60) {
-            report += "  Quality:      Good (close proximity)\n";
-        } else if (obs.rssi >= -70) {
-            report += "  Quality:      Fair (medium range)\n";
-        } else {
-            report += "  Quality:      Weak (far away)\n";
-        }
-        
-        if (strcmp(getBandFromChannel(obs.channel), "2.4 GHz") == 0) {
-            if (obs.channel == 1 || obs.channel == 6 || obs.channel == 11) {
-                report += "  Channel:      Standard (non-overlapping)\n";
-            } else {
-                report += "  Channel:      Non-standard (may overlap)\n";
-            }
-        }
-        
-        report += "[SECURITY-ANALYSIS]\n";
-        if (obs.authMode == WIFI_AUTH_OPEN) {
-            report += "  Status:       INSECURE - Open network\n";
-        } else if (obs.authMode == WIFI_AUTH_WEP) {
-            report += "  Status:       WEAK - WEP is outdated\n";
-        } else if (obs.authMode == WIFI_AUTH_WPA_PSK) {
-            report += "  Status:       WEAK - WPA1 is deprecated\n";
-        } else if (obs.authMode == WIFI_AUTH_WPA2_PSK) {
-            report += "  Status:       GOOD - WPA2 standard\n";
-        } else if (obs.authMode == WIFI_AUTH_WPA3_PSK || obs.authMode == WIFI_AUTH_WPA2_WPA3_PSK) {
-            report += "  Status:       EXCELLENT - WPA3 enabled\n";
-        } else if (obs.authMode == WIFI_AUTH_WPA2_ENTERPRISE) {
-            report += "  Status:       ENTERPRISE - Advanced security\n";
-        }
+void recordWiFiAp(DeviceTable& table, const wifi_ap_record_t& ap, int16_t rssiThreshold, bool logNew = true) {
+    const int rssi = ap.rssi;
+    if (rssi < rssiThreshold) return;
+    
+    const uint64_t mac48 = macFromBytes(ap.bssid);
+    const size_t ssidLen = strnlen((const char*)ap.ssid, sizeof(ap.ssid));
+    
+    WiFiMeta meta;
+    meta.channel        = ap.primary;
+    meta.authMode       = ap.authmode;
+    meta.pairwiseCipher = ap.pairwise_cipher;
+    meta.groupCipher    = ap.group_cipher;
+    
+    if (!lockTake(LockId::LIVE, liveMutex, pdMS_TO_TICKS(100))) return;
+    bool newMeta = false;
+    observeWiFiAp(table, mac48, rssi, millis(), (const char*)ap.ssid, ssidLen, meta, &newMeta);
+    xSemaphoreGive(liveMutex);
+    
+    if (newMeta && logNew) {
+        char bssidNo[13];
+        formatMacNoDelim(mac48, bssidNo);
+        Serial.printf("[WiFi-META] %s Ch:%d Enc:%s Pairwise:%s RSSI:%d\n",
+                      bssidNo, ap.primary, getEncryptionType(ap.authmode),
+                      getCipherType(ap.pairwise_cipher), rssi);
     }
-    
-    report += "================================================================================\n\n";
-    return report;
 }
 
-void captureWiFiMetadata(std::map<String, ObservedEnhanced>& macMap,
+void captureWiFiMetadata(DeviceTable& table,
                          const BaselineConfig& config,
                          uint32_t startMs, uint32_t durMs) {
     WiFi.mode(WIFI_AP_STA);
     WiFi.disconnect(true, true);
     vTaskDelay(pdMS_TO_TICKS(100));
-
-    while (millis() - startMs < durMs) {
+    
+    if (!scanBuf) {
+        Serial.println("[ERROR] Wi-Fi scan engine not initialised");
+        return;
+    }
+    WiFi.scanDelete();
+    
+    // One sweep is ~13 channels x dwell; allow generous slack before retrying
+    const uint32_t sweepTimeoutMs = 14UL * config.dwellMs + 2000;
+    uint32_t sweeps = 0;
+    bool scanning = startAsyncWiFiScan(config);
+    
+    while (baselineKeepRunning(config, startMs, durMs)) {
         esp_task_wdt_reset();
-
-        int n = WiFi.scanNetworks(false, true); // blocking, show hidden SSIDs
-
-        if (n <= 0) {
-            if (n < 0) Serial.printf("[WARN] Wi-Fi scan failed: %d\n", n);
+        surveyTick(table, config);
+        
+        if (!scanning) {
             vTaskDelay(pdMS_TO_TICKS(500));
+            scanning = startAsyncWiFiScan(config);
             continue;
         }
-
-        // Pull detailed records from ESP-IDF BEFORE calling scanDelete()
-        uint16_t apCount = (uint16_t)n;
-        wifi_ap_record_t* apRecords = new (std::nothrow) wifi_ap_record_t[apCount];
-        bool hasDetailedRecords = false;
-        if (apRecords) {
-            hasDetailedRecords = (esp_wifi_scan_get_ap_records(&apCount, apRecords) == ESP_OK);
-            if (!hasDetailedRecords) {
-                Serial.println("[WARN] esp_wifi_scan_get_ap_records failed");
+        
+        const int16_t found = WiFi.scanComplete();
+        if (found == WIFI_SCAN_RUNNING) {
+            if ((esp_timer_get_time() - scanStartUs) / 1000 > sweepTimeoutMs) {
+                Serial.println("[WARN] Wi-Fi scan timed out, restarting");
+                esp_wifi_scan_stop();
+                drainStoppedWiFiScan();
+                scanning = false;
+                continue;
             }
-        } else {
-            Serial.println("[WARN] OOM allocating AP records");
+            vTaskDelay(pdMS_TO_TICKS(Config::WIFI_SCAN_POLL_MS));
+            continue;
         }
-
-        for (int i = 0; i < n; i++) {
-            int rssi = WiFi.RSSI(i);
-            if (rssi < config.rssiThreshold) continue;
-
-            String bssidNo = toUpperNoDelim(WiFi.BSSIDstr(i));
-            if (bssidNo.length() != 12) continue;
-
-            ObservedEnhanced &o = macMap[bssidNo];
-            safeCopy(o.source, sizeof(o.source), "Wi-Fi");
-            setBestRssiEnhanced(o, rssi);
-
-            String ssid = WiFi.SSID(i);
-            if (ssid.length() > 0 && o.name[0] == '\0') {
-                safeCopy(o.name, sizeof(o.name), ssid);
-            }
-
-            if (!o.hasWiFiMeta) {
-                o.hasWiFiMeta = true;
-                o.channel     = WiFi.channel(i);
-                o.authMode    = WiFi.encryptionType(i);
-                o.isHidden    = (ssid.length() == 0);
-
-                if (hasDetailedRecords && i < (int)apCount) {
-                    o.pairwiseCipher = apRecords[i].pairwise_cipher;
-                    o.groupCipher    = apRecords[i].group_cipher;
-                } else {
-                    o.pairwiseCipher = WIFI_CIPHER_TYPE_NONE;
-                    o.groupCipher    = WIFI_CIPHER_TYPE_NONE;
-                }
-
-                Serial.printf("[WiFi-META] %s Ch:%d Enc:%s Pairwise:%s RSSI:%d\n",
-                              bssidNo.c_str(), o.channel,
-                              getEncryptionType(o.authMode),
-                              getCipherType(o.pairwiseCipher), rssi);
-            }
+        if (found < 0) {
+            // Arduino gave up on the scan (its own timeout or a driver error)
+            WiFi.scanDelete();
+            scanning = false;
+            continue;
         }
-
-        delete[] apRecords;
-        WiFi.scanDelete();
-        vTaskDelay(pdMS_TO_TICKS(150));
+        sweeps++;
+        histRecordSince(metrics.wifiScanUs, scanStartUs);
+        
+        // Keep the radio busy while this sweep is aggregated
+        const uint16_t n = takeWiFiScanResults(found);
+        scanning = baselineKeepRunning(config, startMs, durMs) && startAsyncWiFiScan(config);
+        
+        for (uint16_t i = 0; i < n; i++) {
+            recordWiFiAp(table, scanBuf[i], config.rssiThreshold);
+        }
+    }
+    
+    if (scanning) {
+        esp_wifi_scan_stop();
+        drainStoppedWiFiScan();
+    }
+    
+    uint32_t wifiDevices = 0;
+    if (lockTake(LockId::LIVE, liveMutex, pdMS_TO_TICKS(500))) {
+        for (uint32_t slot = 0; slot < table.capacity; ++slot) {
+            if (table.used(slot) && (table.hot[slot].flags & DEV_WIFI)) wifiDevices++;
+        }
+        xSemaphoreGive(liveMutex);
     }
+    const uint32_t elapsedMs = millis() - startMs;
+    Serial.printf("[WiFi-SCAN] %u sweeps, %u BSSIDs, %.1f BSSIDs/min (%s, %u ms dwell)\n",
+                  (unsigned)sweeps, (unsigned)wifiDevices,
+                  elapsedMs ? wifiDevices * 60000.0f / elapsedMs : 0.0f,
+                  config.passiveScan ? "passive" : "active", (unsigned)config.dwellMs);
 }
 
 void loadFilters() {
-    if (xSemaphoreTake(filtersMutex, pdMS_TO_TICKS(1000)) != pdTRUE) {
+    if (!lockTake(LockId::FILTERS, filtersMutex, pdMS_TO_TICKS(1000))) {
         Serial.println("[ERROR] Failed to acquire filters mutex for loading");
         return;
     }
@@ -848,7 +876,7 @@ void loadFilters() {
         snprintf(key, sizeof(key), "f%u", i);
         
         String val = prefs.getString(key, "");
-        if (val.length() > 0 && isValidMAC(val)) {
+        if (val.length() > 0 && isValidFilterEntry(val)) {
             filters.push_back(val);
         } else if (val.length() > 0) {
             Serial.printf("[WARN] Skipping invalid filter at index %u: %s\n", 
@@ -857,17 +885,20 @@ void loadFilters() {
     }
     
     prefs.end();
+    rebuildFilterIndexLocked();
     xSemaphoreGive(filtersMutex);
     
     Serial.printf("[STORAGE] Loaded %u valid filters\n", (unsigned)filters.size());
 }
 
 void saveFilters() {
-    if (xSemaphoreTake(filtersMutex, pdMS_TO_TICKS(1000)) != pdTRUE) {
+    if (!lockTake(LockId::FILTERS, filtersMutex, pdMS_TO_TICKS(1000))) {
         Serial.println("[ERROR] Failed to acquire filters mutex for saving");
         return;
     }
     
+    rebuildFilterIndexLocked();
+    
     if (!prefs.begin(Config::PREFS_NAMESPACE, false)) {
         Serial.println("[ERROR] Failed to open preferences for writing");
         xSemaphoreGive(filtersMutex);
@@ -904,7 +935,7 @@ void saveFilters() {
 }
 
 void clearFilters() {
-    if (xSemaphoreTake(filtersMutex, pdMS_TO_TICKS(1000)) != pdTRUE) {
+    if (!lockTake(LockId::FILTERS, filtersMutex, pdMS_TO_TICKS(1000))) {
         Serial.println("[ERROR] Failed to acquire filters mutex for clearing");
         return;
     }
@@ -926,1171 +957,4736 @@ void clearFilters() {
     prefs.end();
     
     filters.clear();
+    rebuildFilterIndexLocked();
     xSemaphoreGive(filtersMutex);
     
     Serial.println("[STORAGE] Filters cleared");
 }
 
+// Single-entry adds (result-table links) go to the journaled watchlist, so a
+// click appends 8 bytes to flash instead of rewriting every NVS key.
 bool addFilterIfNew(const String& entry) {
-    if (!isValidMAC(entry)) {
-        Serial.printf("[WARN] Invalid MAC format, not adding: %s\n", entry.c_str());
-        return false;
-    }
-    
-    if (xSemaphoreTake(filtersMutex, pdMS_TO_TICKS(1000)) != pdTRUE) {
-        Serial.println("[ERROR] Failed to acquire filters mutex for adding");
-        return false;
-    }
+    WatchlistResult r = watchlistAdd(entry);
     
-    for (size_t i = 0; i < filters.size(); ++i) {
-        if (filters[i].equalsIgnoreCase(entry)) {
-            xSemaphoreGive(filtersMutex);
+    switch (r) {
+        case WatchlistResult::ADDED:
+            Serial.printf("[STORAGE] Added filter: %s\n", entry.c_str());
+            return true;
+        case WatchlistResult::EXISTS:
             Serial.printf("[INFO] Filter already exists: %s\n", entry.c_str());
             return false;
-        }
-    }
-    
-    if (filters.size() >= Config::MAX_FILTERS) {
-        xSemaphoreGive(filtersMutex);
-        Serial.printf("[ERROR] Maximum filter count (%u) reached\n", Config::MAX_FILTERS);
-        return false;
+        case WatchlistResult::INVALID:
+            Serial.printf("[WARN] Invalid MAC format, not adding: %s\n", entry.c_str());
+            return false;
+        case WatchlistResult::FULL:
+            Serial.printf("[ERROR] Watchlist full (%u entries)\n", Config::WATCHLIST_MAX_ENTRIES);
+            return false;
+        default:
+            Serial.println("[ERROR] Failed to add filter");
+            return false;
     }
+}
+
+// ================================
+// COMPILED FILTER INDEX
+// ================================
+// The radio callbacks never touch `filters` directly. Every change to the
+// String list is compiled into sorted integer arrays and published with an
+// atomic pointer swap, so a lookup is two binary searches with no lock and
+// no allocation. Content rules (filter_index.h) need the parsed payload, so
+// they run on the consumer task; the radio callbacks only check
+// contentRulesActive().
+//
+// Reclamation: every lookup pins the index (FilterIndexPin) by counting
+// itself in filterIndexReaders around the load and the search. A lookup that
+// starts after a swap can only see the new index, so once the count has been
+// zero at some point after the swap no one holds a retired index and it can
+// be freed. Retired indexes queue up until then (publish retries, loop()
+// polls); past FILTER_INDEX_RETIRED_MAX a publish waits briefly for a gap.
+
+static std::atomic<const FilterIndex*> activeFilterIndex(nullptr);
+static std::atomic<uint32_t> filterIndexReaders(0);
+static std::vector<const FilterIndex*> retiredFilterIndexes;   // guarded by filtersMutex
+static std::atomic<uint32_t> retiredFilterCount(0);            // lock-free hint for loop()
+static RuleHitTable ruleHitTable;                              // ids: filtersMutex, hits: consumer task
+
+struct FilterIndexPin {
+    const FilterIndex* idx;
     
-    filters.push_back(entry);
-    xSemaphoreGive(filtersMutex);
-    
-    saveFilters();
-    Serial.printf("[STORAGE] Added filter: %s\n", entry.c_str());
+    // seq_cst on both sides: the count is visible before the pointer is read
+    FilterIndexPin() {
+        filterIndexReaders.fetch_add(1);
+        idx = activeFilterIndex.load();
+    }
+    ~FilterIndexPin() { filterIndexReaders.fetch_sub(1, std::memory_order_release); }
+};
+
+// Caller must hold filtersMutex. Frees the retired indexes if no lookup is in flight.
+bool reclaimFilterIndexesLocked() {
+    if (retiredFilterIndexes.empty()) return true;
+    if (filterIndexReaders.load() != 0) return false;
+    for (const FilterIndex* idx : retiredFilterIndexes) delete idx;
+    retiredFilterIndexes.clear();
+    retiredFilterCount.store(0, std::memory_order_relaxed);
     return true;
 }
 
-bool matchesAnyFilter(const String& macNoDelim, std::vector<String>& localCopy) {
-    if (xSemaphoreTake(filtersMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-        localCopy = filters;
-        xSemaphoreGive(filtersMutex);
-    } else {
-        return false;
+// loop(): catches the quiet moment a busy publish missed
+void filterIndexReclaimTick() {
+    if (!retiredFilterCount.load(std::memory_order_relaxed)) return;
+    if (!lockTake(LockId::FILTERS, filtersMutex, 0)) return;
+    reclaimFilterIndexesLocked();
+    xSemaphoreGive(filtersMutex);
+}
+
+// Caller must hold filtersMutex. Merges the NVS filter list and the watchlist.
+void rebuildFilterIndexLocked() {
+    FilterIndex* next = compileFilterIndex(filters, watchlist.keys, watchlist.count, &ruleHitTable);
+    if (!next) {
+        Serial.println("[ERROR] OOM compiling filter index");
+        return;
     }
     
-    if (localCopy.empty()) return false;
+    const FilterIndex* prev = activeFilterIndex.exchange(next);
+    if (prev) {
+        retiredFilterIndexes.push_back(prev);
+        retiredFilterCount.store(retiredFilterIndexes.size(), std::memory_order_relaxed);
+    }
     
-    for (size_t i = 0; i < localCopy.size(); ++i) {
-        String fNo = toUpperNoDelim(localCopy[i]);
-        
-        if (fNo.length() == 6) {
-            if (macNoDelim.startsWith(fNo)) return true;
-        } else if (fNo.length() == 12) {
-            if (macNoDelim == fNo) return true;
-        }
+    // Bursts of scripted edits: bound the backlog by waiting out the lookups
+    const uint32_t t0 = millis();
+    while (!reclaimFilterIndexesLocked() && retiredFilterIndexes.size() > Config::FILTER_INDEX_RETIRED_MAX &&
+           millis() - t0 < Config::FILTER_INDEX_GRACE_WAIT_MS) {
+        vTaskDelay(1);
     }
     
-    return false;
+    Serial.printf("[FILTER] Compiled %u OUIs, %u MACs, %u content rules (%u retired pending)\n",
+                  (unsigned)next->ouiCount, (unsigned)next->macCount, (unsigned)next->ruleCount,
+                  (unsigned)retiredFilterIndexes.size());
+}
+
+uint32_t compiledFilterCount() {
+    FilterIndexPin pin;
+    return pin.idx ? pin.idx->ouiCount + pin.idx->macCount + pin.idx->ruleCount : 0;
+}
+
+// Lock-free and allocation-free; safe to call from the NimBLE host task
+bool matchesCompiledFilter(uint64_t mac48) {
+    FilterIndexPin pin;
+    return filterIndexMatchesMac(pin.idx, mac48);
+}
+
+// Lock-free; lets the radio callbacks forward adverts the MAC index rejected
+bool contentRulesActive() {
+    FilterIndexPin pin;
+    return pin.idx && pin.idx->ruleCount;
+}
+
+// First matching content rule, -1 if none. Counts the hit. Consumer task only
+// (hit counters have a single writer).
+int matchContentRules(const AdView& ad) {
+    FilterIndexPin pin;
+    return filterIndexMatchContent(pin.idx, ad);
+}
+
+String renderFilterStatsJson() {
+    String json = "{\"ouis\":0,\"macs\":0,\"rules\":[]}";
+    if (!lockTake(LockId::FILTERS, filtersMutex, pdMS_TO_TICKS(500))) return json;
+    const FilterIndex* idx = activeFilterIndex.load(std::memory_order_acquire);
+    if (idx) {
+        json = "{\"ouis\":" + String(idx->ouiCount);
+        json += ",\"macs\":" + String(idx->macCount);
+        json += ",\"rules\":[";
+        for (uint16_t r = 0; r < idx->ruleCount; r++) {
+            if (r) json += ",";
+            json += "{\"rule\":\"" + jsonEscape(formatContentRule(idx->rules[r]).c_str()) + "\"";
+            json += ",\"hits\":" + String(idx->ruleHitCount(r)) + "}";
+        }
+        json += "]}";
+    }
+    xSemaphoreGive(filtersMutex);
+    return json;
 }
 
 // ================================
-// DETECTION MODE
-// (keeping existing detection code unchanged)
+// WATCHLIST STORAGE (LittleFS)
 // ================================
+// Thousands of OUIs/MACs live in one sorted binary blob plus an append-only
+// journal of single adds/removes. Boot loads the blob into PSRAM and replays
+// the journal; the blob is only rewritten on bulk upload or once the journal
+// reaches WATCHLIST_COMPACT_OPS records.
 
-class DetectBLECallbacks : public NimBLEAdvertisedDeviceCallbacks {
-public:
-    void onResult(NimBLEAdvertisedDevice* dev) override {
-        if (!detectState.running || runMode != RunMode::DETECT) return;
-        
-        String macNo = toUpperNoDelim(String(dev->getAddress().toString().c_str()));
-        if (macNo.length() != 12) return;
-        
-        std::vector<String> localFilters;
-        if (!matchesAnyFilter(macNo, localFilters)) return;
-        
-        int rssi = dev->getRSSI();
-        uint32_t now = millis();
-        
-        if (xSemaphoreTake(detectMutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-            detectState.lastSeenMs = now;
-            detectState.lastRssi = (int16_t)rssi;
-            
-            if (rssi > detectState.bestRssi) {
-                detectState.bestRssi = (int16_t)rssi;
-            }
-            
-            if (now - detectState.lastHitMs >= Config::DETECT_DEBOUNCE_MS) {
-                detectState.lastHitMs = now;
-                detectState.hitPending = true;
-            }
-            
-            xSemaphoreGive(detectMutex);
-        }
+bool watchKeyFromString(const String& entry, uint64_t& key) {
+    uint64_t v = 0;
+    uint8_t digits = parseMacFilter(entry, v);
+    if (digits == 6) {
+        key = WATCH_KEY_OUI | v;
+    } else if (digits == 12) {
+        key = WATCH_KEY_MAC | v;
+    } else {
+        return false;
     }
-};
+    return true;
+}
 
-static DetectBLECallbacks detectBleCb;
+// Caller must hold filtersMutex. Returns false if nothing changed.
+bool watchlistApplyLocked(uint8_t op, uint64_t key) {
+    uint64_t* end = watchlist.keys + watchlist.count;
+    uint64_t* pos = std::lower_bound(watchlist.keys, end, key);
+    const bool present = (pos != end && *pos == key);
+    
+    if (op == WATCH_OP_ADD) {
+        if (present || watchlist.count >= watchlist.capacity) return false;
+        memmove(pos + 1, pos, (end - pos) * sizeof(uint64_t));
+        *pos = key;
+        watchlist.count++;
+        return true;
+    }
+    
+    if (op == WATCH_OP_REMOVE && present) {
+        memmove(pos, pos + 1, (end - pos - 1) * sizeof(uint64_t));
+        watchlist.count--;
+        return true;
+    }
+    return false;
+}
 
-struct DetectParams {
-    DetectionMode mode;
-    bool stealth;
-};
+// Caller must hold filtersMutex. Writes the full blob and drops the journal.
+bool watchlistCompactLocked() {
+    if (!watchlist.fsReady) return false;
+    
+    File f = LittleFS.open(Config::WATCHLIST_TMP_PATH, FILE_WRITE);
+    if (!f) {
+        Serial.println("[ERROR] Failed to open watchlist for writing");
+        return false;
+    }
+    
+    WatchlistHeader hdr = {WATCHLIST_MAGIC, WATCHLIST_VERSION, 0, watchlist.count};
+    bool ok = f.write((const uint8_t*)&hdr, sizeof(hdr)) == sizeof(hdr);
+    const size_t bytes = watchlist.count * sizeof(uint64_t);
+    if (ok && bytes) {
+        ok = f.write((const uint8_t*)watchlist.keys, bytes) == bytes;
+    }
+    f.close();
+    
+    if (!ok) {
+        Serial.println("[ERROR] Short write on watchlist");
+        LittleFS.remove(Config::WATCHLIST_TMP_PATH);
+        return false;
+    }
+    
+    // LittleFS rename replaces the old blob atomically; keep the journal
+    // unless the new blob is actually in place
+    if (!LittleFS.rename(Config::WATCHLIST_TMP_PATH, Config::WATCHLIST_PATH)) {
+        Serial.println("[ERROR] Failed to replace watchlist blob");
+        LittleFS.remove(Config::WATCHLIST_TMP_PATH);
+        return false;
+    }
+    LittleFS.remove(Config::WATCHLIST_JOURNAL_PATH);
+    watchlist.journalOps = 0;
+    
+    Serial.printf("[WATCHLIST] Wrote %u entries\n", (unsigned)watchlist.count);
+    return true;
+}
 
-void cleanupDetection() {
-    Serial.println("[DETECT] Cleaning up...");
+// Caller must hold filtersMutex
+void watchlistJournalLocked(uint8_t op, uint64_t key) {
+    if (!watchlist.fsReady) return;
     
-    if (NimBLEDevice::getInitialized()) {
-        NimBLEScan* scan = NimBLEDevice::getScan();
-        if (scan) {
-            scan->stop();
-        }
-        NimBLEDevice::deinit(true);
+    if (watchlist.journalOps + 1 >= Config::WATCHLIST_COMPACT_OPS) {
+        watchlistCompactLocked();
+        return;
     }
     
-    if (xSemaphoreTake(detectMutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
-        detectState.reset();
-        xSemaphoreGive(detectMutex);
+    File f = LittleFS.open(Config::WATCHLIST_JOURNAL_PATH, FILE_APPEND);
+    if (!f) {
+        Serial.println("[ERROR] Failed to open watchlist journal");
+        return;
     }
     
-    runMode = RunMode::STOPPED;
+    const uint64_t rec = ((uint64_t)op << 56) | key;
+    if (f.write((const uint8_t*)&rec, sizeof(rec)) == sizeof(rec)) {
+        watchlist.journalOps++;
+    }
+    f.close();
 }
 
-void dropWiFiAP() {
-    WiFi.softAPdisconnect(true);
-    vTaskDelay(pdMS_TO_TICKS(Config::WIFI_MODE_CHANGE_DELAY_MS));
-    WiFi.mode(WIFI_OFF);
-    vTaskDelay(pdMS_TO_TICKS(Config::WIFI_MODE_CHANGE_DELAY_MS));
+// Caller must hold filtersMutex. Loads a blob written by watchlistCompactLocked().
+bool watchlistLoadBlobLocked(const char* path) {
+    File f = LittleFS.open(path, FILE_READ);
+    if (!f) return false;
+    
+    bool ok = false;
+    WatchlistHeader hdr;
+    if (f.read((uint8_t*)&hdr, sizeof(hdr)) == sizeof(hdr) &&
+        hdr.magic == WATCHLIST_MAGIC && hdr.version == WATCHLIST_VERSION) {
+        uint32_t count = std::min(hdr.count, watchlist.capacity);
+        size_t bytes = count * sizeof(uint64_t);
+        if (f.read((uint8_t*)watchlist.keys, bytes) == bytes) {
+            watchlist.count = count;
+            ok = true;
+        } else {
+            Serial.printf("[WARN] Watchlist blob %s truncated, ignoring\n", path);
+        }
+    } else {
+        Serial.printf("[WARN] Watchlist blob %s has bad header, ignoring\n", path);
+    }
+    f.close();
+    return ok;
 }
 
-void detectionTask(void* pv) {
-    DetectParams* pParams = (DetectParams*)pv;
-    DetectParams params = *pParams;
-    delete pParams;
-    
-    stealthMode = params.stealth;
-    runMode = RunMode::DETECT;
-    
-    if (xSemaphoreTake(detectMutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
-        detectState.reset();
-        detectState.running = true;
-        xSemaphoreGive(detectMutex);
+void watchlistInit() {
+    watchlist.capacity = Config::WATCHLIST_MAX_ENTRIES;
+    watchlist.keys = (uint64_t*)psramAlloc(watchlist.capacity * sizeof(uint64_t));
+    if (!watchlist.keys) {
+        Serial.println("[ERROR] OOM allocating watchlist");
+        watchlist.capacity = 0;
+        return;
     }
     
-    Serial.printf("[DETECT] Starting, mode=%d (0=WiFi,1=BLE,2=Both)\n", (int)params.mode);
+    watchlist.fsReady = LittleFS.begin(true);
+    if (!watchlist.fsReady) {
+        Serial.println("[ERROR] LittleFS mount failed, watchlist is RAM-only");
+        return;
+    }
     
-    dropWiFiAP();
+    if (!lockTake(LockId::FILTERS, filtersMutex, pdMS_TO_TICKS(1000))) {
+        Serial.println("[ERROR] Failed to acquire filters mutex for watchlist");
+        return;
+    }
     
-    NimBLEScan* bleScan = nullptr;
+    if (!watchlistLoadBlobLocked(Config::WATCHLIST_PATH) &&
+        !LittleFS.exists(Config::WATCHLIST_PATH) &&
+        watchlistLoadBlobLocked(Config::WATCHLIST_TMP_PATH)) {
+        // Interrupted compaction: the temp blob is complete, so put it in
+        // place. Replaying the old journal over it is harmless.
+        Serial.println("[WATCHLIST] Recovered blob from interrupted compaction");
+        LittleFS.rename(Config::WATCHLIST_TMP_PATH, Config::WATCHLIST_PATH);
+    }
     
-    if (params.mode == DetectionMode::BLE_ONLY || params.mode == DetectionMode::WIFI_AND_BLE) {
-        NimBLEDevice::init("detect");
-        
-        bleScan = NimBLEDevice::getScan();
-        if (!bleScan) {
-            Serial.println("[ERROR] Failed to get BLE scan object");
-            cleanupDetection();
-            vTaskDelete(nullptr);
-            return;
+    File j = LittleFS.open(Config::WATCHLIST_JOURNAL_PATH, FILE_READ);
+    if (j) {
+        uint64_t rec;
+        while (j.read((uint8_t*)&rec, sizeof(rec)) == sizeof(rec)) {
+            watchlistApplyLocked((uint8_t)(rec >> 56), rec & ~(0xFFULL << 56));
+            watchlist.journalOps++;
         }
-        
-        bleScan->setAdvertisedDeviceCallbacks(&detectBleCb, false);
-        bleScan->setActiveScan(true);
-        bleScan->setInterval(Config::BLE_SCAN_INTERVAL);
-        bleScan->setWindow(Config::BLE_SCAN_WINDOW);
-        bleScan->setDuplicateFilter(false);
-        
-        if (!bleScan->start(0, nullptr, false)) {
-            Serial.println("[ERROR] BLE scan start failed");
-            cleanupDetection();
-            vTaskDelete(nullptr);
-            return;
-        }
-        
-        Serial.println("[DETECT] BLE scan active");
+        j.close();
     }
     
-    if (params.mode == DetectionMode::WIFI_ONLY || params.mode == DetectionMode::WIFI_AND_BLE) {
-        WiFi.mode(WIFI_STA);
-        WiFi.disconnect(true, true);
-        vTaskDelay(pdMS_TO_TICKS(200));
-        Serial.println("[DETECT] Wi-Fi scan loop active");
+    rebuildFilterIndexLocked();
+    xSemaphoreGive(filtersMutex);
+    
+    Serial.printf("[WATCHLIST] Loaded %u entries (%u journal ops)\n",
+                  (unsigned)watchlist.count, (unsigned)watchlist.journalOps);
+}
+
+WatchlistResult watchlistUpdate(uint8_t op, const String& entry) {
+    uint64_t key = 0;
+    if (!watchKeyFromString(entry, key)) return WatchlistResult::INVALID;
+    
+    if (!lockTake(LockId::FILTERS, filtersMutex, pdMS_TO_TICKS(1000))) {
+        Serial.println("[ERROR] Failed to acquire filters mutex for watchlist");
+        return WatchlistResult::BUSY;
     }
     
-    bool wifiScanInProgress = false;
-    uint32_t wifiNextScanMs = 0;
-    uint32_t lastDetectSignalMs = 0;
+    WatchlistResult result;
+    if (watchlistApplyLocked(op, key)) {
+        watchlistJournalLocked(op, key);
+        rebuildFilterIndexLocked();
+        result = (op == WATCH_OP_ADD) ? WatchlistResult::ADDED : WatchlistResult::REMOVED;
+    } else if (op == WATCH_OP_ADD) {
+        result = (watchlist.count >= watchlist.capacity) ? WatchlistResult::FULL
+                                                         : WatchlistResult::EXISTS;
+    } else {
+        result = WatchlistResult::NOT_FOUND;
+    }
     
-    for (;;) {
-        esp_task_wdt_reset();
-        
-        bool anyMatch = false;
-        
-        if (params.mode == DetectionMode::WIFI_ONLY || params.mode == DetectionMode::WIFI_AND_BLE) {
-            const uint32_t now = millis();
-            
-            if (!wifiScanInProgress && now >= wifiNextScanMs) {
-                WiFi.scanDelete();
-                if (WiFi.scanNetworks(true, true) == WIFI_SCAN_FAILED) {
-                    Serial.println("[WARN] Wi-Fi scan failed to start");
-                } else {
-                    wifiScanInProgress = true;
-                }
-                wifiNextScanMs = now + Config::WIFI_SCAN_INTERVAL_MS;
-            }
-            
-            int n = WiFi.scanComplete();
-            if (wifiScanInProgress && n >= 0) {
-                std::vector<String> localFilters;
-                
-                for (int i = 0; i < n; i++) {
-                    String bssidNo = toUpperNoDelim(WiFi.BSSIDstr(i));
-                    
-                    if (matchesAnyFilter(bssidNo, localFilters)) {
-                        Serial.printf("[DETECT Wi-Fi] Match %s SSID:%s RSSI:%d\n",
-                                      bssidNo.c_str(), WiFi.SSID(i).c_str(), WiFi.RSSI(i));
-                        anyMatch = true;
-                        break;
-                    }
-                }
-                
-                WiFi.scanDelete();
-                wifiScanInProgress = false;
-            }
-        }
-        
-        const uint32_t now2 = millis();
-        
-        bool present = anyMatch;
-        if (xSemaphoreTake(detectMutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-            if (detectState.lastSeenMs != 0 && 
-                (now2 - detectState.lastSeenMs) <= Config::DETECT_STALE_MS) {
-                present = true;
-            }
-            xSemaphoreGive(detectMutex);
-        }
-        
-        if (present && (now2 - lastDetectSignalMs) >= Config::DETECT_PRESENCE_MS) {
-            lastDetectSignalMs = now2;
-            
-            int16_t best = -127;
-            if (xSemaphoreTake(detectMutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-                best = detectState.bestRssi;
-                detectState.bestRssi = -127;
-                if (best == -127) best = detectState.lastRssi;
-                xSemaphoreGive(detectMutex);
-            }
-            
-            Serial.printf("[DETECT] Presence: RSSI=%d dBm\n", (int)best);
-            
-            if (stealthMode) {
-                Hardware::ledFlashOnce(80);
-            } else {
-                Hardware::detectBeep();
-            }
-        }
-        
-        vTaskDelay(pdMS_TO_TICKS(80));
+    xSemaphoreGive(filtersMutex);
+    return result;
+}
+
+WatchlistResult watchlistAdd(const String& entry) { return watchlistUpdate(WATCH_OP_ADD, entry); }
+WatchlistResult watchlistRemove(const String& entry) { return watchlistUpdate(WATCH_OP_REMOVE, entry); }
+
+void watchlistClear() {
+    if (!lockTake(LockId::FILTERS, filtersMutex, pdMS_TO_TICKS(1000))) {
+        Serial.println("[ERROR] Failed to acquire filters mutex for watchlist");
+        return;
     }
+    watchlist.count = 0;
+    watchlistCompactLocked();
+    rebuildFilterIndexLocked();
+    xSemaphoreGive(filtersMutex);
+    Serial.println("[WATCHLIST] Cleared");
 }
 
-// ================================
-// FOX HUNT MODE
-// (keeping existing fox hunt code unchanged)
-// ================================
+// Bulk upload accepts either a binary blob (WatchlistHeader + keys) or text
+// with one OUI/MAC per line ('#' starts a comment). Entries are staged in a
+// PSRAM buffer and swapped in when the request completes. The state belongs
+// to the request (_tempObject, freed with it); the staging buffer is freed on
+// commit or when the client goes away mid-upload.
+struct WatchlistUpload {
+    uint64_t* staged;
+    uint32_t count;
+    uint32_t rejected;
+    uint32_t keysSeen;       // binary: key records read, checked against the header
+    uint32_t headerCount;
+    size_t received;
+    bool binary;
+    bool invalid;            // binary header failed validation; rest is ignored
+    uint8_t partial[sizeof(WatchlistHeader)];
+    uint8_t partialLen;
+    char line[48];
+    uint8_t lineLen;
+};
 
-int calculateBeepIntervalFox(int rssi) {
-    if (rssi >= -35) {
-        return map(rssi, -35, -25, 80, 25);
-    } else if (rssi >= -45) {
-        return map(rssi, -45, -35, 140, 80);
-    } else if (rssi >= -55) {
-        return map(rssi, -55, -45, 250, 140);
-    } else if (rssi >= -65) {
-        return map(rssi, -65, -55, 450, 250);
-    } else if (rssi >= -75) {
-        return map(rssi, -75, -65, 900, 450);
-    } else if (rssi >= -85) {
-        return map(rssi, -85, -75, 1600, 900);
+// Staged duplicates are squeezed out when the buffer fills, so only distinct
+// entries beyond capacity are rejected
+void watchlistUploadStage(WatchlistUpload* up, uint64_t key) {
+    if (up->count >= Config::WATCHLIST_MAX_ENTRIES) {
+        std::sort(up->staged, up->staged + up->count);
+        up->count = std::unique(up->staged, up->staged + up->count) - up->staged;
+    }
+    if (up->count < Config::WATCHLIST_MAX_ENTRIES) {
+        up->staged[up->count++] = key;
     } else {
-        return 2800;
+        up->rejected++;
     }
 }
 
-void foxBuzzerInit() {
-    if (stealthMode) return;
-    pinMode(Config::BUZZER_PIN, OUTPUT);
-    ledcAttachPin(Config::BUZZER_PIN, Config::BUZZER_CHANNEL);
-    ledcSetup(Config::BUZZER_CHANNEL, 1000, Config::LEDC_RESOLUTION_BITS);
-    ledcWrite(Config::BUZZER_CHANNEL, 0);
+void watchlistUploadEndLine(WatchlistUpload* up) {
+    up->line[up->lineLen] = '\0';
+    char* hash = strchr(up->line, '#');
+    if (hash) *hash = '\0';
+    
+    String entry(up->line);
+    entry.trim();
+    up->lineLen = 0;
+    if (!entry.length()) return;
+    
+    uint64_t key;
+    if (watchKeyFromString(entry, key)) {
+        watchlistUploadStage(up, key);
+    } else {
+        up->rejected++;
+    }
 }
 
-void foxBeepOn() {
-    if (!stealthMode) {
-        ledcWriteTone(Config::BUZZER_CHANNEL, 1000);
-        ledcWrite(Config::BUZZER_CHANNEL, Config::BUZZER_DUTY);
-    }
-    Hardware::ledOn();
+void watchlistUploadRelease(WatchlistUpload* up) {
+    if (!up) return;
+    free(up->staged);
+    up->staged = nullptr;
 }
 
-void foxBeepOff() {
-    if (!stealthMode) {
-        ledcWrite(Config::BUZZER_CHANNEL, 0);
+// Validates the blob header as watchlistInit() does
+bool watchlistUploadHeaderOk(WatchlistUpload* up) {
+    WatchlistHeader hdr;
+    memcpy(&hdr, up->partial, sizeof(hdr));
+    if (hdr.magic != WATCHLIST_MAGIC || hdr.version != WATCHLIST_VERSION) return false;
+    up->headerCount = hdr.count;
+    return true;
+}
+
+void watchlistUploadFeed(AsyncWebServerRequest* req, const uint8_t* data, size_t len, size_t index) {
+    if (index == 0 && !req->_tempObject) {
+        WatchlistUpload* fresh = (WatchlistUpload*)calloc(1, sizeof(WatchlistUpload));
+        if (!fresh) return;
+        req->_tempObject = fresh;
+        fresh->staged = (uint64_t*)psramAlloc(Config::WATCHLIST_MAX_ENTRIES * sizeof(uint64_t));
+        if (!fresh->staged) {
+            Serial.println("[ERROR] OOM staging watchlist upload");
+            return;
+        }
+        fresh->binary = (len >= 4 && memcmp(data, &WATCHLIST_MAGIC, 4) == 0);
+        req->onDisconnect([req]() { watchlistUploadRelease((WatchlistUpload*)req->_tempObject); });
+    }
+    
+    WatchlistUpload* up = (WatchlistUpload*)req->_tempObject;
+    if (!up || !up->staged || up->invalid || index != up->received) return;
+    up->received += len;
+    
+    for (size_t i = 0; i < len && !up->invalid; i++) {
+        const uint8_t b = data[i];
+        if (up->binary) {
+            // Header first, then 8-byte keys; partial[] holds a split record
+            const bool inHeader = index + i < sizeof(WatchlistHeader);
+            const size_t need = inHeader ? sizeof(WatchlistHeader) : sizeof(uint64_t);
+            up->partial[up->partialLen++] = b;
+            if (up->partialLen == need) {
+                if (inHeader) {
+                    up->invalid = !watchlistUploadHeaderOk(up);
+                } else {
+                    uint64_t key;
+                    memcpy(&key, up->partial, sizeof(key));
+                    up->keysSeen++;
+                    const uint64_t kind = key & ~WATCH_VALUE_MASK;
+                    if (kind == WATCH_KEY_OUI || kind == WATCH_KEY_MAC) {
+                        watchlistUploadStage(up, key);
+                    } else {
+                        up->rejected++;
+                    }
+                }
+                up->partialLen = 0;
+            }
+        } else if (b == '\n' || b == '\r' || b == ',') {
+            watchlistUploadEndLine(up);
+        } else if (up->lineLen < sizeof(up->line) - 1) {
+            up->line[up->lineLen++] = (char)b;
+        }
     }
-    Hardware::ledOff();
 }
 
-void foxThreeBeeps() {
-    for (int i = 0; i < 3; i++) {
-        foxBeepOn();
-        vTaskDelay(pdMS_TO_TICKS(100));
-        foxBeepOff();
-        vTaskDelay(pdMS_TO_TICKS(60));
+// Sorted union of the (sorted, distinct) upload and the current watchlist
+// into `out`. Existing entries are always kept; new ones fill the remaining
+// capacity and the rest are counted in `dropped`. Returns the entry count.
+uint32_t watchlistMergeKeys(const uint64_t* up, uint32_t n, const uint64_t* cur, uint32_t c,
+                            uint64_t* out, uint32_t& dropped) {
+    uint32_t budget = Config::WATCHLIST_MAX_ENTRIES > c ? Config::WATCHLIST_MAX_ENTRIES - c : 0;
+    uint32_t i = 0, j = 0, w = 0;
+    dropped = 0;
+    while (i < n || j < c) {
+        if (j < c && (i >= n || cur[j] <= up[i])) {
+            if (i < n && up[i] == cur[j]) i++;
+            out[w++] = cur[j++];
+        } else if (budget) {
+            budget--;
+            out[w++] = up[i++];
+        } else {
+            dropped++;
+            i++;
+        }
     }
+    return w;
 }
 
-void handleFoxProximityBeeping() {
-    const uint32_t now = millis();
-    
-    bool hasTarget = false;
-    uint32_t lastSeen = 0;
-    int rssi = -100;
-    
-    if (xSemaphoreTake(detectMutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-        hasTarget = foxState.hasTarget;
-        lastSeen = foxState.lastSeenMs;
-        rssi = foxState.rssi;
-        xSemaphoreGive(detectMutex);
+// Commits the request's upload. Returns the HTTP status; `reply` gets the
+// entry count or the reason it failed.
+int watchlistUploadCommit(AsyncWebServerRequest* req, bool merge, String& reply) {
+    WatchlistUpload* up = (WatchlistUpload*)req->_tempObject;
+    if (!up || !up->staged) {
+        reply = "Watchlist upload failed (no data or out of memory)\n";
+        return 500;
     }
-    
-    if (!hasTarget || (now - lastSeen) > Config::FOX_LOST_TIMEOUT_MS) {
-        foxBeepOff();
-        foxState.isBeeping = false;
-        return;
+    if (up->binary) {
+        if (up->invalid || up->received < sizeof(WatchlistHeader)) {
+            watchlistUploadRelease(up);
+            reply = "Bad watchlist header (magic or version)\n";
+            return 400;
+        }
+        if (up->partialLen || up->keysSeen != up->headerCount) {
+            watchlistUploadRelease(up);
+            reply = "Watchlist blob length does not match its header count (" + String(up->keysSeen) +
+                    " of " + String(up->headerCount) + " keys)\n";
+            return 400;
+        }
+    } else if (up->lineLen) {
+        watchlistUploadEndLine(up);
     }
     
-    const int interval = calculateBeepIntervalFox(rssi);
+    std::sort(up->staged, up->staged + up->count);
+    uint32_t n = std::unique(up->staged, up->staged + up->count) - up->staged;
+    uint32_t dropped = 0;
     
-    if (rssi >= -25) {
-        foxBeepOn();
-        foxState.isBeeping = true;
-        return;
+    if (!lockTake(LockId::FILTERS, filtersMutex, pdMS_TO_TICKS(1000))) {
+        Serial.println("[ERROR] Failed to acquire filters mutex for watchlist");
+        watchlistUploadRelease(up);
+        reply = "Watchlist busy, try again\n";
+        return 503;
     }
     
-    if (foxState.isBeeping) {
-        if (now - foxState.beepStartMs >= Config::FOX_BEEP_DUR_MS) {
-            foxBeepOff();
-            foxState.isBeeping = false;
-        }
-    } else {
-        if (now - foxState.beepStartMs >= (uint32_t)interval) {
-            foxBeepOn();
-            foxState.isBeeping = true;
-            foxState.beepStartMs = now;
+    if (merge && watchlist.count) {
+        uint64_t* merged = (uint64_t*)psramAlloc(Config::WATCHLIST_MAX_ENTRIES * sizeof(uint64_t));
+        if (!merged) {
+            xSemaphoreGive(filtersMutex);
+            watchlistUploadRelease(up);
+            Serial.println("[ERROR] OOM merging watchlist upload");
+            reply = "Watchlist upload failed (out of memory)\n";
+            return 500;
         }
+        n = watchlistMergeKeys(up->staged, n, watchlist.keys, watchlist.count, merged, dropped);
+        std::swap(up->staged, merged);
+        free(merged);
     }
-}
+    
+    // Swap buffers; the old one is released with the upload state
+    std::swap(watchlist.keys, up->staged);
+    watchlist.count = n;
+    watchlist.capacity = Config::WATCHLIST_MAX_ENTRIES;
+    watchlistCompactLocked();
+    rebuildFilterIndexLocked();
+    xSemaphoreGive(filtersMutex);
+    watchlistUploadRelease(up);
+    
+    Serial.printf("[WATCHLIST] Upload committed: %u entries (%u rejected, %u over capacity)\n",
+                  (unsigned)n, (unsigned)up->rejected, (unsigned)dropped);
+    reply = "Watchlist entries: " + String(n) + "\n";
+    if (up->rejected || dropped) {
+        reply += "Not added: " + String(up->rejected) + " rejected (invalid or over capacity), " +
+                 String(dropped) + " over capacity when merging\n";
+    }
+    return 200;
+}
+
+// ================================
+// TASK TOPOLOGY
+// ================================
+// Core 0 (RADIO_CORE):  Wi-Fi driver, NimBLE host and the tasks that drive
+//                       scans (detect / fox / baseline). They mostly sleep.
+// Core 1 (WORKER_CORE): advertisement consumer (aggregation), async_tcp (web
+//                       server and chunked result rendering, pinned with
+//                       CONFIG_ASYNC_TCP_RUNNING_CORE in platformio.ini) and
+//                       Arduino loop().
+
+enum class TaskRole : uint8_t { DETECT, FOX, BASELINE, ADV_CONSUMER, SIGNAL, BENCH, COUNT };
+
+struct TaskSpec {
+    const char* name;
+    uint32_t stackBytes;
+    UBaseType_t priority;
+    BaseType_t core;
+};
+
+static const TaskSpec TASK_SPECS[(size_t)TaskRole::COUNT] = {
+    {"detectionTask", 12288, 1, Config::RADIO_CORE},
+    {"foxHuntTask",   12288, 1, Config::RADIO_CORE},
+    {"baselineTask",  16384, 1, Config::RADIO_CORE},
+    {"advConsumer",    6144, 2, Config::WORKER_CORE},   // above loop(), below async_tcp
+    {"outputTask",     2560, 1, Config::WORKER_CORE},
+    {"benchTask",     12288, 1, Config::RADIO_CORE},    // stands in for the NimBLE host
+};
+
+// Tasks we don't create but want in /task_status when run-time stats are off
+static const char* const SYSTEM_TASK_NAMES[] = {
+    "nimble_host", "wifi", "async_tcp", "loopTask", "IDLE0", "IDLE1"
+};
+
+bool launchTask(TaskRole role, TaskFunction_t fn, void* arg, TaskHandle_t* handle = nullptr) {
+    const TaskSpec& spec = TASK_SPECS[(size_t)role];
+    BaseType_t result = xTaskCreatePinnedToCore(fn, spec.name, spec.stackBytes, arg,
+                                                spec.priority, handle, spec.core);
+    if (result != pdPASS) {
+        Serial.printf("[ERROR] Failed to create %s\n", spec.name);
+        return false;
+    }
+    return true;
+}
+
+// Our tasks, then the system ones, that currently exist
+template <typename Fn>
+void forEachKnownTask(Fn fn) {
+    for (size_t i = 0; i < (size_t)TaskRole::COUNT; i++) {
+        TaskHandle_t h = xTaskGetHandle(TASK_SPECS[i].name);
+        if (h) fn(TASK_SPECS[i].name, h);
+    }
+    for (size_t i = 0; i < sizeof(SYSTEM_TASK_NAMES) / sizeof(SYSTEM_TASK_NAMES[0]); i++) {
+        TaskHandle_t h = xTaskGetHandle(SYSTEM_TASK_NAMES[i]);
+        if (h) fn(SYSTEM_TASK_NAMES[i], h);
+    }
+}
+
+void appendTaskJson(String& json, const char* name, TaskHandle_t h, UBaseType_t prio,
+                    uint32_t stackFree, float cpuPct) {
+    const BaseType_t core = xTaskGetAffinity(h);
+    if (json[json.length() - 1] == '}') json += ",";
+    json += "{\"name\":\"" + String(name) + "\",";
+    json += "\"core\":" + String(core == tskNO_AFFINITY ? -1 : (int)core) + ",";
+    json += "\"priority\":" + String((unsigned)prio) + ",";
+    json += "\"stack_free\":" + String(stackFree);
+    if (cpuPct >= 0) json += ",\"cpu_pct\":" + String(cpuPct, 1);
+    json += "}";
+}
+
+// CPU % is per core, measured between successive calls (first call reports
+// the average since boot). Stack figures are high-water marks in bytes.
+String renderTaskStatusJson() {
+    String json = "{";
+#if configUSE_TRACE_FACILITY && configGENERATE_RUN_TIME_STATS
+    static const uint8_t MAX_TRACKED = 32;
+    static TaskHandle_t prevHandle[MAX_TRACKED];
+    static uint32_t prevRunTime[MAX_TRACKED];
+    static uint32_t prevTotal = 0;
+    
+    const UBaseType_t cap = uxTaskGetNumberOfTasks() + 4;
+    TaskStatus_t* st = (TaskStatus_t*)malloc(cap * sizeof(TaskStatus_t));
+    if (!st) return String("{\"error\":\"oom\"}");
+    
+    uint32_t total = 0;
+    const UBaseType_t n = uxTaskGetSystemState(st, cap, &total);
+    const uint32_t dTotal = total - prevTotal;
+    
+    json += "\"run_time_stats\":true,\"tasks\":[";
+    for (UBaseType_t i = 0; i < n; i++) {
+        uint32_t prev = 0;
+        for (uint8_t k = 0; k < MAX_TRACKED; k++) {
+            if (prevHandle[k] == st[i].xHandle) { prev = prevRunTime[k]; break; }
+        }
+        const uint32_t dRun = st[i].ulRunTimeCounter - prev;
+        const float pct = dTotal ? (100.0f * dRun) / dTotal : 0.0f;
+        appendTaskJson(json, st[i].pcTaskName, st[i].xHandle, st[i].uxCurrentPriority,
+                       st[i].usStackHighWaterMark, pct);
+    }
+    json += "]";
+    
+    memset(prevHandle, 0, sizeof(prevHandle));
+    for (UBaseType_t i = 0; i < n && i < MAX_TRACKED; i++) {
+        prevHandle[i] = st[i].xHandle;
+        prevRunTime[i] = st[i].ulRunTimeCounter;
+    }
+    prevTotal = total;
+    free(st);
+#else
+    json += "\"run_time_stats\":false,\"tasks\":[";
+    forEachKnownTask([&json](const char* name, TaskHandle_t h) {
+        appendTaskJson(json, name, h, uxTaskPriorityGet(h), uxTaskGetStackHighWaterMark(h), -1);
+    });
+    json += "]";
+#endif
+    json += "}";
+    return json;
+}
+
+// ================================
+// OUTPUT ENGINE
+// ================================
+// Buzzer and LED belong to one low-priority task. Callers enqueue a pattern
+// and return immediately. A pattern of equal or higher priority cuts off the
+// one playing; lower ones wait (latest per priority wins). Stealth is
+// applied here: patterns still flash the LED but never sound.
+
+enum class OutputPrio : uint8_t { STATUS, PRESENCE, PROXIMITY, COUNT };
+
+struct OutputPattern {
+    uint16_t onMs;
+    uint16_t offMs;
+    uint16_t toneHz;        // 0 = LED only
+    uint8_t repeats;        // 0 = cancel this priority
+    OutputPrio prio;
+};
+
+static const OutputPattern OUT_STARTUP = {
+    Config::BEEP_DURATION_MS, Config::BEEP_PAUSE_MS, Config::BUZZER_FREQ, 2, OutputPrio::STATUS };
+static const OutputPattern OUT_BASELINE_DONE = {
+    Config::BEEP_DURATION_MS, Config::BEEP_PAUSE_MS, Config::BUZZER_FREQ, 3, OutputPrio::STATUS };
+static const OutputPattern OUT_PRESENCE = {
+    Config::BEEP_DURATION_MS, Config::BEEP_PAUSE_MS, Config::BUZZER_FREQ, 1, OutputPrio::PRESENCE };
+static const OutputPattern OUT_FOX_START = {
+    100, 60, Config::FOX_TONE_HZ, 3, OutputPrio::PROXIMITY };
+
+static QueueHandle_t outputQueue = nullptr;
+
+inline uint32_t outputPatternMs(const OutputPattern& p) {
+    return (uint32_t)p.repeats * (p.onMs + p.offMs);
+}
+
+// Safe from any task or esp_timer callback; drops the request if the queue is full
+bool outputPlay(const OutputPattern& p) {
+    if (!outputQueue) return false;
+    return xQueueSend(outputQueue, &p, 0) == pdTRUE;
+}
+
+void outputCancel(OutputPrio prio) {
+    OutputPattern p = {};
+    p.prio = prio;
+    outputPlay(p);
+}
+
+// Switching on writes the duty every time, so a restarted tone has no gap
+static void outputApply(bool on, uint16_t toneHz) {
+    static uint16_t channelHz = Config::BUZZER_FREQ;
+    if (on && toneHz && !stealthMode) {
+        if (toneHz != channelHz) {
+            ledcSetup(Config::BUZZER_CHANNEL, toneHz, Config::LEDC_RESOLUTION_BITS);
+            channelHz = toneHz;
+        }
+        ledcWrite(Config::BUZZER_CHANNEL, Config::BUZZER_DUTY);
+    } else {
+        ledcWrite(Config::BUZZER_CHANNEL, 0);
+    }
+    if (on) Hardware::ledOn(); else Hardware::ledOff();
+}
+
+void outputTask(void*) {
+    const size_t levels = (size_t)OutputPrio::COUNT;
+    OutputPattern pending[levels] = {};
+    bool waiting[levels] = {};
+    OutputPattern cur = {};
+    bool playing = false;
+    uint16_t phase = 0;             // even = on, odd = off
+    uint32_t phaseEndMs = 0;
+    
+    for (;;) {
+        TickType_t wait = portMAX_DELAY;
+        if (playing) {
+            const int32_t left = (int32_t)(phaseEndMs - millis());
+            wait = left > 0 ? pdMS_TO_TICKS(left) : 0;
+        }
+        
+        OutputPattern in;
+        while (xQueueReceive(outputQueue, &in, wait) == pdTRUE) {
+            wait = 0;
+            const size_t level = (size_t)in.prio;
+            if (level >= levels) continue;
+            if (in.repeats == 0) {
+                waiting[level] = false;
+                if (playing && cur.prio == in.prio) {
+                    playing = false;
+                    outputApply(false, 0);
+                }
+                continue;
+            }
+            if (playing && in.prio >= cur.prio) playing = false;
+            pending[level] = in;
+            waiting[level] = true;
+        }
+        
+        const uint32_t now = millis();
+        if (playing && (int32_t)(now - phaseEndMs) >= 0) {
+            phase++;
+            if (phase >= (uint16_t)cur.repeats * 2) {
+                playing = false;
+            } else {
+                const bool on = (phase & 1) == 0;
+                outputApply(on, cur.toneHz);
+                phaseEndMs = now + (on ? cur.onMs : cur.offMs);
+            }
+        }
+        
+        if (!playing) {
+            for (size_t i = levels; i-- > 0; ) {
+                if (!waiting[i]) continue;
+                cur = pending[i];
+                waiting[i] = false;
+                playing = true;
+                phase = 0;
+                outputApply(true, cur.toneHz);
+                phaseEndMs = now + cur.onMs;
+                break;
+            }
+            if (!playing) outputApply(false, 0);
+        }
+    }
+}
+
+bool outputInit() {
+    pinMode(Config::BUZZER_PIN, OUTPUT);
+    ledcSetup(Config::BUZZER_CHANNEL, Config::BUZZER_FREQ, Config::LEDC_RESOLUTION_BITS);
+    ledcAttachPin(Config::BUZZER_PIN, Config::BUZZER_CHANNEL);
+    ledcWrite(Config::BUZZER_CHANNEL, 0);
+    Hardware::ledOff();
+    
+    outputQueue = xQueueCreate(Config::OUTPUT_QUEUE_LEN, sizeof(OutputPattern));
+    if (!outputQueue) {
+        Serial.println("[ERROR] Failed to create output queue");
+        return false;
+    }
+    return launchTask(TaskRole::SIGNAL, outputTask, nullptr);
+}
+
+// ================================
+// RAW ADVERTISEMENT RING
+// ================================
+// NimBLE callbacks only do a cheap pre-filter and copy the report into a
+// lock-free single-producer/single-consumer ring. The consumer task owns all
+// dedup, aggregation, parsing and logging. Producer: NimBLE host task only.
+// The consumer advances `tail` after it has finished with a record, so
+// head == tail means every pushed report has been fully processed.
+
+struct RawAdvert {
+    uint64_t mac48;
+    uint32_t timestampMs;
+    int8_t rssi;
+    uint8_t addrType;
+    uint8_t payloadLen;
+    uint8_t reserved;
+    uint8_t payload[Config::MAX_PAYLOAD_SIZE];
+};
+
+enum class AdvSink : uint8_t { NONE, DETECT, FOX, BASELINE };
+
+// What the scan callbacks use from a NimBLE report; the benchmark builds these
+struct AdvReport {
+    uint64_t mac48;
+    int rssi;
+    uint8_t addrType;
+    const uint8_t* payload;
+    size_t payloadLen;
+};
+
+inline AdvReport advReportFrom(NimBLEAdvertisedDevice* dev) {
+    return AdvReport{macFromNimble(dev->getAddress()), dev->getRSSI(), dev->getAddressType(),
+                     dev->getPayload(), dev->getPayloadLength()};
+}
+
+struct AdvRing {
+    RawAdvert* slots;
+    uint32_t mask;
+    std::atomic<uint32_t> head;   // producer writes
+    std::atomic<uint32_t> tail;   // consumer writes
+    volatile uint32_t pushed;     // producer-only counters
+    volatile uint32_t dropped;
+    volatile uint32_t highWater;
+    TaskHandle_t consumer;
+};
+
+static AdvRing advRing;
+static volatile AdvSink advSink = AdvSink::NONE;
+
+void detectConsumeAdvert(const RawAdvert& adv);
+void foxConsumeAdvert(const RawAdvert& adv);
+void baselineConsumeAdvert(const RawAdvert& adv);
+
+// Consumer task only. MAC/OUI index first; content rules need the payload.
+bool advertMatchesFilters(const RawAdvert& adv) {
+    if (matchesCompiledFilter(adv.mac48)) return true;
+    if (!contentRulesActive()) return false;
+    AdView ad;
+    adParse(adv.payload, adv.payloadLen, ad);
+    return matchContentRules(ad) >= 0;
+}
+
+bool advRingPush(const AdvReport& rep) {
+    if (!advRing.slots) return false;
+    
+    const uint32_t head = advRing.head.load(std::memory_order_relaxed);
+    const uint32_t depth = head - advRing.tail.load(std::memory_order_acquire);
+    if (depth > advRing.mask) {
+        advRing.dropped++;
+        metricsCount(metrics.advDropped);
+        return false;
+    }
+    
+    RawAdvert& r = advRing.slots[head & advRing.mask];
+    r.mac48 = rep.mac48;
+    r.timestampMs = millis();
+    const int rssi = rep.rssi;
+    r.rssi = (int8_t)(rssi < -128 ? -128 : (rssi > 127 ? 127 : rssi));
+    r.addrType = rep.addrType;
+    size_t len = rep.payloadLen;
+    if (len > sizeof(r.payload)) len = sizeof(r.payload);
+    r.payloadLen = (uint8_t)len;
+    if (len) memcpy(r.payload, rep.payload, len);
+    
+    advRing.head.store(head + 1, std::memory_order_release);
+    advRing.pushed++;
+    if (depth + 1 > advRing.highWater) advRing.highWater = depth + 1;
+    
+    // Wake on empty -> non-empty; the consumer's timed wait covers the rest
+    if (depth == 0 && advRing.consumer) xTaskNotifyGive(advRing.consumer);
+    return true;
+}
+
+
+void advConsumerTask(void* pv) {
+    for (;;) {
+        uint32_t tail = advRing.tail.load(std::memory_order_relaxed);
+        while (tail != advRing.head.load(std::memory_order_acquire)) {
+            const RawAdvert& adv = advRing.slots[tail & advRing.mask];
+            switch (advSink) {
+                case AdvSink::DETECT:   detectConsumeAdvert(adv); break;
+                case AdvSink::FOX:      foxConsumeAdvert(adv); break;
+                case AdvSink::BASELINE: baselineConsumeAdvert(adv); break;
+                default: break;
+            }
+            advRing.tail.store(++tail, std::memory_order_release);
+        }
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(20));
+    }
+}
+
+// Waits until every pushed report has been consumed. Returns false on timeout.
+bool advRingDrain(uint32_t timeoutMs) {
+    const uint32_t start = millis();
+    while (advRing.tail.load(std::memory_order_acquire) != advRing.head.load(std::memory_order_acquire)) {
+        if (millis() - start >= timeoutMs) return false;
+        vTaskDelay(pdMS_TO_TICKS(5));
+    }
+    return true;
+}
+
+// Call after stopping the scan: finishes pending reports, then detaches the sink
+void advRingQuiesce() {
+    if (!advRingDrain(1000)) {
+        Serial.println("[WARN] Advertisement ring drain timed out");
+    }
+    advSink = AdvSink::NONE;
+    advRingDrain(200);   // anything that slipped in is discarded by NONE
+}
+
+bool advRingInit() {
+    advRing.slots = (RawAdvert*)psramAlloc(Config::ADV_RING_SLOTS * sizeof(RawAdvert));
+    if (!advRing.slots) {
+        Serial.println("[ERROR] OOM allocating advertisement ring");
+        return false;
+    }
+    advRing.mask = Config::ADV_RING_SLOTS - 1;
+    advRing.head.store(0);
+    advRing.tail.store(0);
+    advRing.pushed = 0;
+    advRing.dropped = 0;
+    advRing.highWater = 0;
+    
+    if (!launchTask(TaskRole::ADV_CONSUMER, advConsumerTask, nullptr, &advRing.consumer)) {
+        advRing.consumer = nullptr;
+        return false;
+    }
+    return true;
+}
+
+// ================================
+// PROMISCUOUS WI-FI CAPTURE
+// ================================
+// Detect mode listens to raw 802.11 management and data frames instead of
+// polling AP scans, so clients and probing phones match as well as BSSIDs.
+// The rx callback runs in the Wi-Fi driver task: no locks, no allocation, no
+// logging. It reads addr1..addr3, checks them against the compiled index and
+// posts a small hit to a bounded queue. detectionTask owns hopping and state.
+
+struct WiFiHit {
+    uint64_t mac48;
+    uint32_t timestampMs;
+    int8_t rssi;
+    uint8_t channel;
+    uint8_t frameCtl;    // first frame-control byte (type/subtype)
+    uint8_t addrIndex;   // 1..3, header address that matched
+};
+
+struct PromiscStats {
+    volatile uint32_t frames;    // callback-only counters
+    volatile uint32_t hits;
+    volatile uint32_t dropped;
+    volatile uint32_t hops;
+};
+
+static QueueHandle_t promiscHitQueue = nullptr;
+static PromiscStats promiscStats;
+static volatile bool promiscActive = false;
+static uint64_t promiscLastMac = 0;   // callback-only repeat holdoff
+static uint32_t promiscLastMs = 0;
+
+static void onPromiscFrame(void* buf, wifi_promiscuous_pkt_type_t type) {
+    if (!promiscActive || (type != WIFI_PKT_MGMT && type != WIFI_PKT_DATA)) return;
+    
+    const wifi_promiscuous_pkt_t* pkt = (const wifi_promiscuous_pkt_t*)buf;
+    if (pkt->rx_ctrl.sig_len < 24) return;   // shorter than a 3-address header
+    promiscStats.frames++;
+    
+    // addr1 @4, addr2 @10, addr3 @16; group addresses can't be a device
+    const uint8_t* hdr = pkt->payload;
+    for (uint8_t i = 0; i < 3; i++) {
+        const uint8_t* a = hdr + 4 + i * 6;
+        if (a[0] & 0x01) continue;
+        
+        const uint64_t mac48 = macFromBytes(a);
+        if (!matchesCompiledFilter(mac48)) continue;
+        
+        const uint32_t now = millis();
+        if (mac48 == promiscLastMac && (now - promiscLastMs) < Config::PROMISC_HOLDOFF_MS) return;
+        promiscLastMac = mac48;
+        promiscLastMs = now;
+        
+        WiFiHit hit;
+        hit.mac48 = mac48;
+        hit.timestampMs = now;
+        hit.rssi = (int8_t)pkt->rx_ctrl.rssi;
+        hit.channel = (uint8_t)pkt->rx_ctrl.channel;
+        hit.frameCtl = hdr[0];
+        hit.addrIndex = i + 1;
+        
+        if (xQueueSend(promiscHitQueue, &hit, 0) == pdTRUE) {
+            promiscStats.hits++;
+        } else {
+            promiscStats.dropped++;
+        }
+        return;
+    }
+}
+
+const char* wifiFrameKind(uint8_t frameCtl) {
+    const uint8_t type = (frameCtl >> 2) & 0x03;
+    const uint8_t subtype = frameCtl >> 4;
+    if (type == 2) return "data";
+    switch (subtype) {
+        case 0x0: return "assoc-req";
+        case 0x4: return "probe-req";
+        case 0x5: return "probe-resp";
+        case 0x8: return "beacon";
+        case 0xB: return "auth";
+        case 0xC: return "deauth";
+        default:  return "mgmt";
+    }
+}
+
+// ---- Channel scheduler ----
+// Every channel is visited once per cycle. UNIFORM gives each PROMISC_DWELL_MS.
+// WEIGHTED keeps the same cycle length but splits everything above the
+// per-channel floor by decayed activity (frames/s plus a bonus per filter
+// hit). It is seeded from the AP channels of the last baseline. LOCKED stays on
+// one channel; with lockedChannel 0 it hops uniformly until the first hit,
+// then follows the channel the target was last heard on, and resumes hopping
+// once the target has been silent for DETECT_STALE_MS.
+
+enum class HopPolicy : uint8_t { UNIFORM, WEIGHTED, LOCKED };
+
+struct ChannelSlot {
+    uint32_t frames;      // totals for /channel_stats
+    uint32_t hits;
+    uint32_t dwellMs;
+    uint32_t visits;
+    float activity;       // decayed frames/s + hit bonus
+};
+
+struct ChannelScheduler {
+    HopPolicy policy;
+    uint8_t lockedChannel;      // 0 = follow target
+    uint8_t targetChannel;      // follow mode: channel of the last hit, 0 = searching
+    uint8_t current;
+    uint32_t targetSeenMs;
+    uint32_t dwellStartMs;
+    uint32_t framesAtStart;     // promiscStats snapshot at dwell start
+    uint32_t hitsAtStart;
+    ChannelSlot ch[Config::PROMISC_MAX_CHANNEL + 1];   // 1-based
+};
+
+static ChannelScheduler chanSched = {HopPolicy::UNIFORM, 0, 0, 1, 0, 0, 0, 0, {}};
+
+const char* hopPolicyName(HopPolicy p) {
+    switch (p) {
+        case HopPolicy::WEIGHTED: return "weighted";
+        case HopPolicy::LOCKED:   return "locked";
+        default:                  return "uniform";
+    }
+}
+
+HopPolicy parseHopPolicy(const String& s) {
+    if (s == "weighted") return HopPolicy::WEIGHTED;
+    if (s == "locked") return HopPolicy::LOCKED;
+    return HopPolicy::UNIFORM;
+}
+
+uint32_t channelDwellMs(uint8_t c) {
+    const ChannelScheduler& s = chanSched;
+    if (s.policy != HopPolicy::WEIGHTED) return Config::PROMISC_DWELL_MS;
+    
+    float total = 0.0f;
+    for (uint8_t i = 1; i <= Config::PROMISC_MAX_CHANNEL; i++) {
+        total += s.ch[i].activity + 1.0f;
+    }
+    const uint32_t cycle = (uint32_t)Config::PROMISC_MAX_CHANNEL * Config::PROMISC_DWELL_MS;
+    const uint32_t spare = cycle - (uint32_t)Config::PROMISC_MAX_CHANNEL * Config::PROMISC_DWELL_FLOOR_MS;
+    return Config::PROMISC_DWELL_FLOOR_MS + (uint32_t)(spare * (s.ch[c].activity + 1.0f) / total);
+}
+
+void channelSchedTune(uint8_t c, uint32_t now) {
+    ChannelScheduler& s = chanSched;
+    s.current = c;
+    s.dwellStartMs = now;
+    s.framesAtStart = promiscStats.frames;
+    s.hitsAtStart = promiscStats.hits;
+    s.ch[c].visits++;
+    esp_wifi_set_channel(c, WIFI_SECOND_CHAN_NONE);
+    promiscStats.hops++;
+}
+
+// Books the finished dwell against the current channel
+void channelSchedAccount(uint32_t now) {
+    ChannelScheduler& s = chanSched;
+    ChannelSlot& slot = s.ch[s.current];
+    const uint32_t dwell = now - s.dwellStartMs;
+    const uint32_t frames = promiscStats.frames - s.framesAtStart;
+    const uint32_t hits = promiscStats.hits - s.hitsAtStart;
+    
+    slot.frames += frames;
+    slot.hits += hits;
+    slot.dwellMs += dwell;
+    if (dwell > 0) {
+        const float sample = frames * 1000.0f / dwell + hits * Config::PROMISC_HIT_WEIGHT;
+        slot.activity += Config::PROMISC_ACTIVITY_ALPHA * (sample - slot.activity);
+    }
+    s.dwellStartMs = now;
+    s.framesAtStart += frames;
+    s.hitsAtStart += hits;
+}
+
+// Counts APs per channel in the published baseline
+void channelSchedSeedFromResults() {
+    if (!lockTake(LockId::RESULTS, resultsMutex, pdMS_TO_TICKS(200))) return;
+    uint32_t seeded = 0;
+    if (resultsTable) {
+        for (uint32_t slot : enhancedResultsRows) {
+            if (!(resultsTable->hot[slot].flags & DEV_HAS_WIFI_META)) continue;
+            const uint8_t c = resultsTable->wifi[slot].channel;
+            if (c < 1 || c > Config::PROMISC_MAX_CHANNEL) continue;
+            chanSched.ch[c].activity += Config::PROMISC_SEED_PER_AP;
+            seeded++;
+        }
+    }
+    xSemaphoreGive(resultsMutex);
+    if (seeded) Serial.printf("[CHAN] Seeded weights from %u baseline APs\n", (unsigned)seeded);
+}
+
+// Returns the first hop deadline
+uint32_t channelSchedStart(HopPolicy policy, uint8_t lockedChannel, uint32_t now) {
+    ChannelScheduler& s = chanSched;
+    s.policy = policy;
+    s.lockedChannel = lockedChannel <= Config::PROMISC_MAX_CHANNEL ? lockedChannel : 0;
+    s.targetChannel = 0;
+    memset(s.ch, 0, sizeof(s.ch));
+    if (policy == HopPolicy::WEIGHTED) channelSchedSeedFromResults();
+    
+    const uint8_t first = (policy == HopPolicy::LOCKED && s.lockedChannel) ? s.lockedChannel : 1;
+    channelSchedTune(first, now);
+    Serial.printf("[CHAN] Policy %s, start ch %u\n", hopPolicyName(policy), first);
+    return now + channelDwellMs(first);
+}
+
+// Returns the next hop deadline
+uint32_t channelSchedHop(uint32_t now) {
+    ChannelScheduler& s = chanSched;
+    channelSchedAccount(now);
+    
+    if (s.policy == HopPolicy::LOCKED) {
+        if (s.targetChannel && (now - s.targetSeenMs) > Config::DETECT_STALE_MS) {
+            Serial.printf("[CHAN] Target lost on ch %u, hopping\n", s.targetChannel);
+            s.targetChannel = 0;
+        }
+        if (s.lockedChannel || s.targetChannel) {
+            return now + Config::PROMISC_DWELL_MS;   // stay put, keep accounting
+        }
+    }
+    
+    const uint8_t next = s.current >= Config::PROMISC_MAX_CHANNEL ? 1 : s.current + 1;
+    channelSchedTune(next, now);
+    return now + channelDwellMs(next);
+}
+
+// LOCKED with lockedChannel 0: follow the target to the channel it was heard on
+void channelSchedOnHit(const WiFiHit& hit, uint32_t now) {
+    ChannelScheduler& s = chanSched;
+    if (s.policy != HopPolicy::LOCKED || s.lockedChannel) return;
+    if (hit.channel < 1 || hit.channel > Config::PROMISC_MAX_CHANNEL) return;
+    s.targetChannel = hit.channel;
+    s.targetSeenMs = now;
+    if (hit.channel == s.current) return;
+    channelSchedAccount(now);
+    channelSchedTune(hit.channel, now);
+    Serial.printf("[CHAN] Locked on target channel %u\n", hit.channel);
+}
+
+String renderChannelStatsJson() {
+    const ChannelScheduler& s = chanSched;
+    String json;
+    json.reserve(160 + Config::PROMISC_MAX_CHANNEL * 96);
+    json += "{\"policy\":\"";
+    json += hopPolicyName(s.policy);
+    json += "\",\"locked_channel\":" + String(s.lockedChannel);
+    json += ",\"target_channel\":" + String(s.targetChannel);
+    json += ",\"current\":" + String(s.current);
+    json += ",\"active\":";
+    json += promiscActive ? "true" : "false";
+    json += ",\"hops\":" + String(promiscStats.hops);
+    json += ",\"channels\":[";
+    for (uint8_t c = 1; c <= Config::PROMISC_MAX_CHANNEL; c++) {
+        const ChannelSlot& slot = s.ch[c];
+        if (c > 1) json += ",";
+        json += "{\"ch\":" + String(c);
+        json += ",\"dwell_ms\":" + String(slot.dwellMs);
+        json += ",\"visits\":" + String(slot.visits);
+        json += ",\"frames\":" + String(slot.frames);
+        json += ",\"hits\":" + String(slot.hits);
+        json += ",\"activity\":" + String(slot.activity, 1);
+        json += ",\"next_dwell_ms\":" + String(channelDwellMs(c));
+        json += "}";
+    }
+    json += "]}";
+    return json;
+}
+
+// Wi-Fi must already be started in STA mode and not associated
+// Filter, callback and enable; also re-applied after a power-plan gap
+esp_err_t promiscArm() {
+    wifi_promiscuous_filter_t filt;
+    filt.filter_mask = WIFI_PROMIS_FILTER_MASK_MGMT | WIFI_PROMIS_FILTER_MASK_DATA;
+    esp_wifi_set_promiscuous_filter(&filt);
+    esp_wifi_set_promiscuous_rx_cb(&onPromiscFrame);
+    return esp_wifi_set_promiscuous(true);
+}
+
+bool promiscStart() {
+    if (!promiscHitQueue) {
+        promiscHitQueue = xQueueCreate(Config::PROMISC_HIT_QUEUE_LEN, sizeof(WiFiHit));
+        if (!promiscHitQueue) {
+            Serial.println("[ERROR] Failed to create promiscuous hit queue");
+            return false;
+        }
+    }
+    xQueueReset(promiscHitQueue);
+    memset((void*)&promiscStats, 0, sizeof(promiscStats));
+    promiscLastMac = 0;
+    
+    promiscActive = true;
+    esp_err_t err = promiscArm();
+    if (err != ESP_OK) {
+        promiscActive = false;
+        Serial.printf("[ERROR] Promiscuous mode failed: %d\n", (int)err);
+        return false;
+    }
+    return true;
+}
+
+void promiscStop() {
+    if (!promiscActive) return;
+    promiscActive = false;
+    esp_wifi_set_promiscuous(false);
+    esp_wifi_set_promiscuous_rx_cb(nullptr);
+}
+
+// ================================
+// BLE SCAN PROFILES
+// ================================
+// Named interval/window/active combinations, picked per run. Every NimBLE
+// callback feeds the meter before any filtering, so the numbers reflect
+// what the radio hears under that profile. Distinct MACs per meter window are
+// estimated with linear counting on a bitmap, so no per-device memory.
+// Producer: NimBLE host task. Windows are folded by the mode's own task.
+
+struct ScanProfileSpec {
+    const char* key;
+    const char* label;
+    uint16_t intervalMs;
+    uint16_t windowMs;
+    bool active;             // send scan requests for scan-response data
+};
+
+static const ScanProfileSpec SCAN_PROFILES[(size_t)ScanProfile::COUNT] = {
+    {"passive",  "Passive low-power",      200, 20, false},   // 10% duty
+    {"balanced", "Balanced",                45, 15, false},   // 33% duty
+    {"max",      "Max capture",             16, 16, false},   // continuous
+    {"active",   "Active + scan response",  45, 15, true},    // 33% duty, names
+};
+
+struct ScanProfileStats {
+    uint32_t runs;
+    uint32_t totalMs;        // metered time
+    uint32_t adverts;
+    uint32_t uniques;        // sum of per-window distinct estimates
+};
+
+struct ScanMeter {
+    static const uint32_t BITMAP_BITS = 8192;
+    
+    volatile bool active;
+    ScanProfile profile;
+    uint32_t windowStartMs;
+    uint32_t lastSaveMs;
+    volatile uint32_t adverts;           // producer-only
+    uint32_t advertsAtWindow;
+    volatile uint8_t fill;               // bitmap the producer writes
+    uint32_t bitmap[2][BITMAP_BITS / 32];
+};
+
+static ScanMeter scanMeter;
+static ScanProfileStats scanProfileStats[(size_t)ScanProfile::COUNT];
+
+const ScanProfileSpec& scanProfileSpec(ScanProfile p) {
+    return SCAN_PROFILES[(size_t)p < (size_t)ScanProfile::COUNT ? (size_t)p : (size_t)ScanProfile::BALANCED];
+}
+
+ScanProfile parseScanProfile(const String& s, ScanProfile fallback) {
+    for (size_t i = 0; i < (size_t)ScanProfile::COUNT; i++) {
+        if (s == SCAN_PROFILES[i].key) return (ScanProfile)i;
+    }
+    return fallback;
+}
+
+void applyScanProfile(NimBLEScan* scan, ScanProfile p) {
+    const ScanProfileSpec& spec = scanProfileSpec(p);
+    scan->setActiveScan(spec.active);
+    scan->setInterval(spec.intervalMs);
+    scan->setWindow(spec.windowMs);
+    Serial.printf("[SCAN] Profile %s: %u/%u ms, %s\n", spec.key, spec.intervalMs, spec.windowMs,
+                  spec.active ? "active" : "passive");
+}
+
+void loadScanProfileStats() {
+    if (!prefs.begin(Config::SCAN_STATS_NAMESPACE, true)) return;
+    if (prefs.getBytesLength("stats") == sizeof(scanProfileStats)) {
+        prefs.getBytes("stats", scanProfileStats, sizeof(scanProfileStats));
+    }
+    prefs.end();
+}
+
+void saveScanProfileStats() {
+    if (!prefs.begin(Config::SCAN_STATS_NAMESPACE, false)) {
+        Serial.println("[ERROR] Failed to open scan stats prefs");
+        return;
+    }
+    prefs.putBytes("stats", scanProfileStats, sizeof(scanProfileStats));
+    prefs.end();
+}
+
+inline void scanMeterCount(uint64_t mac48) {
+    if (!scanMeter.active) return;
+    scanMeter.adverts++;
+    const uint32_t bit = (uint32_t)((mac48 * 0x9E3779B97F4A7C15ULL) >> 51);   // 13 bits
+    scanMeter.bitmap[scanMeter.fill][bit >> 5] |= 1u << (bit & 31);
+}
+
+// Linear counting: n ~= -m * ln(zeroBits / m)
+uint32_t bitmapDistinct(const uint32_t* words) {
+    uint32_t set = 0;
+    for (uint32_t i = 0; i < ScanMeter::BITMAP_BITS / 32; i++) set += __builtin_popcount(words[i]);
+    const uint32_t zeros = ScanMeter::BITMAP_BITS - set;
+    if (zeros == 0) return ScanMeter::BITMAP_BITS;   // saturated, lower bound
+    return (uint32_t)lroundf(-(float)ScanMeter::BITMAP_BITS * logf((float)zeros / ScanMeter::BITMAP_BITS));
+}
+
+void scanMeterBegin(ScanProfile p) {
+    memset(scanMeter.bitmap, 0, sizeof(scanMeter.bitmap));
+    scanMeter.profile = p;
+    scanMeter.fill = 0;
+    scanMeter.adverts = 0;
+    scanMeter.advertsAtWindow = 0;
+    scanMeter.windowStartMs = millis();
+    scanMeter.lastSaveMs = scanMeter.windowStartMs;
+    scanProfileStats[(size_t)p].runs++;
+    scanMeter.active = true;
+}
+
+// Folds the current window into the profile totals and starts a new one
+void scanMeterFold(uint32_t now) {
+    const uint8_t done = scanMeter.fill;
+    scanMeter.fill = done ^ 1;
+    
+    const uint32_t adverts = scanMeter.adverts;
+    ScanProfileStats& st = scanProfileStats[(size_t)scanMeter.profile];
+    st.totalMs += now - scanMeter.windowStartMs;
+    st.adverts += adverts - scanMeter.advertsAtWindow;
+    st.uniques += bitmapDistinct(scanMeter.bitmap[done]);
+    memset(scanMeter.bitmap[done], 0, sizeof(scanMeter.bitmap[done]));
+    
+    scanMeter.advertsAtWindow = adverts;
+    scanMeter.windowStartMs = now;
+}
+
+// Call from the mode's loop; folds every SCAN_METER_WINDOW_MS, persists less often
+void scanMeterTick(uint32_t now) {
+    if (!scanMeter.active || now - scanMeter.windowStartMs < Config::SCAN_METER_WINDOW_MS) return;
+    scanMeterFold(now);
+    
+    const ScanProfileStats& st = scanProfileStats[(size_t)scanMeter.profile];
+    Serial.printf("[SCAN] %s: %.1f adv/s, %.2f unique/s over %us\n", scanProfileSpec(scanMeter.profile).key,
+                  st.totalMs ? st.adverts * 1000.0f / st.totalMs : 0.0f,
+                  st.totalMs ? st.uniques * 1000.0f / st.totalMs : 0.0f, (unsigned)(st.totalMs / 1000));
+    if (now - scanMeter.lastSaveMs >= Config::SCAN_STATS_SAVE_MS) {
+        scanMeter.lastSaveMs = now;
+        saveScanProfileStats();
+    }
+}
+
+// Call after the scan has stopped
+void scanMeterEnd() {
+    if (!scanMeter.active) return;
+    scanMeterFold(millis());
+    scanMeter.active = false;
+    saveScanProfileStats();
+}
+
+String renderScanProfilesJson() {
+    String json;
+    json.reserve(256 + (size_t)ScanProfile::COUNT * 200);
+    json += "{\"current\":";
+    if (scanMeter.active) {
+        const uint32_t elapsed = millis() - scanMeter.windowStartMs;
+        const uint32_t adverts = scanMeter.adverts - scanMeter.advertsAtWindow;
+        json += "{\"profile\":\"";
+        json += scanProfileSpec(scanMeter.profile).key;
+        json += "\",\"window_ms\":" + String(elapsed);
+        json += ",\"adverts\":" + String(adverts);
+        json += ",\"adv_per_s\":" + String(elapsed ? adverts * 1000.0f / elapsed : 0.0f, 1);
+        json += ",\"unique\":" + String(bitmapDistinct(scanMeter.bitmap[scanMeter.fill]));
+        json += "}";
+    } else {
+        json += "null";
+    }
+    json += ",\"profiles\":[";
+    for (size_t i = 0; i < (size_t)ScanProfile::COUNT; i++) {
+        const ScanProfileSpec& spec = SCAN_PROFILES[i];
+        const ScanProfileStats& st = scanProfileStats[i];
+        if (i) json += ",";
+        json += "{\"key\":\"";
+        json += spec.key;
+        json += "\",\"label\":\"";
+        json += spec.label;
+        json += "\",\"interval_ms\":" + String(spec.intervalMs);
+        json += ",\"window_ms\":" + String(spec.windowMs);
+        json += ",\"duty_pct\":" + String(spec.windowMs * 100 / spec.intervalMs);
+        json += ",\"active\":";
+        json += spec.active ? "true" : "false";
+        json += ",\"runs\":" + String(st.runs);
+        json += ",\"seconds\":" + String(st.totalMs / 1000);
+        json += ",\"adverts\":" + String(st.adverts);
+        json += ",\"adv_per_s\":" + String(st.totalMs ? st.adverts * 1000.0f / st.totalMs : 0.0f, 1);
+        json += ",\"unique_per_s\":" + String(st.totalMs ? st.uniques * 1000.0f / st.totalMs : 0.0f, 2);
+        json += "}";
+    }
+    json += "]}";
+    return json;
+}
+
+// ================================
+// POWER PLAN (battery detect runs)
+// ================================
+// Optional per detect run. Scanning runs in bursts of POWER_BURST_MS; after
+// each quiet burst the gap before the next one doubles, up to the run's
+// latency budget. A hit (target present) keeps the radios on for
+// POWER_HOLD_MS and resets the gap. During gaps BLE scanning and Wi-Fi are
+// stopped and the detect task sleeps; with ESP-IDF power management the CPU
+// scales down (and light-sleeps when the SDK has tickless idle), otherwise
+// it runs at a fixed POWER_STATIC_MHZ for the whole run.
+// Owned by the detect task; loop() only bumps the wakeup counter.
+
+struct PowerPlan {
+    volatile bool active;
+    bool dfs;                    // esp_pm configured
+    bool lightSleep;             // ... with automatic light sleep
+    bool radiosOn;
+    uint32_t cpuMhz;             // frequency to restore
+    uint32_t latencyMs;          // longest gap
+    uint32_t gapMs;              // next gap
+    uint32_t startMs;
+    uint32_t endMs;              // 0 = running
+    uint32_t phaseMs;            // current burst or gap began
+    uint32_t holdUntilMs;
+    uint32_t radioOnMs;          // completed bursts
+    uint32_t bursts;
+    uint32_t lastReportMs;
+    uint16_t bleWindowMs;        // profile duty, for the estimate
+    uint16_t bleIntervalMs;
+    volatile uint32_t wakeups;   // detect task + loop() iterations
+    uint32_t advertsAtStart;
+    uint32_t framesAtStart;
+};
+
+static PowerPlan powerPlan;
+
+// Radios-on time so far, including the burst in progress
+uint32_t powerRadioOnMs(uint32_t now) {
+    const PowerPlan& pp = powerPlan;
+    return pp.radioOnMs + (pp.radiosOn ? (pp.endMs ? pp.endMs : now) - pp.phaseMs : 0);
+}
+
+uint32_t powerElapsedMs(uint32_t now) {
+    return (powerPlan.endMs ? powerPlan.endMs : now) - powerPlan.startMs;
+}
+
+// Estimated wakeups: our own task loops plus one per BLE advert and per
+// promiscuous frame (each one wakes the host task or the Wi-Fi callback)
+float powerWakeupsPerSec(uint32_t now) {
+    const uint32_t ms = powerElapsedMs(now);
+    if (!ms) return 0.0f;
+    const uint32_t events = powerPlan.wakeups +
+                            (metrics.advReceived.load(std::memory_order_relaxed) - powerPlan.advertsAtStart) +
+                            (promiscStats.frames - powerPlan.framesAtStart);
+    return events * 1000.0f / ms;
+}
+
+void powerPlanReport(uint32_t now) {
+    const uint32_t ms = powerElapsedMs(now);
+    const float onPct = ms ? powerRadioOnMs(now) * 100.0f / ms : 0.0f;
+    Serial.printf("[POWER] %u s: radios on %.1f%% (BLE duty %.1f%%), %.1f wakeups/s, %u bursts, gap %u ms, "
+                  "cpu %u MHz%s%s\n",
+                  (unsigned)(ms / 1000), onPct, onPct * powerPlan.bleWindowMs / powerPlan.bleIntervalMs,
+                  powerWakeupsPerSec(now), (unsigned)powerPlan.bursts, (unsigned)powerPlan.gapMs,
+                  (unsigned)getCpuFrequencyMhz(), powerPlan.dfs ? " (DFS)" : "",
+                  powerPlan.lightSleep ? " (light sleep)" : "");
+}
+
+void powerRadios(bool on, NimBLEScan* ble, bool wifi) {
+    if (wifi) {
+        if (on) {
+            esp_wifi_start();
+            if (promiscActive) promiscArm();
+        } else {
+            esp_wifi_set_promiscuous(false);
+            esp_wifi_stop();
+        }
+    }
+    if (ble) {
+        if (on) {
+            ble->start(0, nullptr, false);
+        } else {
+            ble->stop();
+        }
+    }
+}
+
+// Call once scanning is up
+void powerPlanBegin(uint32_t latencyMs, ScanProfile profile, uint32_t now) {
+    PowerPlan& pp = powerPlan;
+    memset((void*)&pp, 0, sizeof(pp));
+    pp.cpuMhz = getCpuFrequencyMhz();
+    pp.latencyMs = latencyMs;
+    pp.gapMs = Config::POWER_GAP_MIN_MS;
+    pp.startMs = now;
+    pp.phaseMs = now;
+    pp.lastReportMs = now;
+    pp.radiosOn = true;
+    pp.bleWindowMs = scanProfileSpec(profile).windowMs;
+    pp.bleIntervalMs = scanProfileSpec(profile).intervalMs;
+    pp.advertsAtStart = metrics.advReceived.load(std::memory_order_relaxed);
+    pp.framesAtStart = promiscStats.frames;
+    
+#if CONFIG_PM_ENABLE
+    esp_pm_config_esp32s3_t pm;
+    pm.max_freq_mhz = Config::POWER_MAX_MHZ;
+    pm.min_freq_mhz = Config::POWER_MIN_MHZ;
+    pm.light_sleep_enable = true;
+    esp_err_t err = esp_pm_configure(&pm);
+    if (err != ESP_OK) {
+        pm.light_sleep_enable = false;
+        err = esp_pm_configure(&pm);
+    }
+    pp.dfs = err == ESP_OK;
+    pp.lightSleep = pp.dfs && pm.light_sleep_enable;
+#endif
+    if (!pp.dfs) setCpuFrequencyMhz(Config::POWER_STATIC_MHZ);
+    
+    pp.active = true;
+    Serial.printf("[POWER] Plan on: bursts %u ms, gaps up to %u ms, %s\n",
+                  (unsigned)Config::POWER_BURST_MS, (unsigned)latencyMs,
+                  pp.lightSleep ? "DFS + light sleep" : pp.dfs ? "DFS" : "fixed clock");
+}
+
+// Extends continuous scanning while the target is present
+void powerPlanOnHit(uint32_t now) {
+    powerPlan.holdUntilMs = now + Config::POWER_HOLD_MS;
+    powerPlan.gapMs = Config::POWER_GAP_MIN_MS;
+}
+
+// Advances bursts and gaps. Returns how long the task should sleep, 0 =
+// radios are on and the caller runs its normal iteration.
+uint32_t powerPlanTick(uint32_t now, NimBLEScan* ble, bool wifi) {
+    PowerPlan& pp = powerPlan;
+    if (now - pp.lastReportMs >= Config::POWER_REPORT_MS) {
+        pp.lastReportMs = now;
+        powerPlanReport(now);
+    }
+    
+    if (pp.radiosOn) {
+        const bool holding = (int32_t)(pp.holdUntilMs - now) > 0;
+        if (holding || now - pp.phaseMs < Config::POWER_BURST_MS) return 0;
+        powerRadios(false, ble, wifi);
+        pp.radiosOn = false;
+        pp.radioOnMs += now - pp.phaseMs;
+        pp.phaseMs = now;
+        return pp.gapMs < Config::POWER_SLEEP_SLICE_MS ? pp.gapMs : Config::POWER_SLEEP_SLICE_MS;
+    }
+    
+    const uint32_t inGap = now - pp.phaseMs;
+    if (inGap < pp.gapMs) {
+        const uint32_t left = pp.gapMs - inGap;
+        return left < Config::POWER_SLEEP_SLICE_MS ? left : Config::POWER_SLEEP_SLICE_MS;
+    }
+    
+    // Quiet so far: back off before the burst that follows this one
+    pp.gapMs = pp.gapMs * 2 < pp.latencyMs ? pp.gapMs * 2 : pp.latencyMs;
+    powerRadios(true, ble, wifi);
+    pp.radiosOn = true;
+    pp.phaseMs = now;
+    pp.bursts++;
+    return 0;
+}
+
+// Radios back on (the AP restore expects Wi-Fi started) and the clock restored
+void powerPlanEnd(NimBLEScan* ble, bool wifi) {
+    PowerPlan& pp = powerPlan;
+    if (!pp.active) return;
+    const uint32_t now = millis();
+    if (!pp.radiosOn) {
+        powerRadios(true, ble, wifi);
+        pp.radiosOn = true;
+        pp.phaseMs = now;
+    }
+    pp.endMs = now;
+    pp.active = false;
+    
+#if CONFIG_PM_ENABLE
+    if (pp.dfs) {
+        esp_pm_config_esp32s3_t pm;
+        pm.max_freq_mhz = (int)pp.cpuMhz;
+        pm.min_freq_mhz = (int)pp.cpuMhz;
+        pm.light_sleep_enable = false;
+        esp_pm_configure(&pm);
+    }
+#endif
+    if (!pp.dfs) setCpuFrequencyMhz(pp.cpuMhz);
+    powerPlanReport(now);
+}
+
+void appendPowerPlanJson(String& json) {
+    const uint32_t now = millis();
+    const PowerPlan& pp = powerPlan;
+    const uint32_t ms = powerElapsedMs(now);
+    const float onPct = (pp.startMs && ms) ? powerRadioOnMs(now) * 100.0f / ms : 0.0f;
+    json += "{\"active\":";
+    json += pp.active ? "true" : "false";
+    json += ",\"latency_ms\":" + String(pp.latencyMs);
+    json += ",\"seconds\":" + String(pp.startMs ? ms / 1000 : 0);
+    json += ",\"radio_on_pct\":" + String(onPct, 1);
+    json += ",\"ble_duty_pct\":" + String(pp.bleIntervalMs ? onPct * pp.bleWindowMs / pp.bleIntervalMs : 0.0f, 1);
+    json += ",\"wakeups_per_s\":" + String(pp.startMs ? powerWakeupsPerSec(now) : 0.0f, 1);
+    json += ",\"bursts\":" + String(pp.bursts);
+    json += ",\"gap_ms\":" + String(pp.gapMs);
+    json += ",\"dfs\":";
+    json += pp.dfs ? "true" : "false";
+    json += ",\"light_sleep\":";
+    json += pp.lightSleep ? "true" : "false";
+    json += "}";
+}
+
+// ================================
+// MODE SUPERVISOR
+// ================================
+// Detect and hunt drop the AP. Every mode task polls modeShouldRun(), tears
+// down only its scan on the way out (the NimBLE stack stays initialized, so
+// the next mode skips the host/controller bring-up) and brings the AP back.
+// The BOOT button stops the running mode, or resumes the last detect/hunt
+// when idle; an optional run time returns to the AP on its own. Switches are
+// timed from request to scan-ready and from stop request to AP-up.
+
+struct DetectParams {
+    DetectionMode mode;
+    bool stealth;
+    HopPolicy hopPolicy;
+    uint8_t lockChannel;   // LOCKED: 0 = follow target
+    ScanProfile bleProfile;
+    uint32_t runSecs;      // 0 = until stopped
+    uint16_t latencySecs;  // power plan: longest scan gap, 0 = scan continuously
+};
+
+struct FoxParams {
+    DetectionMode mode;
+    bool stealth;
+    float filterQ;
+    float filterR;
+    uint64_t focusMac;   // 0 = auto
+    ScanProfile bleProfile;
+    uint32_t runSecs;    // 0 = until stopped
+};
+
+struct ModeSupervisor {
+    volatile bool stopRequested;
+    TaskHandle_t task;           // running detect/hunt task
+    RunMode lastMode;            // what the button resumes
+    DetectParams lastDetect;
+    FoxParams lastFox;
+    uint32_t startReqMs;
+    uint32_t stopReqMs;
+    uint32_t runUntilMs;         // 0 = no timed return
+    uint32_t modeSinceMs;
+    uint32_t startLatencyMs;     // request -> scanning
+    uint32_t stopLatencyMs;      // stop request -> AP up
+    uint32_t switches;
+    uint32_t bleInits;
+    uint32_t bleInitMs;          // last NimBLE bring-up
+    bool buttonDown;             // loop() only
+    uint32_t buttonChangeMs;
+};
+
+static ModeSupervisor modeSup;
+
+const char* runModeName(RunMode m) {
+    switch (m) {
+        case RunMode::DETECT:  return "detect";
+        case RunMode::FOXHUNT: return "hunt";
+        default:               return "stopped";
+    }
+}
+
+// Brings NimBLE up on first use and leaves it up across modes
+bool bleStackUp() {
+    if (NimBLEDevice::getInitialized()) return true;
+    const uint32_t t0 = millis();
+    NimBLEDevice::init("");
+    modeSup.bleInits++;
+    modeSup.bleInitMs = millis() - t0;
+    Serial.printf("[BLE] Stack up in %u ms\n", (unsigned)modeSup.bleInitMs);
+    return NimBLEDevice::getInitialized();
+}
+
+// Stops the scan and drains the ring; the stack itself stays initialized
+void bleScanHalt() {
+    if (!NimBLEDevice::getInitialized()) return;
+    NimBLEScan* scan = NimBLEDevice::getScan();
+    if (scan) {
+        scan->stop();
+        scan->setAdvertisedDeviceCallbacks(nullptr, false);
+    }
+    scanMeterEnd();
+    advRingQuiesce();
+    advSink = AdvSink::NONE;
+}
+
+void dropWiFiAP(wifi_mode_t next) {
+    WiFi.softAPdisconnect(true);
+    WiFi.mode(next);
+    vTaskDelay(pdMS_TO_TICKS(Config::WIFI_MODE_CHANGE_DELAY_MS));
+}
+
+bool restoreWiFiAP() {
+    WiFi.mode(WIFI_AP);
+    const bool ok = WiFi.softAP(Config::AP_SSID, Config::AP_PASS);
+    Serial.printf("[AP] %s, IP=%s\n", ok ? "started" : "FAILED",
+                  WiFi.softAPIP().toString().c_str());
+    return ok;
+}
+
+bool modeBusy() {
+    return runMode != RunMode::STOPPED || modeSup.task != nullptr || baselineRunning || benchRunning;
+}
+
+inline bool modeShouldRun(uint32_t now) {
+    return !modeSup.stopRequested &&
+           (!modeSup.runUntilMs || (int32_t)(now - modeSup.runUntilMs) < 0);
+}
+
+// Called by the mode task once it is scanning
+void modeReady() {
+    modeSup.modeSinceMs = millis();
+    modeSup.startLatencyMs = modeSup.modeSinceMs - modeSup.startReqMs;
+    Serial.printf("[MODE] %s ready in %u ms\n", runModeName(runMode), (unsigned)modeSup.startLatencyMs);
+}
+
+// Called by the mode task after its scan is torn down; does not return
+void modeExit() {
+    modeSup.task = nullptr;
+    const RunMode was = runMode;
+    const bool timed = !modeSup.stopRequested;
+    if (timed) modeSup.stopReqMs = millis();
+    restoreWiFiAP();
+    
+    modeSup.stopLatencyMs = millis() - modeSup.stopReqMs;
+    modeSup.switches++;
+    modeSup.runUntilMs = 0;
+    modeSup.stopRequested = false;
+    stealthMode = false;
+    runMode = RunMode::STOPPED;
+    Serial.printf("[MODE] %s stopped (%s), AP up in %u ms\n", runModeName(was),
+                  timed ? "run time over" : "requested", (unsigned)modeSup.stopLatencyMs);
+    vTaskDelete(nullptr);
+}
+
+bool modeRequestStop(const char* why) {
+    if (benchRunning) {
+        benchStopRequested = true;
+        Serial.printf("[MODE] Benchmark stop (%s)\n", why);
+        return true;
+    }
+    if (baselineRunning) {
+        baselineStopRequested = true;
+        Serial.printf("[MODE] Baseline stop (%s)\n", why);
+        return true;
+    }
+    const TaskHandle_t task = modeSup.task;
+    if (!task) return false;
+    if (!modeSup.stopRequested) {
+        modeSup.stopReqMs = millis();
+        modeSup.stopRequested = true;
+        Serial.printf("[MODE] Stop %s (%s)\n", runModeName(runMode), why);
+    }
+    xTaskNotifyGive(task);   // the hunt task sleeps on its notification
+    return true;
+}
+
+void modeArm(RunMode m, uint32_t runSecs) {
+    modeSup.startReqMs = millis();
+    modeSup.stopRequested = false;
+    modeSup.runUntilMs = runSecs ? modeSup.startReqMs + runSecs * 1000UL : 0;
+    modeSup.lastMode = m;
+    runMode = m;
+}
+
+bool modeStartDetect(const DetectParams& p) {
+    if (modeBusy()) return false;
+    modeArm(RunMode::DETECT, p.runSecs);
+    modeSup.lastDetect = p;
+    DetectParams* dp = new DetectParams(p);
+    if (!launchTask(TaskRole::DETECT, detectionTask, dp, &modeSup.task)) {
+        delete dp;
+        runMode = RunMode::STOPPED;
+        return false;
+    }
+    return true;
+}
+
+bool modeStartFox(const FoxParams& p) {
+    if (modeBusy()) return false;
+    modeArm(RunMode::FOXHUNT, p.runSecs);
+    modeSup.lastFox = p;
+    FoxParams* fp = new FoxParams(p);
+    if (!launchTask(TaskRole::FOX, foxHuntTask, fp, &modeSup.task)) {
+        delete fp;
+        runMode = RunMode::STOPPED;
+        return false;
+    }
+    return true;
+}
+
+// loop() only. Press = stop the running mode, or resume the last one.
+void modeButtonPoll(uint32_t now) {
+    const bool down = digitalRead(Config::BUTTON_PIN) == LOW;
+    if (down == modeSup.buttonDown) {
+        modeSup.buttonChangeMs = now;
+        return;
+    }
+    if (now - modeSup.buttonChangeMs < Config::BUTTON_DEBOUNCE_MS) return;
+    modeSup.buttonDown = down;
+    modeSup.buttonChangeMs = now;
+    if (!down) return;
+    
+    if (modeRequestStop("button")) return;
+    if (modeSup.lastMode == RunMode::DETECT) {
+        modeStartDetect(modeSup.lastDetect);
+    } else if (modeSup.lastMode == RunMode::FOXHUNT) {
+        modeStartFox(modeSup.lastFox);
+    }
+}
+
+String renderModeStatusJson() {
+    const uint32_t now = millis();
+    String json = "{\"mode\":\"";
+    json += baselineRunning ? "baseline" : runModeName(runMode);
+    json += "\",\"running_ms\":" + String(runMode != RunMode::STOPPED && modeSup.modeSinceMs ? now - modeSup.modeSinceMs : 0);
+    json += ",\"returns_in_ms\":" + String(modeSup.runUntilMs ? (int32_t)(modeSup.runUntilMs - now) : 0);
+    json += ",\"resume\":\"" + String(runModeName(modeSup.lastMode)) + "\"";
+    json += ",\"switches\":" + String(modeSup.switches);
+    json += ",\"last_start_ms\":" + String(modeSup.startLatencyMs);
+    json += ",\"last_stop_ms\":" + String(modeSup.stopLatencyMs);
+    json += ",\"ble_up\":" + String(NimBLEDevice::getInitialized() ? "true" : "false");
+    json += ",\"ble_inits\":" + String(modeSup.bleInits);
+    json += ",\"ble_init_ms\":" + String(modeSup.bleInitMs);
+    json += ",\"power\":";
+    appendPowerPlanJson(json);
+    json += "}";
+    return json;
+}
+
+// ================================
+// DETECTION MODE
+// (keeping existing detection code unchanged)
+// ================================
+
+// onResult past the mode gate; the benchmark calls it directly
+void detectOnReport(const AdvReport& rep) {
+    ScopedLatency lat(metrics.onResultUs);
+    metricsCount(metrics.advReceived);
+    
+    scanMeterCount(rep.mac48);
+    if (!matchesCompiledFilter(rep.mac48) && !contentRulesActive()) return;
+    advRingPush(rep);
+}
+
+class DetectBLECallbacks : public NimBLEAdvertisedDeviceCallbacks {
+public:
+    void onResult(NimBLEAdvertisedDevice* dev) override {
+        if (!detectState.running || runMode != RunMode::DETECT) return;
+        detectOnReport(advReportFrom(dev));
+    }
+};
+
+void detectRecordHit(int rssi, uint32_t now) {
+    if (lockTake(LockId::DETECT, detectMutex, pdMS_TO_TICKS(50))) {
+        detectState.lastSeenMs = now;
+        detectState.lastRssi = (int16_t)rssi;
+        
+        if (rssi > detectState.bestRssi) {
+            detectState.bestRssi = (int16_t)rssi;
+        }
+        
+        if (now - detectState.lastHitMs >= Config::DETECT_DEBOUNCE_MS) {
+            detectState.lastHitMs = now;
+            detectState.hitPending = true;
+        }
+        
+        xSemaphoreGive(detectMutex);
+    } else {
+        metricsCount(metrics.advDropped);
+    }
+}
+
+void detectConsumeAdvert(const RawAdvert& adv) {
+    if (!advertMatchesFilters(adv)) return;
+    metricsCount(metrics.advMatched);
+    detectRecordHit(adv.rssi, adv.timestampMs);
+}
+
+static DetectBLECallbacks detectBleCb;
+
+void cleanupDetection() {
+    Serial.println("[DETECT] Cleaning up...");
+    
+    promiscStop();
+    bleScanHalt();
+    
+    if (lockTake(LockId::DETECT, detectMutex, pdMS_TO_TICKS(1000))) {
+        detectState.reset();
+        xSemaphoreGive(detectMutex);
+    }
+}
+
+void detectionTask(void* pv) {
+    DetectParams* pParams = (DetectParams*)pv;
+    DetectParams params = *pParams;
+    delete pParams;
+    
+    stealthMode = params.stealth;
+    
+    if (lockTake(LockId::DETECT, detectMutex, pdMS_TO_TICKS(1000))) {
+        detectState.reset();
+        detectState.running = true;
+        xSemaphoreGive(detectMutex);
+    }
+    
+    Serial.printf("[DETECT] Starting, mode=%d (0=WiFi,1=BLE,2=Both)\n", (int)params.mode);
+    
+    const bool wifiDetect = params.mode == DetectionMode::WIFI_ONLY || params.mode == DetectionMode::WIFI_AND_BLE;
+    dropWiFiAP(wifiDetect ? WIFI_STA : WIFI_OFF);
+    
+    NimBLEScan* bleScan = nullptr;
+    
+    if (params.mode == DetectionMode::BLE_ONLY || params.mode == DetectionMode::WIFI_AND_BLE) {
+        bleScan = bleStackUp() ? NimBLEDevice::getScan() : nullptr;
+        if (!bleScan) {
+            Serial.println("[ERROR] Failed to get BLE scan object");
+            cleanupDetection();
+            modeExit();
+            return;
+        }
+        
+        advSink = AdvSink::DETECT;
+        bleScan->setAdvertisedDeviceCallbacks(&detectBleCb, false);
+        applyScanProfile(bleScan, params.bleProfile);
+        bleScan->setDuplicateFilter(false);
+        bleScan->setMaxResults(0);
+        
+        if (!bleScan->start(0, nullptr, false)) {
+            Serial.println("[ERROR] BLE scan start failed");
+            cleanupDetection();
+            modeExit();
+            return;
+        }
+        
+        scanMeterBegin(params.bleProfile);
+        Serial.println("[DETECT] BLE scan active");
+    }
+    
+    if (wifiDetect) {
+        WiFi.disconnect(false, true);
+        if (!promiscStart()) {
+            cleanupDetection();
+            modeExit();
+            return;
+        }
+        Serial.println("[DETECT] Wi-Fi promiscuous capture active");
+    }
+    
+    uint32_t nextHopMs = wifiDetect ? channelSchedStart(params.hopPolicy, params.lockChannel, millis()) : 0;
+    uint32_t lastWiFiLogMs = 0;
+    uint32_t lastDetectSignalMs = 0;
+    if (params.latencySecs) powerPlanBegin((uint32_t)params.latencySecs * 1000, params.bleProfile, millis());
+    modeReady();
+    
+    while (modeShouldRun(millis())) {
+        esp_task_wdt_reset();
+        
+        if (powerPlan.active) {
+            powerPlan.wakeups++;
+            const uint32_t sleepMs = powerPlanTick(millis(), bleScan, wifiDetect);
+            if (sleepMs) {
+                vTaskDelay(pdMS_TO_TICKS(sleepMs));
+                continue;
+            }
+        }
+        
+        bool anyMatch = false;
+        
+        if (wifiDetect) {
+            // Block on the hit queue until the next hop, so a match is handled
+            // as soon as the driver posts it
+            uint32_t now = millis();
+            int32_t waitMs = (int32_t)(nextHopMs - now);
+            if (waitMs > 80) waitMs = 80;
+            if (waitMs < 0) waitMs = 0;
+            
+            WiFiHit hit;
+            if (xQueueReceive(promiscHitQueue, &hit, pdMS_TO_TICKS(waitMs)) == pdTRUE) {
+                do {
+                    detectRecordHit(hit.rssi, hit.timestampMs);
+                    channelSchedOnHit(hit, millis());
+                    anyMatch = true;
+                    
+                    if (hit.timestampMs - lastWiFiLogMs >= Config::PROMISC_LOG_INTERVAL_MS) {
+                        lastWiFiLogMs = hit.timestampMs;
+                        char macNo[13];
+                        formatMacNoDelim(hit.mac48, macNo);
+                        Serial.printf("[DETECT Wi-Fi] Match %s %s addr%u ch:%u RSSI:%d\n",
+                                      macNo, wifiFrameKind(hit.frameCtl), hit.addrIndex,
+                                      hit.channel, hit.rssi);
+                    }
+                } while (xQueueReceive(promiscHitQueue, &hit, 0) == pdTRUE);
+            }
+            
+            now = millis();
+            if ((int32_t)(now - nextHopMs) >= 0) {
+                nextHopMs = channelSchedHop(now);
+            }
+        }
+        
+        const uint32_t now2 = millis();
+        scanMeterTick(now2);
+        
+        bool present = anyMatch;
+        if (lockTake(LockId::DETECT, detectMutex, pdMS_TO_TICKS(10))) {
+            if (detectState.lastSeenMs != 0 && 
+                (now2 - detectState.lastSeenMs) <= Config::DETECT_STALE_MS) {
+                present = true;
+            }
+            xSemaphoreGive(detectMutex);
+        }
+        if (present && powerPlan.active) powerPlanOnHit(now2);
+        
+        if (present && (now2 - lastDetectSignalMs) >= Config::DETECT_PRESENCE_MS) {
+            lastDetectSignalMs = now2;
+            
+            int16_t best = -127;
+            if (lockTake(LockId::DETECT, detectMutex, pdMS_TO_TICKS(10))) {
+                best = detectState.bestRssi;
+                detectState.bestRssi = -127;
+                if (best == -127) best = detectState.lastRssi;
+                xSemaphoreGive(detectMutex);
+            }
+            
+            Serial.printf("[DETECT] Presence: RSSI=%d dBm\n", (int)best);
+            
+            outputPlay(OUT_PRESENCE);
+        }
+        
+        if (!wifiDetect) vTaskDelay(pdMS_TO_TICKS(powerPlan.active ? Config::POWER_POLL_MS : 80));
+    }
+    
+    powerPlanEnd(bleScan, wifiDetect);
+    cleanupDetection();
+    modeExit();
+}
+
+// ================================
+// FOX HUNT MODE
+// ================================
+// The consumer task filters each matching advert into foxState.rssi. Beeping
+// is driven by a one-shot esp_timer that re-arms itself from the filtered
+// RSSI; the hunt task just sleeps. The timer stops once the target is lost,
+// and the next matching advert arms it again.
+
+int calculateBeepIntervalFox(int rssi) {
+    if (rssi >= -35) {
+        return map(rssi, -35, -25, 80, 25);
+    } else if (rssi >= -45) {
+        return map(rssi, -45, -35, 140, 80);
+    } else if (rssi >= -55) {
+        return map(rssi, -55, -45, 250, 140);
+    } else if (rssi >= -65) {
+        return map(rssi, -65, -55, 450, 250);
+    } else if (rssi >= -75) {
+        return map(rssi, -75, -65, 900, 450);
+    } else if (rssi >= -85) {
+        return map(rssi, -85, -75, 1600, 900);
+    } else {
+        return 2800;
+    }
+}
+
+static esp_timer_handle_t foxBeepTimer = nullptr;
+static std::atomic<bool> foxBeepArmed(false);
+static TaskHandle_t foxTaskHandle = nullptr;
+
+// One proximity tone per tick; the output engine times the tone itself.
+// Solid tones overlap the next tick, which restarts them without a gap.
+static void foxBeepTimerCb(void* arg) {
+    const uint32_t now = millis();
+    if (!foxState.running || !foxState.hasTarget ||
+        (now - foxState.lastSeenMs) > Config::FOX_LOST_TIMEOUT_MS) {
+        outputCancel(OutputPrio::PROXIMITY);
+        foxBeepArmed.store(false);
+        return;
+    }
+    
+    const int rssi = foxState.rssi;
+    OutputPattern tone = { (uint16_t)Config::FOX_BEEP_DUR_MS, 0, Config::FOX_TONE_HZ, 1,
+                           OutputPrio::PROXIMITY };
+    uint32_t nextMs;
+    if (rssi >= -25) {
+        tone.onMs = Config::FOX_SOLID_RECHECK_MS + Config::FOX_SOLID_OVERLAP_MS;
+        nextMs = Config::FOX_SOLID_RECHECK_MS;
+    } else {
+        const int interval = calculateBeepIntervalFox(rssi);
+        nextMs = interval > (int)Config::FOX_BEEP_DUR_MS + 10 ? interval : Config::FOX_BEEP_DUR_MS + 10;
+    }
+    outputPlay(tone);
+    esp_timer_start_once(foxBeepTimer, (uint64_t)nextMs * 1000ULL);
+}
+
+bool foxBeepTimerInit() {
+    if (foxBeepTimer) return true;
+    esp_timer_create_args_t args = {};
+    args.callback = &foxBeepTimerCb;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = "foxBeep";
+    if (esp_timer_create(&args, &foxBeepTimer) != ESP_OK) {
+        Serial.println("[ERROR] Failed to create fox beep timer");
+        foxBeepTimer = nullptr;
+        return false;
+    }
+    return true;
+}
+
+// Starts the cadence if it isn't already running
+void foxBeepArm(uint32_t delayMs = 1) {
+    if (!foxBeepTimer || foxBeepArmed.exchange(true)) return;
+    esp_timer_start_once(foxBeepTimer, (uint64_t)delayMs * 1000ULL);
+}
+
+const char* foxTrendName(FoxTrend t) {
+    switch (t) {
+        case FoxTrend::WARMER: return "warmer";
+        case FoxTrend::COLDER: return "colder";
+        default:               return "steady";
+    }
+}
+
+// onResult past the running check; the benchmark calls it directly
+void foxOnReport(const AdvReport& rep) {
+    ScopedLatency lat(metrics.onResultUs);
+    metricsCount(metrics.advReceived);
+    
+    scanMeterCount(rep.mac48);
+    if (!matchesCompiledFilter(rep.mac48) && !contentRulesActive()) return;
+    advRingPush(rep);
+}
 
 class FoxBLECallbacks : public NimBLEAdvertisedDeviceCallbacks {
 public:
     void onResult(NimBLEAdvertisedDevice* dev) override {
         if (!foxState.running) return;
+        foxOnReport(advReportFrom(dev));
+    }
+};
+
+// Existing slot for the MAC, else a free one, else the least recently seen
+// non-focus slot. Never allocates.
+int foxTargetSlot(uint64_t mac48, uint32_t now) {
+    int freeIdx = -1;
+    int oldestIdx = -1;
+    uint32_t oldestAge = 0;
+    for (int i = 0; i < Config::FOX_MAX_TARGETS; i++) {
+        const FoxTarget& t = foxState.targets[i];
+        if (t.mac48 == mac48) return i;
+        if (t.mac48 == 0) {
+            if (freeIdx < 0) freeIdx = i;
+        } else if (i != foxState.focusIdx && now - t.lastSeenMs >= oldestAge) {
+            oldestAge = now - t.lastSeenMs;
+            oldestIdx = i;
+        }
+    }
+    const int idx = freeIdx >= 0 ? freeIdx : oldestIdx;
+    if (idx < 0) return -1;
+    
+    FoxTarget& t = foxState.targets[idx];
+    t = FoxTarget();
+    t.mac48 = mac48;
+    t.firstSeenMs = now;
+    t.windowStartMs = now;
+    t.rssi = -100;
+    t.rawRssi = -100;
+    return idx;
+}
+
+// Returns true when the trend changed
+bool foxTargetUpdate(FoxTarget& t, int rssi, uint32_t now) {
+    const uint32_t dt = t.hits ? now - t.lastSeenMs : 0;
+    const float est = t.filter.update((float)rssi, dt, foxState.filterQ, foxState.filterR);
+    t.rawRssi = (int16_t)rssi;
+    t.rssi = (int16_t)lroundf(est);
+    t.lastSeenMs = now;
+    t.hits++;
+    
+    t.windowHits++;
+    const uint32_t window = now - t.windowStartMs;
+    if (window >= Config::FOX_RATE_WINDOW_MS) {
+        t.hitRateX10 = (uint16_t)(t.windowHits * 10000UL / window);
+        t.windowHits = 0;
+        t.windowStartMs = now;
+    }
+    
+    if (t.trendRefMs == 0) {
+        t.trendRef = est;
+        t.trendRefMs = now;
+        return false;
+    }
+    if (now - t.trendRefMs < Config::FOX_TREND_WINDOW_MS) return false;
+    
+    const float delta = est - t.trendRef;
+    FoxTrend trend = FoxTrend::STEADY;
+    if (delta >= Config::FOX_TREND_DB) trend = FoxTrend::WARMER;
+    else if (delta <= -Config::FOX_TREND_DB) trend = FoxTrend::COLDER;
+    t.trendRef = est;
+    t.trendRefMs = now;
+    if (trend == t.trend) return false;
+    t.trend = trend;
+    return true;
+}
+
+// Pinned MAC if set; otherwise keep the current focus until it is lost or
+// another live target beats it by FOX_FOCUS_HYSTERESIS_DB
+int foxPickFocus(uint32_t now) {
+    int best = -1;
+    for (int i = 0; i < Config::FOX_MAX_TARGETS; i++) {
+        const FoxTarget& t = foxState.targets[i];
+        if (t.mac48 == 0) continue;
+        if (foxState.focusMac) {
+            if (t.mac48 == foxState.focusMac) return i;
+            continue;
+        }
+        if (now - t.lastSeenMs > Config::FOX_LOST_TIMEOUT_MS) continue;
+        if (best < 0 || t.rssi > foxState.targets[best].rssi) best = i;
+    }
+    if (foxState.focusMac) return -1;
+    
+    const int cur = foxState.focusIdx;
+    if (cur >= 0 && best >= 0 && cur != best) {
+        const FoxTarget& c = foxState.targets[cur];
+        if (c.mac48 && now - c.lastSeenMs <= Config::FOX_LOST_TIMEOUT_MS &&
+            foxState.targets[best].rssi < c.rssi + Config::FOX_FOCUS_HYSTERESIS_DB) {
+            return cur;
+        }
+    }
+    return best;
+}
+
+void foxConsumeAdvert(const RawAdvert& adv) {
+    if (!advertMatchesFilters(adv)) return;
+    metricsCount(metrics.advMatched);
+    const int rssi = adv.rssi;
+    const uint32_t now = adv.timestampMs;
+    bool notifyTask = false;
+    bool arm = false;
+    bool trendChanged = false;
+    bool focusChanged = false;
+    FoxTrend trend = FoxTrend::STEADY;
+    int16_t focusRssi = -100;
+    uint64_t focusMac = 0;
+    
+    if (lockTake(LockId::DETECT, detectMutex, pdMS_TO_TICKS(50))) {
+        const int idx = foxTargetSlot(adv.mac48, now);
+        if (idx < 0) {
+            xSemaphoreGive(detectMutex);
+            return;
+        }
+        const bool changed = foxTargetUpdate(foxState.targets[idx], rssi, now);
+        
+        const int focus = foxPickFocus(now);
+        focusChanged = focus != foxState.focusIdx && focus >= 0;
+        foxState.focusIdx = (int8_t)focus;
+        
+        if (focus >= 0 && (focus == idx || focusChanged)) {
+            const FoxTarget& f = foxState.targets[focus];
+            foxState.rssi = f.rssi;
+            foxState.rawRssi = f.rawRssi;
+            foxState.trend = f.trend;
+            foxState.lastSeenMs = f.lastSeenMs;
+            foxState.hasTarget = true;
+            trendChanged = changed && focus == idx;
+            trend = f.trend;
+            focusRssi = f.rssi;
+            focusMac = f.mac48;
+        }
+        
+        if (!foxState.firstSessionBeeped && focus >= 0) {
+            foxState.firstSessionBeeped = true;
+            foxState.startBeepsPending = true;
+            notifyTask = true;
+            char macNo[13];
+            formatMacNoDelim(adv.mac48, macNo);
+            Serial.printf("[HUNT] First detect BLE %s RSSI:%d\n", macNo, rssi);
+        } else if (foxState.firstSessionBeeped && !foxState.startBeepsPending) {
+            arm = true;
+        }
+        
+        xSemaphoreGive(detectMutex);
+    } else {
+        metricsCount(metrics.advDropped);
+    }
+    
+    if (focusChanged) {
+        char macNo[13];
+        formatMacNoDelim(focusMac, macNo);
+        Serial.printf("[HUNT] Focus -> %s, %d dBm\n", macNo, (int)focusRssi);
+    } else if (trendChanged) {
+        Serial.printf("[HUNT] %s, %d dBm (raw %d)\n", foxTrendName(trend), (int)focusRssi, rssi);
+    }
+    if (notifyTask && foxTaskHandle) xTaskNotifyGive(foxTaskHandle);
+    if (arm) foxBeepArm();
+}
+
+// Compact per-target view for /hunt_status
+String renderHuntStatusJson() {
+    String json;
+    json.reserve(96 + Config::FOX_MAX_TARGETS * 112);
+    if (!lockTake(LockId::DETECT, detectMutex, pdMS_TO_TICKS(100))) {
+        return String("{\"error\":\"busy\"}");
+    }
+    const uint32_t now = millis();
+    const int focus = foxState.focusIdx;
+    json += "{\"running\":";
+    json += foxState.running ? "true" : "false";
+    json += ",\"focus_mode\":\"";
+    json += foxState.focusMac ? "pinned" : "auto";
+    json += "\",\"focus\":\"";
+    if (foxState.focusMac) json += macPrettyU64(foxState.focusMac);
+    else if (focus >= 0) json += macPrettyU64(foxState.targets[focus].mac48);
+    json += "\",\"targets\":[";
+    bool first = true;
+    for (int i = 0; i < Config::FOX_MAX_TARGETS; i++) {
+        const FoxTarget& t = foxState.targets[i];
+        if (t.mac48 == 0) continue;
+        if (!first) json += ",";
+        first = false;
+        json += "{\"mac\":\"" + macPrettyU64(t.mac48) + "\"";
+        json += ",\"rssi\":" + String(t.rssi);
+        json += ",\"raw\":" + String(t.rawRssi);
+        json += ",\"trend\":\"";
+        json += foxTrendName(t.trend);
+        json += "\",\"age_ms\":" + String(now - t.lastSeenMs);
+        json += ",\"hits\":" + String(t.hits);
+        json += ",\"rate\":" + String(t.hitRateX10 / 10.0f, 1);
+        json += ",\"focus\":";
+        json += i == focus ? "true" : "false";
+        json += "}";
+    }
+    xSemaphoreGive(detectMutex);
+    json += "]}";
+    return json;
+}
+
+// mac48 0 returns to auto focus
+void foxSetFocus(uint64_t mac48) {
+    if (lockTake(LockId::DETECT, detectMutex, pdMS_TO_TICKS(100))) {
+        foxState.focusMac = mac48;
+        xSemaphoreGive(detectMutex);
+    }
+}
+
+static FoxBLECallbacks foxBleCb;
+
+void foxHuntCleanup() {
+    if (lockTake(LockId::DETECT, detectMutex, pdMS_TO_TICKS(1000))) {
+        foxState.running = false;
+        detectState.running = false;
+        xSemaphoreGive(detectMutex);
+    }
+    bleScanHalt();
+    if (foxBeepTimer) esp_timer_stop(foxBeepTimer);
+    foxBeepArmed.store(false);
+    outputCancel(OutputPrio::PROXIMITY);
+    foxTaskHandle = nullptr;
+}
+
+void foxHuntTask(void* pv) {
+    FoxParams* pParams = (FoxParams*)pv;
+    FoxParams params = *pParams;
+    delete pParams;
+    
+    stealthMode = params.stealth;
+    foxTaskHandle = xTaskGetCurrentTaskHandle();
+    
+    if (lockTake(LockId::DETECT, detectMutex, pdMS_TO_TICKS(1000))) {
+        foxState.reset();
+        foxState.filterQ = params.filterQ;
+        foxState.filterR = params.filterR;
+        foxState.focusMac = params.focusMac;
+        foxState.running = true;
+        detectState.running = true;
+        xSemaphoreGive(detectMutex);
+    }
+    
+    Serial.println("[HUNT] Starting (BLE-only, using Detection Filters)");
+    
+    dropWiFiAP(WIFI_OFF);
+    
+    NimBLEScan* bleScan = bleStackUp() ? NimBLEDevice::getScan() : nullptr;
+    if (!bleScan) {
+        Serial.println("[ERROR] Failed to get BLE scan object");
+        foxHuntCleanup();
+        modeExit();
+        return;
+    }
+    NimBLEDevice::setPower(ESP_PWR_LVL_P9);
+    
+    advSink = AdvSink::FOX;
+    bleScan->setAdvertisedDeviceCallbacks(&foxBleCb, false);
+    applyScanProfile(bleScan, params.bleProfile);
+    bleScan->setDuplicateFilter(false);
+    bleScan->setMaxResults(0);
+    
+    if (!bleScan->start(0, nullptr, false)) {
+        Serial.println("[ERROR] BLE scan start failed");
+        foxHuntCleanup();
+        modeExit();
+        return;
+    }
+    
+    Serial.printf("[HUNT] BLE scan active, Kalman q=%.1f r=%.1f\n", params.filterQ, params.filterR);
+    scanMeterBegin(params.bleProfile);
+    foxBeepTimerInit();
+    modeReady();
+    
+    // Idle until the first detect; afterwards the beep timer runs the show.
+    // A stop request notifies this task, so it exits without waiting out the sleep.
+    while (modeShouldRun(millis())) {
+        esp_task_wdt_reset();
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000));
+        scanMeterTick(millis());
+        
+        // Arm before clearing the flag so the consumer can't start the
+        // cadence on top of the start beeps
+        if (foxState.startBeepsPending && modeShouldRun(millis())) {
+            outputPlay(OUT_FOX_START);
+            foxBeepArm(outputPatternMs(OUT_FOX_START));
+            foxState.startBeepsPending = false;
+        }
+    }
+    
+    foxHuntCleanup();
+    modeExit();
+}
+
+// ================================
+// CONTINUOUS SURVEY
+// ================================
+// A continuous baseline runs until POST /baseline_stop. Every snapshotSecs it
+// appends one snapshot of the devices touched since the previous one to a
+// fixed byte ring in PSRAM; the oldest snapshots are dropped when it fills,
+// so memory stays bounded however long the unit runs. Offsets are absolute
+// (physical = offset % size), which lets readers detect being overtaken.
+
+struct SurveyRing {
+    uint8_t* data;
+    uint32_t size;
+    uint32_t head;           // absolute write offset
+    uint32_t tail;           // absolute offset of the oldest snapshot
+    uint32_t snapshots;      // currently stored
+    uint32_t dropped;        // evicted to make room
+    uint32_t nextId;
+    uint32_t lastSeq;        // live-table seq covered by the last complete pass
+    uint32_t passSeq;        // seqCounter when the pass in progress started
+    uint32_t resumeSlot;     // where an unfinished pass continues, 0 = new pass
+    uint32_t nextSnapMs;
+    uint16_t intervalSecs;
+};
+
+static SurveyRing surveyRing;   // guarded by surveyMutex; lastSeq/nextSnapMs: baseline task only
+
+inline bool baselineKeepRunning(const BaselineConfig& config, uint32_t startMs, uint32_t durMs) {
+    return !baselineStopRequested && (config.continuous || millis() - startMs < durMs);
+}
+
+void surveyRingCopyOut(uint32_t abs, uint8_t* dst, uint32_t len) {
+    const uint32_t off = abs % surveyRing.size;
+    const uint32_t first = len < surveyRing.size - off ? len : surveyRing.size - off;
+    memcpy(dst, surveyRing.data + off, first);
+    if (len > first) memcpy(dst + first, surveyRing.data, len - first);
+}
+
+void surveyRingCopyIn(uint32_t abs, const uint8_t* src, uint32_t len) {
+    const uint32_t off = abs % surveyRing.size;
+    const uint32_t first = len < surveyRing.size - off ? len : surveyRing.size - off;
+    memcpy(surveyRing.data + off, src, first);
+    if (len > first) memcpy(surveyRing.data, src + first, len - first);
+}
+
+// Allocated on the first continuous run, then reused
+bool surveyBegin(const BaselineConfig& config) {
+    if (!surveyRing.data) {
+        surveyRing.data = (uint8_t*)psramAlloc(Config::SURVEY_RING_BYTES);
+        if (!surveyRing.data) {
+            Serial.println("[ERROR] OOM allocating survey ring");
+            return false;
+        }
+        surveyRing.size = Config::SURVEY_RING_BYTES;
+    }
+    if (xSemaphoreTake(surveyMutex, pdMS_TO_TICKS(1000)) != pdTRUE) {
+        Serial.println("[ERROR] Failed to acquire survey mutex");
+        return false;
+    }
+    surveyRing.head = 0;
+    surveyRing.tail = 0;
+    surveyRing.snapshots = 0;
+    surveyRing.dropped = 0;
+    surveyRing.nextId = 1;
+    surveyRing.intervalSecs = config.snapshotSecs;
+    xSemaphoreGive(surveyMutex);
+    
+    surveyRing.lastSeq = 0;
+    surveyRing.passSeq = 0;
+    surveyRing.resumeSlot = 0;
+    surveyRing.nextSnapMs = millis() + config.snapshotSecs * 1000UL;
+    return true;
+}
+
+void surveyRingAppend(const uint8_t* buf, uint32_t len) {
+    if (xSemaphoreTake(surveyMutex, pdMS_TO_TICKS(500)) != pdTRUE) {
+        Serial.println("[ERROR] Survey snapshot lost: mutex busy");
+        return;
+    }
+    while (surveyRing.snapshots && surveyRing.size - (surveyRing.head - surveyRing.tail) < len) {
+        SurveySnapshotHeader old;
+        surveyRingCopyOut(surveyRing.tail, (uint8_t*)&old, sizeof(old));
+        surveyRing.tail += old.totalLen;
+        surveyRing.snapshots--;
+        surveyRing.dropped++;
+    }
+    surveyRingCopyIn(surveyRing.head, buf, len);
+    surveyRing.head += len;
+    surveyRing.snapshots++;
+    xSemaphoreGive(surveyMutex);
+}
+
+inline void appendVarint(std::vector<uint8_t>& out, uint32_t v) {
+    while (v >= 0x80) {
+        out.push_back((uint8_t)(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back((uint8_t)v);
+}
+
+// Walks the table in batches so the consumer is never locked out for long.
+// A device touched mid-walk may appear again next time with a small delta.
+void surveySnapshot(DeviceTable& t) {
+    const uint32_t now = millis();
+    const uint32_t maxBytes = surveyRing.size / 4;
+    std::vector<uint8_t> buf;
+    buf.reserve(4096);
+    buf.resize(sizeof(SurveySnapshotHeader));
+    
+    // One pass over the table reports every device changed since the last
+    // complete pass. A snapshot that hits the size cap or a busy batch stops
+    // there and the next one resumes at that slot; lastSeq only moves once
+    // the pass reaches the end, so no changed device is skipped.
+    uint32_t records = 0;
+    bool truncated = false;
+    uint32_t slot = surveyRing.resumeSlot;
+    
+    while (slot < t.capacity && !truncated) {
+        if (!lockTake(LockId::LIVE, liveMutex, pdMS_TO_TICKS(100))) {
+            truncated = true;
+            break;
+        }
+        if (slot == 0) surveyRing.passSeq = t.seqCounter;
+        const uint32_t end = slot + Config::SURVEY_BATCH_SLOTS < t.capacity ? slot + Config::SURVEY_BATCH_SLOTS : t.capacity;
+        for (; slot < end; slot++) {
+            if (!t.used(slot) || t.seq[slot] <= surveyRing.lastSeq) continue;
+            if (buf.size() + SURVEY_RECORD_MAX > maxBytes || records == 0xFFFF) {
+                truncated = true;
+                break;
+            }
+            const DeviceRecord& o = t.hot[slot];
+            DeviceStats& st = t.stats[slot];
+            const uint64_t mac48 = t.macAt(slot);
+            for (int i = 5; i >= 0; i--) buf.push_back((uint8_t)(mac48 >> (i * 8)));
+            buf.push_back(o.flags);
+            appendVarint(buf, (now - st.firstSeenMs) / 1000);
+            appendVarint(buf, (now - o.lastSeenMs) / 100);
+            appendVarint(buf, st.samples - st.snapSamples);
+            buf.push_back((uint8_t)st.rssiMin);
+            buf.push_back((uint8_t)st.rssiMax);
+            buf.push_back((uint8_t)(int8_t)(st.samples ? rssiMean(st) : -127));
+            st.snapSamples = st.samples;
+            records++;
+        }
+        xSemaphoreGive(liveMutex);
+    }
+    if (truncated) {
+        surveyRing.resumeSlot = slot;
+    } else {
+        surveyRing.lastSeq = surveyRing.passSeq;
+        surveyRing.resumeSlot = 0;
+    }
+    
+    SurveySnapshotHeader h;
+    memset(&h, 0, sizeof(h));
+    h.magic = SURVEY_MAGIC;
+    h.totalLen = (uint32_t)buf.size();
+    h.snapshotId = surveyRing.nextId++;
+    h.timeMs = now;
+    h.records = (uint16_t)records;
+    h.intervalSecs = surveyRing.intervalSecs;
+    h.flags = truncated ? SURVEY_TRUNCATED : 0;
+    memcpy(buf.data(), &h, sizeof(h));
+    surveyRingAppend(buf.data(), h.totalLen);
+    
+    Serial.printf("[SURVEY] Snapshot %u: %u devices, %u bytes%s\n", (unsigned)h.snapshotId,
+                  (unsigned)records, (unsigned)h.totalLen, truncated ? " (truncated)" : "");
+}
+
+// Called from the baseline loops; no-op unless the run is continuous
+void surveyTick(DeviceTable& t, const BaselineConfig& config) {
+    if (!config.continuous || !surveyRing.data) return;
+    if ((int32_t)(millis() - surveyRing.nextSnapMs) < 0) return;
+    surveySnapshot(t);
+    surveyRing.nextSnapMs += config.snapshotSecs * 1000UL;
+    if ((int32_t)(millis() - surveyRing.nextSnapMs) >= 0) {
+        surveyRing.nextSnapMs = millis() + config.snapshotSecs * 1000UL;   // fell behind, don't burst
+    }
+}
+
+String renderSurveyStatusJson() {
+    String json = "{";
+    const bool running = baselineRunning && currentBaselineConfig.continuous;
+    json += "\"running\":";
+    json += running ? "true" : "false";
+    if (xSemaphoreTake(surveyMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
+        json += ",\"interval_secs\":" + String(surveyRing.intervalSecs);
+        json += ",\"snapshots\":" + String(surveyRing.snapshots);
+        json += ",\"dropped\":" + String(surveyRing.dropped);
+        json += ",\"oldest_id\":" + String(surveyRing.snapshots ? surveyRing.nextId - surveyRing.snapshots : 0);
+        json += ",\"newest_id\":" + String(surveyRing.snapshots ? surveyRing.nextId - 1 : 0);
+        json += ",\"bytes_used\":" + String(surveyRing.head - surveyRing.tail);
+        json += ",\"ring_bytes\":" + String(surveyRing.size);
+        xSemaphoreGive(surveyMutex);
+    }
+    if (running) {
+        json += ",\"next_snapshot_ms\":" + String((int32_t)(surveyRing.nextSnapMs - millis()));
+    }
+    json += "}";
+    return json;
+}
+
+// Streams every stored snapshot, oldest first. Ends early if the writer
+// evicts data this download hasn't sent yet.
+struct SurveyStream {
+    uint32_t pos;
+    uint32_t end;
+    bool started;
+};
+
+size_t surveyStreamFill(SurveyStream& st, uint8_t* buffer, size_t maxLen) {
+    if (xSemaphoreTake(surveyMutex, 0) != pdTRUE) return RESPONSE_TRY_AGAIN;
+    if (!st.started) {
+        st.pos = surveyRing.tail;
+        st.end = surveyRing.head;
+        st.started = true;
+    }
+    if ((int32_t)(surveyRing.tail - st.pos) > 0 || st.pos == st.end) {
+        xSemaphoreGive(surveyMutex);
+        return 0;
+    }
+    uint32_t n = st.end - st.pos;
+    if (n > maxLen) n = (uint32_t)maxLen;
+    surveyRingCopyOut(st.pos, buffer, n);
+    st.pos += n;
+    xSemaphoreGive(surveyMutex);
+    return n;
+}
+
+// ================================
+// ADDRESS ROTATION CORRELATION
+// ================================
+// Phones rotate resolvable private addresses every few minutes, so one phone
+// shows up under many MACs. When a new RPA appears, its advertisement is
+// reduced to a fingerprint of the fields that survive rotation (flags, TX
+// power, appearance, service UUID set, manufacturer company ID plus a short
+// prefix). A hash index maps fingerprints to clusters; the new address joins
+// the most recent cluster with the same fingerprint whose current address
+// went quiet just before it appeared (gap longer than twice its advertising
+// interval, shorter than ROTATION_MAX_GAP_MS). Two addresses heard at the
+// same time are never merged. Written only by the consumer task, under
+// liveMutex, together with the baseline table.
+
+struct RotationCluster {
+    uint32_t fp;
+    uint32_t lastSeenMs;         // any member address
+    uint64_t currentMac;         // newest member
+    uint16_t addresses;
+    uint16_t intervalMs;         // EMA of the current address' advertising interval
+};
+
+struct FingerprintSlot {
+    uint32_t fp;
+    uint16_t cluster;            // 0 = empty
+};
+
+struct RotationCorrelator {
+    RotationCluster* clusters;   // 1-based, [0] unused
+    FingerprintSlot* index;
+    uint16_t count;
+    uint32_t linked;             // addresses merged into an existing cluster
+    uint32_t conflicts;          // old member heard after a newer one joined
+};
+
+static RotationCorrelator rotation;
+
+inline bool isResolvablePrivate(uint64_t mac48, uint8_t addrType) {
+    return addrType == BLE_ADDR_RANDOM && (mac48 >> 46) == 0x1;
+}
+
+bool rotationInit() {
+    rotation.clusters = (RotationCluster*)psramAlloc((Config::ROTATION_MAX_CLUSTERS + 1) * sizeof(RotationCluster));
+    rotation.index = (FingerprintSlot*)psramAlloc(Config::ROTATION_INDEX_SLOTS * sizeof(FingerprintSlot));
+    if (!rotation.clusters || !rotation.index) {
+        free(rotation.clusters);
+        free(rotation.index);
+        rotation.clusters = nullptr;
+        rotation.index = nullptr;
+        Serial.println("[ERROR] OOM allocating rotation correlator");
+        return false;
+    }
+    return true;
+}
+
+// Caller holds liveMutex (or the consumer is detached)
+void rotationReset() {
+    if (!rotation.index) return;
+    memset(rotation.index, 0, Config::ROTATION_INDEX_SLOTS * sizeof(FingerprintSlot));
+    rotation.count = 0;
+    rotation.linked = 0;
+    rotation.conflicts = 0;
+}
+
+inline uint32_t fnv1a(uint32_t h, const uint8_t* p, size_t n) {
+    for (size_t i = 0; i < n; i++) h = (h ^ p[i]) * 16777619u;
+    return h;
+}
+
+// Returns 0 when nothing in the payload is distinctive enough to correlate on
+uint32_t advFingerprint(const AdView& ad) {
+    if (!ad.hasMfg && !ad.uuidListCount) return 0;
+    
+    uint32_t h = 2166136261u;
+    uint8_t tag;
+    if (ad.hasFlags) {
+        tag = 0x01;
+        h = fnv1a(fnv1a(h, &tag, 1), &ad.flags, 1);
+    }
+    if (ad.hasTxPower) {
+        tag = 0x0A;
+        h = fnv1a(fnv1a(h, &tag, 1), (const uint8_t*)&ad.txPower, 1);
+    }
+    if (ad.hasAppearance) {
+        tag = 0x19;
+        h = fnv1a(fnv1a(h, &tag, 1), (const uint8_t*)&ad.appearance, 2);
+    }
+    if (ad.hasMfg) {
+        // company ID plus a stable prefix; the rest is usually rolling state
+        const uint8_t n = ad.mfgData.len < Config::ROTATION_MFG_PREFIX ? ad.mfgData.len
+                                                                     : Config::ROTATION_MFG_PREFIX;
+        tag = 0xFF;
+        h = fnv1a(fnv1a(h, &tag, 1), (const uint8_t*)&ad.companyId, 2);
+        h = fnv1a(h, ad.mfgData.data, n);
+    }
+    uint32_t uuidSet = 0;   // sum of per-UUID hashes: order-independent
+    for (uint8_t l = 0; l < ad.uuidListCount; l++) {
+        const AdUuidList& list = ad.uuids[l];
+        for (uint8_t u = 0; u < list.count; u++) {
+            uuidSet += fnv1a(2166136261u, list.data + u * list.width, list.width);
+        }
+    }
+    h = fnv1a(h, (const uint8_t*)&uuidSet, sizeof(uuidSet));
+    return h ? h : 1;
+}
+
+inline uint32_t fpHome(uint32_t fp) {
+    return (fp * 2654435761u) & (Config::ROTATION_INDEX_SLOTS - 1);
+}
+
+uint16_t rotationNewCluster(uint32_t fp, uint64_t mac48, uint32_t now) {
+    if (rotation.count >= Config::ROTATION_MAX_CLUSTERS) return 0;
+    uint32_t slot = fpHome(fp);
+    for (uint8_t i = 0; i < Config::ROTATION_INDEX_PROBES; i++) {
+        if (rotation.index[slot].cluster == 0) {
+            const uint16_t id = ++rotation.count;
+            RotationCluster& c = rotation.clusters[id];
+            c.fp = fp;
+            c.lastSeenMs = now;
+            c.currentMac = mac48;
+            c.addresses = 1;
+            c.intervalMs = 0;
+            rotation.index[slot].fp = fp;
+            rotation.index[slot].cluster = id;
+            return id;
+        }
+        slot = (slot + 1) & (Config::ROTATION_INDEX_SLOTS - 1);
+    }
+    return 0;   // probe run full: leave this address uncorrelated
+}
+
+// Best existing cluster for a newly seen address, 0 if none qualifies
+uint16_t rotationFindCluster(uint32_t fp, uint32_t now) {
+    uint16_t best = 0;
+    uint32_t slot = fpHome(fp);
+    for (uint8_t i = 0; i < Config::ROTATION_INDEX_PROBES; i++) {
+        const FingerprintSlot& e = rotation.index[slot];
+        if (e.cluster == 0) break;
+        if (e.fp == fp) {
+            const RotationCluster& c = rotation.clusters[e.cluster];
+            const uint32_t gap = now - c.lastSeenMs;
+            uint32_t minGap = 2UL * c.intervalMs;
+            if (minGap < Config::ROTATION_MIN_GAP_MS) minGap = Config::ROTATION_MIN_GAP_MS;
+            if (gap >= minGap && gap <= Config::ROTATION_MAX_GAP_MS &&
+                (!best || c.lastSeenMs > rotation.clusters[best].lastSeenMs)) {
+                best = e.cluster;
+            }
+        }
+        slot = (slot + 1) & (Config::ROTATION_INDEX_SLOTS - 1);
+    }
+    return best;
+}
+
+// Assigns/updates rec->cluster. Returns true if the address was merged into
+// an existing cluster (callers skip per-device extras for those).
+bool rotationObserve(DeviceRecord& rec, const RawAdvert& adv, const AdView& ad, bool created) {
+    if (!rotation.index || !isResolvablePrivate(adv.mac48, adv.addrType)) return false;
+    const uint32_t now = adv.timestampMs;
+
+    if (created) {   // fingerprint is taken from the first report only
+        const uint32_t fp = advFingerprint(ad);
+        if (!fp) return false;
+        
+        const uint16_t id = rotationFindCluster(fp, now);
+        if (id) {
+            RotationCluster& c = rotation.clusters[id];
+            c.currentMac = adv.mac48;
+            c.lastSeenMs = now;
+            c.addresses++;
+            rec.cluster = id;
+            rotation.linked++;
+            return true;
+        }
+        rec.cluster = rotationNewCluster(fp, adv.mac48, now);
+        return false;
+    }
+    if (rec.cluster == 0) return false;
+    
+    RotationCluster& c = rotation.clusters[rec.cluster];
+    if (c.currentMac != adv.mac48) {
+        rotation.conflicts++;   // stale member still talking; keep the link, count it
+        return false;
+    }
+    const uint32_t dt = now - c.lastSeenMs;
+    if (dt < Config::ROTATION_MAX_GAP_MS) {
+        c.intervalMs = c.intervalMs ? (uint16_t)((c.intervalMs * 7 + dt) / 8) : (uint16_t)dt;
+    }
+    c.lastSeenMs = now;
+    return false;
+}
+
+// ================================
+// ENHANCED BASELINE SCANNING
+// ================================
+
+// Producer side (onResult) runs on the NimBLE host task; consume() runs on
+// the advertisement consumer task, which is the only writer of `entries`.
+class EnhancedBLECollector : public NimBLEAdvertisedDeviceCallbacks {
+public:
+    DeviceTable& entries;
+    BaselineConfig config;
+    uint16_t devicesWithPayload;
+    bool limitLogged;
+    
+    EnhancedBLECollector(DeviceTable& table, const BaselineConfig& cfg) : entries(table),
+                                                                          config(cfg), 
+                                                                          devicesWithPayload(0),
+                                                                          limitLogged(false) {}
+    
+    void onResult(NimBLEAdvertisedDevice* dev) override {
+        onReport(advReportFrom(dev));
+    }
+    
+    void onReport(const AdvReport& rep) {
+        ScopedLatency lat(metrics.onResultUs);
+        metricsCount(metrics.advReceived);
+        scanMeterCount(rep.mac48);
         
-        String macNo = toUpperNoDelim(String(dev->getAddress().toString().c_str()));
-        if (macNo.length() != 12) return;
+        // Apply RSSI threshold filter
+        if (rep.rssi < config.rssiThreshold) {
+            return;
+        }
+        advRingPush(rep);
+    }
+    
+    void consume(const RawAdvert& adv) {
+        AdView ad;
+        adParse(adv.payload, adv.payloadLen, ad);
+        const bool ruleMatch = matchContentRules(ad) >= 0;
+        
+        if (!lockTake(LockId::LIVE, liveMutex, pdMS_TO_TICKS(50))) {
+            metricsCount(metrics.advDropped);
+            return;
+        }
+        metricsCount(metrics.advMatched);
         
-        std::vector<String> localFilters;
-        if (!matchesAnyFilter(macNo, localFilters)) return;
+        bool created = false;
+        DeviceRecord* rec = observeBleAdvert(entries, adv.mac48, adv.rssi, adv.addrType, adv.timestampMs,
+                                             ad, ruleMatch, &created);
+        if (!rec) {
+            xSemaphoreGive(liveMutex);
+            return;
+        }
         
-        const int rssi = dev->getRSSI();
+        DeviceRecord &o = *rec;
+        const bool rotated = rotationObserve(o, adv, ad, created);
+        bool captured = false;
         
-        if (xSemaphoreTake(detectMutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-            foxState.rssi = rssi;
-            foxState.hasTarget = true;
-            foxState.lastSeenMs = millis();
-            
-            if (!foxState.firstSessionBeeped) {
-                foxState.firstSessionBeeped = true;
-                foxState.startBeepsPending = true;
-                Serial.printf("[HUNT] First detect BLE %s RSSI:%d\n", macNo.c_str(), rssi);
+        // Capture payload if enabled and memory permits. A rotated address of an
+        // already-captured device would only spend the arena on a duplicate.
+        if (config.capturePayload && !rotated && !(o.flags & DEV_HAS_PAYLOAD)) {
+            if (devicesWithPayload < Config::MAX_PAYLOAD_DEVICES &&
+                entries.payloads.used < Config::MAX_PAYLOAD_MEMORY) {
+                
+                if (adv.payloadLen > 0 && entries.setPayload(rec, adv.payload, adv.payloadLen)) {
+                    devicesWithPayload++;
+                    captured = true;
+                }
+            } else if (devicesWithPayload >= Config::MAX_PAYLOAD_DEVICES && !limitLogged) {
+                // Only log once when we hit the limit
+                Serial.println("[WARN] Payload device limit reached");
+                limitLogged = true;
             }
-            
-            xSemaphoreGive(detectMutex);
+        }
+        const uint32_t arenaUsed = entries.payloads.used;
+        xSemaphoreGive(liveMutex);
+        
+        if (captured) {
+            char macNo[13];
+            formatMacNoDelim(adv.mac48, macNo);
+            Serial.printf("[PAYLOAD] Captured %u bytes for %s (Total: %u/%u devices, %u/%u bytes)\n",
+                          adv.payloadLen, macNo, devicesWithPayload, 
+                          Config::MAX_PAYLOAD_DEVICES, (unsigned)arenaUsed, 
+                          Config::MAX_PAYLOAD_MEMORY);
+        }
+    }
+};
+
+static EnhancedBLECollector* activeCollector = nullptr;
+
+void baselineConsumeAdvert(const RawAdvert& adv) {
+    if (activeCollector) activeCollector->consume(adv);
+}
+
+void enhancedBaselineTask(void* pv) {
+    BaselineConfig* pConfig = (BaselineConfig*)pv;
+    BaselineConfig config = *pConfig;
+    delete pConfig;
+    
+    currentBaselineConfig = config;
+    baselineStopRequested = false;
+    baselineRunning = true;
+    currentPayloadMemory = 0;
+    
+    Serial.printf("[BASELINE-ENHANCED] Start mode=%d, secs=%u, RSSI>=%d, payload=%s\n", 
+                  (int)config.mode, config.durationSecs, config.rssiThreshold,
+                  config.capturePayload ? "ON" : "OFF");
+    
+    DeviceTable& macMap = workingBaselineTable();
+    if (lockTake(LockId::LIVE, liveMutex, pdMS_TO_TICKS(1000))) {
+        macMap.clear();
+        rotationReset();
+        liveTable = &macMap;
+        liveRunId++;
+        xSemaphoreGive(liveMutex);
+    }
+    EnhancedBLECollector bleCb(macMap, config);
+    NimBLEScan* bleScan = nullptr;
+    
+    if (config.continuous && !surveyBegin(config)) {
+        config.continuous = false;
+        config.durationSecs = Config::SURVEY_SNAPSHOT_SECS;
+        Serial.println("[SURVEY] Falling back to a timed run");
+        currentBaselineConfig = config;
+    }
+    
+    if (config.mode == BaselineMode::BLE_ONLY || config.mode == BaselineMode::WIFI_AND_BLE) {
+        bleScan = bleStackUp() ? NimBLEDevice::getScan() : nullptr;
+        if (!bleScan) {
+            Serial.println("[ERROR] Failed to get BLE scan object");
+            baselineRunning = false;
+            vTaskDelete(nullptr);
+            return;
+        }
+        
+        activeCollector = &bleCb;
+        advSink = AdvSink::BASELINE;
+        bleScan->setAdvertisedDeviceCallbacks(&bleCb, false);
+        applyScanProfile(bleScan, config.bleProfile);
+        bleScan->setMaxResults(0);  // results live in the baseline table, not NimBLE's vector
+        
+        if (!bleScan->start(0, nullptr, false)) {
+            Serial.println("[ERROR] BLE scan start failed");
+            bleScanHalt();
+            activeCollector = nullptr;
+            baselineRunning = false;
+            vTaskDelete(nullptr);
+            return;
+        }
+        scanMeterBegin(config.bleProfile);
+    }
+    
+    uint32_t startMs = millis();
+    uint32_t durMs = config.durationSecs * 1000UL;
+    
+    // WiFi scanning with full metadata capture
+    if (config.mode == BaselineMode::WIFI_ONLY || config.mode == BaselineMode::WIFI_AND_BLE) {
+        captureWiFiMetadata(macMap, config, startMs, durMs);
+    } else {
+        while (baselineKeepRunning(config, startMs, durMs)) {
+            esp_task_wdt_reset();
+            scanMeterTick(millis());
+            surveyTick(macMap, config);
+            vTaskDelay(pdMS_TO_TICKS(100));
+        }
+    }
+    
+    if (bleScan) bleScanHalt();
+    activeCollector = nullptr;
+    
+    currentPayloadMemory = bleCb.entries.payloads.used;
+    
+    if (config.continuous) {
+        surveySnapshot(macMap);
+        config.durationSecs = (millis() - startMs) / 1000;   // reports show the real run length
+    }
+    
+    buildEnhancedResults(macMap, config);
+    if (config.saveCapture) {
+        saveCaptureFile(macMap, config);
+    }
+    captureLogSession(macMap, config);
+    
+    Serial.printf("[BASELINE-ENHANCED] Done, %u devices, %u with payloads, %u evicted\n", 
+                  (unsigned)macMap.count, bleCb.devicesWithPayload, (unsigned)macMap.evictions);
+    outputPlay(OUT_BASELINE_DONE);
+    
+    baselineRunning = false;
+    vTaskDelete(nullptr);
+}
+
+void buildEnhancedResults(const DeviceTable& table, const BaselineConfig& config) {
+    const int64_t startUs = esp_timer_get_time();
+    if (!lockTake(LockId::RESULTS, resultsMutex, pdMS_TO_TICKS(2000))) {
+        Serial.println("[ERROR] Failed to acquire results mutex");
+        return;
+    }
+    
+    resultsTable = &table;
+    resultsGeneration++;
+    collectResultRows(table, config.sortKey, enhancedResultsRows);
+    const DeviceRecord* hot = table.hot;
+
+    // ---- Count device types ----
+    ResultsSummary summary;
+    summary.config = config;
+    summary.builtMs = millis();
+    uint8_t clusterSeen[(Config::ROTATION_MAX_CLUSTERS + 8) / 8] = {};
+    for (size_t i = 0; i < enhancedResultsRows.size(); ++i) {
+        const DeviceRecord& obs = hot[enhancedResultsRows[i]];
+        if (obs.flags & DEV_WIFI) {
+            summary.wifiCount++;
+        } else {
+            summary.bleCount++;
+            if (obs.flags & DEV_HAS_PAYLOAD) summary.bleWithPayload++;
+            const uint16_t cl = obs.cluster;
+            if (cl == 0) {
+                summary.bleLogical++;
+            } else if (!(clusterSeen[cl >> 3] & (1 << (cl & 7)))) {
+                clusterSeen[cl >> 3] |= 1 << (cl & 7);
+                summary.bleLogical++;
+            }
+        }
+    }
+    resultsSummary = summary;
+    
+    // CSV, TXT and HTML documents are rendered per request by the streams below
+    xSemaphoreGive(resultsMutex);
+    histRecordSince(metrics.resultsBuildUs, startUs);
+}
+
+// ================================
+// LIVE RESULTS (/baseline_live)
+// ================================
+// Clients poll with ?since=<seq>&run=<run>. Only records touched after `since`
+// are returned, oldest change first, at most LIVE_PAGE_LIMIT per call; pass the
+// returned "seq" back as the next `since`. A different run id means the table
+// was reset, so the client should drop its copy and start again from 0.
+
+void appendLiveRecordJson(String& json, const DeviceTable& t, uint32_t slot) {
+    const DeviceRecord& obs = t.hot[slot];
+    json += "{\"mac\":\"" + macPrettyU64(t.macAt(slot)) + "\"";
+    json += ",\"src\":\"";
+    json += deviceSource(obs);
+    json += "\",\"rssi\":" + String(obs.rssi);
+    json += ",\"last_seen\":" + String(obs.lastSeenMs);
+    const DeviceStats& st = t.stats[slot];
+    json += ",\"first_seen\":" + String(st.firstSeenMs);
+    json += ",\"n\":" + String(st.samples);
+    if (st.samples) {
+        json += ",\"mean\":" + String(st.meanQ8 / 256.0f, 1);
+        json += ",\"min\":" + String(st.rssiMin);
+        json += ",\"max\":" + String(st.rssiMax);
+        json += ",\"sd\":" + String(rssiStdDev(st), 2);
+    }
+    if (obs.nameRef) json += ",\"name\":\"" + jsonEscape(t.name(slot)) + "\"";
+    if (obs.cluster) json += ",\"cl\":" + String(obs.cluster);
+    if (obs.flags & DEV_RULE_MATCH) json += ",\"rule\":true";
+    if (obs.flags & DEV_HAS_WIFI_META) {
+        const WiFiMeta& meta = t.wifi[slot];
+        json += ",\"ch\":" + String(meta.channel);
+        json += ",\"enc\":\"";
+        json += getEncryptionType((wifi_auth_mode_t)meta.authMode);
+        json += "\"";
+        if (obs.flags & DEV_HIDDEN) json += ",\"hidden\":true";
+    }
+    if (obs.flags & DEV_HAS_PAYLOAD) json += ",\"payload_len\":" + String(obs.payloadLength);
+    json += ",\"seq\":" + String(t.seq[slot]) + "}";
+}
+
+String renderLiveJson(uint32_t since, uint32_t run) {
+    if (!lockTake(LockId::LIVE, liveMutex, pdMS_TO_TICKS(200))) return String();
+    
+    if (!liveTable) {
+        xSemaphoreGive(liveMutex);
+        return String("{\"run\":0,\"seq\":0,\"running\":false,\"more\":false,\"devices\":[]}");
+    }
+    
+    const DeviceTable& t = *liveTable;
+    if (run != liveRunId || since > t.seqCounter) since = 0;
+    
+    std::vector<uint32_t> changed;
+    for (uint32_t slot = 0; slot < t.capacity; ++slot) {
+        if (t.used(slot) && t.seq[slot] > since) changed.push_back(slot);
+    }
+    
+    const bool more = changed.size() > Config::LIVE_PAGE_LIMIT;
+    const uint32_t* seq = t.seq;
+    auto bySeq = [seq](uint32_t a, uint32_t b) { return seq[a] < seq[b]; };
+    if (more) {
+        std::partial_sort(changed.begin(), changed.begin() + Config::LIVE_PAGE_LIMIT, changed.end(), bySeq);
+        changed.resize(Config::LIVE_PAGE_LIMIT);
+    } else {
+        std::sort(changed.begin(), changed.end(), bySeq);
+    }
+    const uint32_t cursor = more ? t.seq[changed.back()] : t.seqCounter;
+    
+    String json;
+    json.reserve(128 + changed.size() * 120);
+    json += "{\"run\":" + String(liveRunId);
+    json += ",\"seq\":" + String(cursor);
+    json += ",\"running\":" + String(baselineRunning ? "true" : "false");
+    json += ",\"count\":" + String(t.count);
+    json += ",\"evictions\":" + String(t.evictions);
+    json += ",\"more\":" + String(more ? "true" : "false");
+    json += ",\"devices\":[";
+    for (size_t i = 0; i < changed.size(); ++i) {
+        if (i) json += ",";
+        appendLiveRecordJson(json, t, changed[i]);
+    }
+    json += "]}";
+    
+    xSemaphoreGive(liveMutex);
+    return json;
+}
+
+// ================================
+// BINARY CAPTURE EXPORT
+// ================================
+// Raw fields only, no string formatting; decode with tools/decode_capture.py
+
+size_t encodeCaptureHeader(const BaselineConfig& config, uint32_t builtMs, uint32_t count, uint8_t* out) {
+    CaptureHeader hdr;
+    hdr.magic = CAPTURE_MAGIC;
+    hdr.version = CAPTURE_VERSION;
+    hdr.headerLen = sizeof(CaptureHeader);
+    hdr.mode = (uint8_t)config.mode;
+    hdr.capturePayload = config.capturePayload ? 1 : 0;
+    hdr.rssiThreshold = config.rssiThreshold;
+    hdr.durationSecs = config.durationSecs;
+    hdr.builtMs = builtMs;
+    hdr.recordCount = count;
+    memcpy(out, &hdr, sizeof(hdr));
+    return sizeof(hdr);
+}
+
+// Runs on the baseline task after publishing; that task is the table's only
+// writer, so the slots can be walked without resultsMutex.
+bool saveCaptureFile(const DeviceTable& table, const BaselineConfig& config) {
+    File f = LittleFS.open(Config::CAPTURE_TMP_PATH, FILE_WRITE);
+    if (!f) {
+        Serial.println("[ERROR] Failed to open capture file");
+        return false;
+    }
+    
+    uint8_t rec[CAPTURE_RECORD_MAX];
+    size_t n = encodeCaptureHeader(config, millis(), table.count, rec);
+    bool ok = f.write(rec, n) == n;
+    size_t total = n;
+    
+    for (uint32_t slot = 0; ok && slot < table.capacity; ++slot) {
+        if (!table.used(slot)) continue;
+        n = encodeCaptureRecord(table, slot, rec);
+        ok = f.write(rec, n) == n;
+        total += n;
+        if ((slot & 0xFF) == 0) esp_task_wdt_reset();
+    }
+    f.close();
+    
+    if (!ok) {
+        Serial.println("[ERROR] Short write on capture file");
+        LittleFS.remove(Config::CAPTURE_TMP_PATH);
+        return false;
+    }
+    
+    // Rename replaces the previous capture atomically
+    if (!LittleFS.rename(Config::CAPTURE_TMP_PATH, Config::CAPTURE_PATH)) {
+        Serial.println("[ERROR] Failed to replace capture file");
+        LittleFS.remove(Config::CAPTURE_TMP_PATH);
+        return false;
+    }
+    Serial.printf("[CAPTURE] Saved %u devices, %u bytes\n", (unsigned)table.count, (unsigned)total);
+    return true;
+}
+
+// ================================
+// CAPTURE LOG (LittleFS)
+// ================================
+// Every finished baseline is appended to a log on flash, so past sessions
+// survive a reboot. The log is a run of fixed-size segment files
+// (/log/seg00012.bin), each a sequence of checksummed frames:
+//   LogFrameHead | payload   BEGIN = CaptureHeader, RECORD = one capture
+//                            record, END = u32 record count
+// Frames are batched in a sector-sized buffer and written so each write ends
+// on a sector boundary. Past CAPLOG_MAX_SEGMENTS the oldest segment is
+// deleted along with the sessions that start in it. /log/index.bin lists
+// the sessions and is replaced through a temp file and a rename. A session
+// cut short by a reset has no END frame; boot recovers it up to its last
+// intact frame. Downloads rebuild the plain capture format frame by frame,
+// so tools/decode_capture.py reads them unchanged.
+
+static const uint16_t LOG_FRAME_MAGIC = 0x4C4F;       // "OL"
+static const uint32_t LOG_INDEX_MAGIC = 0x31584C4F;   // "OLX1"
+static const uint16_t LOG_INDEX_VERSION = 1;
+
+static const uint8_t LOG_SESSION_COMPLETE = 0x01;
+static const uint8_t LOG_SESSION_PARTIAL = 0x02;      // no END frame (reset or write error)
+
+enum class LogFrame : uint8_t { BEGIN = 1, RECORD = 2, END = 3 };
+
+struct __attribute__((packed)) LogFrameHead {
+    uint16_t magic;
+    uint8_t type;             // LogFrame
+    uint8_t reserved;
+    uint32_t session;
+    uint16_t len;             // payload bytes
+    uint32_t check;           // FNV-1a of the payload
+};
+
+struct __attribute__((packed)) LogSession {
+    uint32_t id;
+    uint32_t startSeg;
+    uint32_t startOff;        // BEGIN frame offset in startSeg
+    uint32_t bytes;           // frame bytes, BEGIN through END
+    uint32_t records;
+    uint32_t uptimeS;         // at session start
+    uint16_t boot;            // boot counter; there is no wall clock
+    uint8_t mode;             // BaselineMode
+    uint8_t flags;            // LOG_SESSION_*
+};
+
+struct __attribute__((packed)) LogIndexHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;
+    uint16_t boot;
+    uint16_t reserved;
+    uint32_t nextId;
+};
+
+struct CaptureLog {
+    bool ready;
+    uint16_t boot;
+    uint32_t nextId;
+    uint32_t segFirst;        // oldest segment on flash
+    uint32_t segNext;         // number of the next segment
+    File seg;                 // segment being appended to
+    uint32_t segNum;
+    uint32_t segBytes;        // written to `seg`
+    uint8_t* buf;             // CAPLOG_WRITE_BYTES, PSRAM
+    uint16_t bufLen;
+    uint32_t openId;          // session being written (frame tag)
+    LogSession sessions[Config::CAPLOG_MAX_SESSIONS];
+    uint16_t sessionCount;
+    uint32_t sectorWrites;
+    uint32_t writeErrors;
+    uint32_t segmentsDropped;
+};
+
+static CaptureLog capLog;
+static SemaphoreHandle_t logMutex = nullptr;
+
+inline void logSegPath(uint32_t n, char* out, size_t cap) {
+    snprintf(out, cap, "%s/seg%05u.bin", Config::CAPLOG_DIR, (unsigned)n);
+}
+
+// Caller holds logMutex (or is setup())
+bool logSaveIndexLocked() {
+    File f = LittleFS.open(Config::CAPLOG_INDEX_TMP_PATH, FILE_WRITE);
+    if (!f) {
+        Serial.println("[ERROR] Failed to open capture log index");
+        return false;
+    }
+    LogIndexHeader hdr = {LOG_INDEX_MAGIC, LOG_INDEX_VERSION, capLog.sessionCount,
+                          capLog.boot, 0, capLog.nextId};
+    const size_t n = capLog.sessionCount * sizeof(LogSession);
+    bool ok = f.write((const uint8_t*)&hdr, sizeof(hdr)) == sizeof(hdr) &&
+              f.write((const uint8_t*)capLog.sessions, n) == n;
+    f.close();
+    if (!ok) {
+        Serial.println("[ERROR] Short write on capture log index");
+        LittleFS.remove(Config::CAPLOG_INDEX_TMP_PATH);
+        return false;
+    }
+    // littlefs renames over an existing file atomically
+    return LittleFS.rename(Config::CAPLOG_INDEX_TMP_PATH, Config::CAPLOG_INDEX_PATH);
+}
+
+bool logLoadIndex(const char* path, LogIndexHeader& hdr) {
+    File f = LittleFS.open(path, FILE_READ);
+    if (!f) return false;
+    bool ok = f.read((uint8_t*)&hdr, sizeof(hdr)) == sizeof(hdr) &&
+              hdr.magic == LOG_INDEX_MAGIC && hdr.version == LOG_INDEX_VERSION &&
+              hdr.count <= Config::CAPLOG_MAX_SESSIONS;
+    const size_t n = ok ? hdr.count * sizeof(LogSession) : 0;
+    ok = ok && f.read((uint8_t*)capLog.sessions, n) == n;
+    f.close();
+    capLog.sessionCount = ok ? hdr.count : 0;
+    return ok;
+}
+
+LogSession* logFindLocked(uint32_t id) {
+    for (uint16_t i = 0; i < capLog.sessionCount; i++) {
+        if (capLog.sessions[i].id == id) return &capLog.sessions[i];
+    }
+    return nullptr;
+}
+
+// Reads one frame; `payload` must hold CAPTURE_RECORD_MAX bytes.
+// False at the end of the data or on a torn or damaged frame.
+bool logReadFrame(File& f, LogFrameHead& head, uint8_t* payload) {
+    if (f.read((uint8_t*)&head, sizeof(head)) != sizeof(head)) return false;
+    if (head.magic != LOG_FRAME_MAGIC || head.len > CAPTURE_RECORD_MAX) return false;
+    if (f.read(payload, head.len) != head.len) return false;
+    return fnv1a(2166136261u, payload, head.len) == head.check;
+}
+
+// Walks one session's frames, following it into later segments
+struct LogCursor {
+    File f;
+    uint32_t seg;
+    uint32_t session;
+};
+
+bool logCursorOpen(LogCursor& c, const LogSession& s) {
+    char path[32];
+    logSegPath(s.startSeg, path, sizeof(path));
+    c.f = LittleFS.open(path, FILE_READ);
+    c.seg = s.startSeg;
+    c.session = s.id;
+    return c.f && c.f.seek(s.startOff);
+}
+
+bool logCursorNext(LogCursor& c, LogFrameHead& head, uint8_t* payload) {
+    while (c.f) {
+        if (c.f.position() + sizeof(head) <= c.f.size()) {
+            return logReadFrame(c.f, head, payload) && head.session == c.session;
+        }
+        c.f.close();
+        if (++c.seg >= capLog.segNext) return false;
+        char path[32];
+        logSegPath(c.seg, path, sizeof(path));
+        c.f = LittleFS.open(path, FILE_READ);
+    }
+    return false;
+}
+
+// Caller holds logMutex. Writes the buffer and syncs the file.
+bool logFlushLocked() {
+    if (!capLog.bufLen) return true;
+    const bool ok = capLog.seg && capLog.seg.write(capLog.buf, capLog.bufLen) == capLog.bufLen;
+    if (ok) {
+        capLog.seg.flush();
+        capLog.segBytes += capLog.bufLen;
+        capLog.sectorWrites++;
+    } else {
+        capLog.writeErrors++;
+        Serial.println("[ERROR] Short write on capture log segment");
+    }
+    capLog.bufLen = 0;
+    return ok;
+}
+
+// Caller holds logMutex. Deletes segments over the cap and forgets the
+// sessions that started in them.
+void logRotateLocked() {
+    while (capLog.segNext - capLog.segFirst > Config::CAPLOG_MAX_SEGMENTS) {
+        char path[32];
+        logSegPath(capLog.segFirst, path, sizeof(path));
+        LittleFS.remove(path);
+        capLog.segFirst++;
+        capLog.segmentsDropped++;
+    }
+    uint16_t kept = 0;
+    for (uint16_t i = 0; i < capLog.sessionCount; i++) {
+        if (capLog.sessions[i].startSeg >= capLog.segFirst) capLog.sessions[kept++] = capLog.sessions[i];
+    }
+    capLog.sessionCount = kept;
+}
+
+bool logOpenSegmentLocked() {
+    bool ok = logFlushLocked();
+    if (capLog.seg) capLog.seg.close();
+    capLog.segNum = capLog.segNext++;
+    capLog.segBytes = 0;
+    logRotateLocked();
+    
+    char path[32];
+    logSegPath(capLog.segNum, path, sizeof(path));
+    capLog.seg = LittleFS.open(path, FILE_WRITE);
+    if (!capLog.seg) {
+        capLog.writeErrors++;
+        Serial.printf("[ERROR] Failed to open %s\n", path);
+        return false;
+    }
+    return ok;
+}
+
+// Fills the buffer up to the next sector boundary of the segment, so
+// every full write covers whole sectors
+bool logBufferLocked(const uint8_t* p, size_t n) {
+    while (n) {
+        const size_t inSector = (capLog.segBytes + capLog.bufLen) % Config::CAPLOG_WRITE_BYTES;
+        const size_t take = std::min(n, (size_t)Config::CAPLOG_WRITE_BYTES - inSector);
+        memcpy(capLog.buf + capLog.bufLen, p, take);
+        capLog.bufLen += take;
+        p += take;
+        n -= take;
+        if (inSector + take == Config::CAPLOG_WRITE_BYTES && !logFlushLocked()) return false;
+    }
+    return true;
+}
+
+// Starts a new segment first when the frame wouldn't fit; frames never span segments
+bool logAppendLocked(LogFrame type, const uint8_t* payload, uint16_t len, uint32_t& bytes) {
+    LogFrameHead head;
+    head.magic = LOG_FRAME_MAGIC;
+    head.type = (uint8_t)type;
+    head.reserved = 0;
+    head.session = capLog.openId;
+    head.len = len;
+    head.check = fnv1a(2166136261u, payload, len);
+    
+    const uint32_t frameLen = sizeof(head) + len;
+    if (!capLog.seg || capLog.segBytes + capLog.bufLen + frameLen > Config::CAPLOG_SEGMENT_BYTES) {
+        if (!logOpenSegmentLocked()) return false;
+    }
+    bytes += frameLen;
+    return logBufferLocked((const uint8_t*)&head, sizeof(head)) && logBufferLocked(payload, len);
+}
+
+// Counts what survived of a session that never logged its END frame
+void logRecoverSession(LogSession& s, uint8_t* scratch) {
+    LogCursor c;
+    LogFrameHead head;
+    s.records = 0;
+    s.bytes = 0;
+    if (logCursorOpen(c, s)) {
+        while (logCursorNext(c, head, scratch)) {
+            s.bytes += sizeof(head) + head.len;
+            if (head.type == (uint8_t)LogFrame::RECORD) s.records++;
+            if (head.type == (uint8_t)LogFrame::END) {
+                s.flags = LOG_SESSION_COMPLETE;
+                return;
+            }
+        }
+    }
+    s.flags = LOG_SESSION_PARTIAL;
+}
+
+// After watchlistInit(), which mounts LittleFS
+void captureLogInit() {
+    if (!watchlist.fsReady) return;
+    logMutex = xSemaphoreCreateMutex();
+    capLog.buf = (uint8_t*)psramAlloc(Config::CAPLOG_WRITE_BYTES);
+    uint8_t* scratch = (uint8_t*)malloc(CAPTURE_RECORD_MAX);
+    if (!logMutex || !capLog.buf || !scratch) {
+        Serial.println("[ERROR] Failed to allocate capture log");
+        free(scratch);
+        return;
+    }
+    LittleFS.mkdir(Config::CAPLOG_DIR);
+    
+    bool any = false;
+    uint32_t lo = UINT32_MAX, hi = 0;
+    File dir = LittleFS.open(Config::CAPLOG_DIR);
+    for (File e = dir.openNextFile(); e; e = dir.openNextFile()) {
+        unsigned n;
+        if (sscanf(e.name(), "seg%u.bin", &n) != 1) continue;
+        any = true;
+        lo = std::min(lo, (uint32_t)n);
+        hi = std::max(hi, (uint32_t)n);
+    }
+    dir.close();
+    capLog.segFirst = any ? lo : 0;
+    capLog.segNext = any ? hi + 1 : 0;
+    
+    LogIndexHeader hdr = {};
+    if (!logLoadIndex(Config::CAPLOG_INDEX_PATH, hdr) &&
+        !logLoadIndex(Config::CAPLOG_INDEX_TMP_PATH, hdr)) {
+        hdr = LogIndexHeader();
+        hdr.nextId = 1;
+    }
+    capLog.boot = hdr.boot + 1;
+    capLog.nextId = hdr.nextId ? hdr.nextId : 1;
+    logRotateLocked();
+    
+    uint16_t recovered = 0;
+    for (uint16_t i = 0; i < capLog.sessionCount; i++) {
+        LogSession& s = capLog.sessions[i];
+        if (s.flags & (LOG_SESSION_COMPLETE | LOG_SESSION_PARTIAL)) continue;
+        logRecoverSession(s, scratch);
+        recovered++;
+    }
+    free(scratch);
+    
+    // Each boot appends to a fresh segment, opened by the first session
+    logSaveIndexLocked();
+    capLog.ready = true;
+    Serial.printf("[CAPLOG] %u sessions in segments %u-%u, boot %u, %u recovered\n",
+                  capLog.sessionCount, (unsigned)capLog.segFirst, (unsigned)capLog.segNext,
+                  capLog.boot, recovered);
+}
+
+// Runs on the baseline task after publishing, like saveCaptureFile, so the
+// table is walked without resultsMutex
+bool captureLogSession(const DeviceTable& table, const BaselineConfig& config) {
+    if (!capLog.ready) return false;
+    if (xSemaphoreTake(logMutex, pdMS_TO_TICKS(1000)) != pdTRUE) {
+        Serial.println("[ERROR] Failed to acquire capture log mutex");
+        return false;
+    }
+    const uint32_t t0 = millis();
+    
+    // The entry table is bounded; the oldest session's data ages out with its segment
+    if (capLog.sessionCount == Config::CAPLOG_MAX_SESSIONS) {
+        memmove(capLog.sessions, capLog.sessions + 1, (capLog.sessionCount - 1) * sizeof(LogSession));
+        capLog.sessionCount--;
+    }
+    
+    uint8_t rec[CAPTURE_RECORD_MAX];
+    size_t n = encodeCaptureHeader(config, millis(), table.count, rec);
+    bool ok = true;
+    if (!capLog.seg || capLog.segBytes + capLog.bufLen + sizeof(LogFrameHead) + n > Config::CAPLOG_SEGMENT_BYTES) {
+        ok = logOpenSegmentLocked();
+    }
+    
+    const uint32_t id = capLog.nextId++;
+    capLog.openId = id;
+    LogSession& entry = capLog.sessions[capLog.sessionCount++];
+    entry.id = id;
+    entry.startSeg = capLog.segNum;
+    entry.startOff = capLog.segBytes + capLog.bufLen;
+    entry.bytes = 0;
+    entry.records = 0;
+    entry.uptimeS = millis() / 1000;
+    entry.boot = capLog.boot;
+    entry.mode = (uint8_t)config.mode;
+    entry.flags = 0;
+    
+    // The index names the session before its records land, so a reset
+    // mid-write leaves something boot can recover
+    uint32_t bytes = 0;
+    ok = ok && logAppendLocked(LogFrame::BEGIN, rec, n, bytes) && logFlushLocked() && logSaveIndexLocked();
+    
+    uint32_t records = 0;
+    for (uint32_t slot = 0; ok && slot < table.capacity; ++slot) {
+        if (!table.used(slot)) continue;
+        n = encodeCaptureRecord(table, slot, rec);
+        ok = logAppendLocked(LogFrame::RECORD, rec, n, bytes);
+        records++;
+        if ((slot & 0xFF) == 0) esp_task_wdt_reset();
+    }
+    ok = ok && logAppendLocked(LogFrame::END, (const uint8_t*)&records, sizeof(records), bytes) &&
+         logFlushLocked();
+    
+    // Rotation during a huge session can drop the session's own start
+    LogSession* s = logFindLocked(id);
+    if (s) {
+        s->bytes = bytes;
+        s->records = records;
+        s->flags = ok ? LOG_SESSION_COMPLETE : LOG_SESSION_PARTIAL;
+    }
+    logSaveIndexLocked();
+    capLog.openId = 0;
+    xSemaphoreGive(logMutex);
+    
+    if (!s) {
+        Serial.printf("[CAPLOG] Session %u outgrew the log and was dropped\n", (unsigned)id);
+        return false;
+    }
+    Serial.printf("[CAPLOG] Session %u: %u records, %u bytes in %u ms%s\n", (unsigned)id,
+                  (unsigned)records, (unsigned)bytes, (unsigned)(millis() - t0), ok ? "" : " (partial)");
+    return ok;
+}
+
+String renderCaptureLogJson() {
+    if (!capLog.ready) return String("{\"ready\":false,\"sessions\":[]}");
+    if (xSemaphoreTake(logMutex, pdMS_TO_TICKS(200)) != pdTRUE) return String();
+    
+    static const char* const MODE_KEYS[] = {"wifi", "ble", "both"};
+    String json;
+    json.reserve(160 + capLog.sessionCount * 110);
+    json += "{\"ready\":true,\"boot\":" + String(capLog.boot);
+    json += ",\"segments\":" + String(capLog.segNext - capLog.segFirst);
+    json += ",\"max_segments\":" + String(Config::CAPLOG_MAX_SEGMENTS);
+    json += ",\"segment_bytes\":" + String(Config::CAPLOG_SEGMENT_BYTES);
+    json += ",\"sector_writes\":" + String(capLog.sectorWrites);
+    json += ",\"write_errors\":" + String(capLog.writeErrors);
+    json += ",\"segments_dropped\":" + String(capLog.segmentsDropped);
+    json += ",\"sessions\":[";
+    // Newest first
+    for (uint16_t i = capLog.sessionCount; i-- > 0; ) {
+        const LogSession& s = capLog.sessions[i];
+        if (i + 1 != capLog.sessionCount) json += ",";
+        json += "{\"id\":" + String(s.id);
+        json += ",\"boot\":" + String(s.boot);
+        json += ",\"uptime_s\":" + String(s.uptimeS);
+        json += ",\"mode\":\"" + String(s.mode < 3 ? MODE_KEYS[s.mode] : "?") + "\"";
+        json += ",\"records\":" + String(s.records);
+        json += ",\"bytes\":" + String(s.bytes);
+        json += ",\"state\":\"";
+        json += (s.flags & LOG_SESSION_COMPLETE) ? "complete" : "partial";
+        json += "\"}";
+    }
+    json += "]}";
+    
+    xSemaphoreGive(logMutex);
+    return json;
+}
+
+// Streams one session as a plain capture file: the BEGIN header (record
+// count patched in), then the RECORD payloads, until END or damage
+struct LogStream {
+    LogCursor cur;
+    uint32_t records;
+    bool started;
+    bool done;
+    size_t len;
+    size_t off;
+    uint8_t frame[CAPTURE_RECORD_MAX];
+};
+
+size_t logStreamFill(LogStream& st, uint8_t* buffer, size_t maxLen) {
+    size_t out = 0;
+    while (out < maxLen && !st.done) {
+        if (st.off < st.len) {
+            const size_t take = std::min(maxLen - out, st.len - st.off);
+            memcpy(buffer + out, st.frame + st.off, take);
+            st.off += take;
+            out += take;
+            continue;
+        }
+        
+        LogFrameHead head;
+        if (!logCursorNext(st.cur, head, st.frame) || head.type == (uint8_t)LogFrame::END ||
+            st.started != (head.type == (uint8_t)LogFrame::RECORD)) {
+            st.done = true;
+            break;
+        }
+        if (!st.started) {
+            if (head.len < sizeof(CaptureHeader)) {
+                st.done = true;
+                break;
+            }
+            CaptureHeader hdr;
+            memcpy(&hdr, st.frame, sizeof(hdr));
+            hdr.recordCount = st.records;
+            memcpy(st.frame, &hdr, sizeof(hdr));
+            st.started = true;
+        }
+        st.len = head.len;
+        st.off = 0;
+    }
+    return out;
+}
+
+// ================================
+// RESULTS STREAMING (chunked HTTP)
+// ================================
+// Each download walks one page of the result rows and renders one device at
+// a time into a small pending buffer, so peak memory is one row, not a
+// document. Fill callbacks run on the async_tcp task and hold resultsMutex
+// only while copying a chunk. A stream is tied to the generation it started
+// on; if a new baseline is published mid-download the response simply ends there.
+
+enum class ResultsDoc : uint8_t { CSV, TXT, HTML, BIN };
+
+// ?offset=&limit=&sort= on the results routes. The published order is paged
+// in place; any other order sorts slot indices into `own`, only as far as
+// the end of the page.
+struct ResultsPage {
+    ResultsSort sort;        // COUNT = published order
+    uint32_t offset;
+    uint32_t limit;          // 0 = to the end
+    bool resolved;
+    bool custom;
+    size_t begin;
+    size_t end;
+    size_t total;
+    std::vector<uint32_t> own;
+    
+    ResultsPage() : sort(ResultsSort::COUNT), offset(0), limit(0), resolved(false), custom(false),
+                    begin(0), end(0), total(0) {}
+    
+    const std::vector<uint32_t>& rows() const { return custom ? own : enhancedResultsRows; }
+    bool paged() const { return begin > 0 || end < total; }
+};
+
+void parseResultsPage(AsyncWebServerRequest* req, uint32_t defaultLimit, ResultsPage& page) {
+    page.limit = defaultLimit;
+    if (req->hasParam("offset")) page.offset = strtoul(req->getParam("offset")->value().c_str(), nullptr, 10);
+    if (req->hasParam("limit")) page.limit = strtoul(req->getParam("limit")->value().c_str(), nullptr, 10);
+    if (req->hasParam("sort")) page.sort = parseResultsSort(req->getParam("sort")->value(), ResultsSort::COUNT);
+}
+
+// Caller holds resultsMutex with resultsTable published
+void resolveResultsPage(ResultsPage& page) {
+    if (page.sort == ResultsSort::COUNT) page.sort = resultsSummary.config.sortKey;
+    page.custom = page.sort != resultsSummary.config.sortKey;
+    page.total = enhancedResultsRows.size();
+    page.begin = page.offset < page.total ? page.offset : page.total;
+    page.end = (page.limit && page.total - page.begin > page.limit) ? page.begin + page.limit : page.total;
+    if (page.custom) {
+        collectResultRows(*resultsTable, page.sort, page.own, page.end);
+        page.own.resize(page.end);   // rows past the page were never ordered
+    }
+    page.resolved = true;
+}
+
+// Query string for another page of the same view
+String resultsPageQuery(const ResultsPage& page, size_t offset, ResultsSort sort) {
+    return "?offset=" + String((unsigned)offset) + "&limit=" + String((unsigned)page.limit) +
+           "&sort=" + String(RESULTS_SORT_KEYS[(size_t)sort]);
+}
+
+// "Rows a–b of n", prev/next and the sort keys, linking to `path`
+void appendResultsPager(String& out, const char* path, const ResultsPage& page) {
+    out += "<div class='actions'>Rows " + String((unsigned)(page.end > page.begin ? page.begin + 1 : page.begin)) +
+           "&ndash;" + String((unsigned)page.end) + " of " + String((unsigned)page.total);
+    if (page.begin > 0) {
+        const size_t prev = (page.limit && page.begin > page.limit) ? page.begin - page.limit : 0;
+        out += " <a class='btn' href='" + String(path) + resultsPageQuery(page, prev, page.sort) + "'>&lsaquo; Prev</a>";
+    }
+    if (page.end < page.total) {
+        out += " <a class='btn' href='" + String(path) + resultsPageQuery(page, page.end, page.sort) + "'>Next &rsaquo;</a>";
+    }
+    out += " &nbsp;Sort:";
+    for (size_t k = 0; k < (size_t)ResultsSort::COUNT; k++) {
+        if ((ResultsSort)k == page.sort) {
+            out += " <b>" + String(RESULTS_SORT_KEYS[k]) + "</b>";
+        } else {
+            out += " <a class='link' href='" + String(path) + resultsPageQuery(page, 0, (ResultsSort)k) + "'>" +
+                   String(RESULTS_SORT_KEYS[k]) + "</a>";
         }
     }
-};
-
-static FoxBLECallbacks foxBleCb;
+    out += "</div>";
+}
 
-struct FoxParams {
-    DetectionMode mode;
-    bool stealth;
+struct ResultsStream {
+    ResultsDoc doc;
+    uint32_t generation;
+    uint8_t phase;
+    size_t row;
+    ResultsPage page;
+    String pending;
+    size_t pendingOff;
+    uint8_t bin[CAPTURE_RECORD_MAX];   // BIN documents render here instead of `pending`
+    size_t binLen;
+    
+    ResultsStream(ResultsDoc d, uint32_t gen) : doc(d), generation(gen), phase(0),
+                                                row(0), pendingOff(0), binLen(0) {}
 };
 
-void foxHuntTask(void* pv) {
-    FoxParams* pParams = (FoxParams*)pv;
-    FoxParams params = *pParams;
-    delete pParams;
-    
-    stealthMode = params.stealth;
-    runMode = RunMode::FOXHUNT;
-    
-    if (xSemaphoreTake(detectMutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
-        foxState.reset();
-        foxState.running = true;
-        detectState.running = true;
-        xSemaphoreGive(detectMutex);
+void appendHtmlRow(String& out, const DeviceTable& table, uint32_t slot, bool capturePayload) {
+    const String macP = macPrettyU64(table.macAt(slot));
+    const String oui  = macP.substring(0, 8);
+    const String dev  = macP.substring(9);
+    const DeviceRecord& obs = table.hot[slot];
+    const WiFiMeta& meta = table.wifi[slot];
+    const wifi_auth_mode_t authMode = (wifi_auth_mode_t)meta.authMode;
+    const bool hasWiFiMeta = obs.flags & DEV_HAS_WIFI_META;
+    const char* src = deviceSource(obs);
+    const char* nm  = obs.nameRef ? table.name(slot) : "UNKNOWN";
+    
+    out += "<tr><td>"
+           "<a class='link' href='/append_filter?v=" + oui + "'>" + oui + "</a>:"
+           "<a class='link' href='/append_filter?v=" + macP + "'>" + dev + "</a>"
+           "</td><td>" + String(src) + "</td><td>" +
+           rssiCellHtmlEnhanced(obs) + "</td><td>";
+    
+    if (hasWiFiMeta) {
+        out += String(meta.channel) + " / " + String(getBandFromChannel(meta.channel));
+    } else {
+        out += "<span class='dim'>BLE</span>";
     }
-    
-    Serial.println("[HUNT] Starting (BLE-only, using Detection Filters)");
-    
-    dropWiFiAP();
-    
-    NimBLEDevice::init("");
-    NimBLEDevice::setPower(ESP_PWR_LVL_P9);
-    
-    NimBLEScan* bleScan = NimBLEDevice::getScan();
-    if (!bleScan) {
-        Serial.println("[ERROR] Failed to get BLE scan object");
-        vTaskDelete(nullptr);
-        return;
+    out += "</td><td>";
+    
+    if (hasWiFiMeta) {
+        // Colour-code encryption
+        const char* enc = getEncryptionType(authMode);
+        const char* cls = "enc-good";
+        if (authMode == WIFI_AUTH_OPEN)    cls = "enc-open";
+        else if (authMode == WIFI_AUTH_WEP || authMode == WIFI_AUTH_WPA_PSK) cls = "enc-weak";
+        else if (authMode == WIFI_AUTH_WPA3_PSK || authMode == WIFI_AUTH_WPA2_WPA3_PSK) cls = "enc-great";
+        out += "<span class='" + String(cls) + "'>" + String(enc) + "</span>";
+    } else {
+        out += "-";
     }
+    out += "</td><td>";
     
-    bleScan->setAdvertisedDeviceCallbacks(&foxBleCb, false);
-    bleScan->setInterval(Config::BLE_FAST_SCAN_INTERVAL);
-    bleScan->setWindow(Config::BLE_FAST_SCAN_WINDOW);
-    bleScan->setActiveScan(true);
-    bleScan->setDuplicateFilter(false);
+    if (hasWiFiMeta && authMode != WIFI_AUTH_OPEN) {
+        out += getCipherType((wifi_cipher_type_t)meta.pairwiseCipher);
+    } else {
+        out += "-";
+    }
+    out += "</td><td>" + htmlEscape(String(nm)) + "</td>";
     
-    if (!bleScan->start(0, nullptr, false)) {
-        Serial.println("[ERROR] BLE scan start failed");
-        vTaskDelete(nullptr);
-        return;
+    if (capturePayload) {
+        out += (obs.flags & DEV_HAS_PAYLOAD)
+            ? "<td>" + String(obs.payloadLength) + "B</td>"
+            : String("<td>-</td>");
     }
+    out += "</tr>";
+}
+
+void appendHtmlHead(String& out, const ResultsSummary& sum, const ResultsPage& page) {
+    out += F(
+        "<!DOCTYPE html><html><head><meta charset='utf-8'>"
+        "<title>Enhanced Baseline Results</title>"
+        "<meta name='viewport' content='width=device-width, initial-scale=1'>"
+        "<link rel='stylesheet' href='");
+    out += WEB_STYLE_CSS_URL;
+    out += F("'></head><body><div class='card wide'>"
+        "<h1>Enhanced Baseline Results</h1>"
+    );
     
-    Serial.println("[HUNT] BLE scan active");
-    foxBuzzerInit();
+    out += "<div class='info'>";
+    out += "<strong>Scan Settings:</strong> ";
+    out += "RSSI &gt;= " + String(sum.config.rssiThreshold) + " dBm &nbsp;|&nbsp; ";
+    out += "Duration: " + String(sum.config.durationSecs) + "s &nbsp;|&nbsp; ";
+    out += "Wi-Fi APs: " + String(sum.wifiCount) + " &nbsp;|&nbsp; ";
+    out += "BLE Devices: " + String(sum.bleCount);
+    if (sum.bleLogical != sum.bleCount) out += " (~" + String(sum.bleLogical) + " physical)";
+    if (sum.config.capturePayload) out += " (" + String(sum.bleWithPayload) + " with payloads)";
+    out += "</div>";
+    appendResultsPager(out, "/baseline_results", page);
     
-    for (;;) {
-        esp_task_wdt_reset();
-        
-        if (foxState.startBeepsPending) {
-            foxState.startBeepsPending = false;
-            foxThreeBeeps();
-        }
-        
-        handleFoxProximityBeeping();
-        vTaskDelay(pdMS_TO_TICKS(10));
+    // Table header — conditional columns
+    out += "<table class='grid'><tr><th>MAC</th><th>Source</th><th>RSSI</th>"
+           "<th>Ch / Band</th><th>Encryption</th><th>Pairwise</th><th>Name</th>";
+    if (sum.config.capturePayload) out += "<th>Payload</th>";
+    out += "</tr>";
+    
+    if (page.total == 0) {
+        out += F("<tr><td colspan='8'>No devices observed.</td></tr>");
+    } else if (page.begin == page.end) {
+        out += F("<tr><td colspan='8'>No rows past this offset.</td></tr>");
     }
 }
 
-// ================================
-// ENHANCED BASELINE SCANNING
-// ================================
-
-class EnhancedBLECollector : public NimBLEAdvertisedDeviceCallbacks {
-public:
-    std::map<String, ObservedEnhanced> entries;
-    SemaphoreHandle_t mutex;
-    BaselineConfig config;
-    size_t payloadMemoryUsed;
-    uint16_t devicesWithPayload;
+void appendHtmlFoot(String& out, const ResultsSummary& sum, const ResultsPage& page) {
+    // Downloads carry every row, in the order being viewed
+    const String order = page.custom ? "?sort=" + String(RESULTS_SORT_KEYS[(size_t)page.sort]) : String();
+    out += F("</table>");
+    if (page.paged()) appendResultsPager(out, "/baseline_results", page);
+    out += "<div class='actions'>"
+           "<a class='btn' href='/'>Home</a> "
+           "<a class='btn' href='/baseline_results.csv" + order + "'>Download CSV</a> "
+           "<a class='btn' href='/baseline_results.bin" + order + "'>Download Binary</a>";
     
-    EnhancedBLECollector(const BaselineConfig& cfg) : config(cfg), 
-                                                       payloadMemoryUsed(0), 
-                                                       devicesWithPayload(0) {
-        mutex = xSemaphoreCreateMutex();
+    // Show detailed report link whenever there is Wi-Fi OR BLE payload data
+    if (sum.wifiCount > 0 || (sum.config.capturePayload && sum.bleWithPayload > 0)) {
+        out += " <a class='btn' href='/baseline_results_detailed.txt" + order + "'>Download Detailed Report</a>";
     }
     
-    ~EnhancedBLECollector() {
-        if (mutex) {
-            vSemaphoreDelete(mutex);
-        }
+    out += F("</div></div></body></html>");
+}
+
+void appendTxtHead(String& out, const ResultsSummary& sum, const ResultsPage& page) {
+    out += "OUI-SPY ENHANCED BASELINE REPORT\n";
+    out += "Generated: " + String(sum.builtMs / 1000) + "s since boot\n";
+    out += "Scan Duration: " + String(sum.config.durationSecs) + " seconds\n";
+    out += "RSSI Threshold: >= " + String(sum.config.rssiThreshold) + " dBm\n";
+    out += "Sorted By: " + String(RESULTS_SORT_KEYS[(size_t)page.sort]) + "\n";
+    out += "Payload Capture: " + String(sum.config.capturePayload ? "Enabled" : "Disabled") + "\n";
+    out += "Total Devices: " + String((unsigned)page.total) + "\n";
+    if (page.paged()) {
+        out += "Rows: " + String((unsigned)page.begin + 1) + "-" + String((unsigned)page.end) + "\n";
     }
-    
-    void onResult(NimBLEAdvertisedDevice* dev) override {
-        String macNo = toUpperNoDelim(String(dev->getAddress().toString().c_str()));
-        if (macNo.length() != 12) return;
-        
-        int rssi = dev->getRSSI();
-        
-        // Apply RSSI threshold filter
-        if (rssi < config.rssiThreshold) {
-            return;
-        }
-        
-        if (xSemaphoreTake(mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-            ObservedEnhanced &o = entries[macNo];
-            safeCopy(o.source, sizeof(o.source), "BLE");
-            setBestRssiEnhanced(o, rssi);
-            
-            o.addrType = dev->getAddressType();
+    out += "Wi-Fi APs:    " + String(sum.wifiCount) + "\n";
+    out += "BLE Devices:  " + String(sum.bleCount) + " (" + String(sum.bleWithPayload) + " with payloads)\n";
+    out += "BLE Logical:  " + String(sum.bleLogical) + " (rotating addresses merged)\n\n";
+}
+
+// Advances st.row to the next row with any of `flags` set and renders it.
+// Returns false (and rewinds st.row to the page start) once the page is exhausted.
+bool nextFlaggedRow(ResultsStream& st, const DeviceTable& table, uint8_t flags) {
+    while (st.row < st.page.end) {
+        const uint32_t slot = st.page.rows()[st.row++];
+        if (!(table.hot[slot].flags & flags)) continue;
+        st.pending = (flags == DEV_WIFI) ? generateWiFiDeviceReport(table, slot)
+                                         : generateDeviceReport(table, slot);
+        return true;
+    }
+    st.row = st.page.begin;
+    return false;
+}
+
+// Renders the next piece of the document into st.pending. Returns false when done.
+bool resultsStreamNext(ResultsStream& st, const DeviceTable& table) {
+    const ResultsSummary& sum = resultsSummary;
+    const bool payloads = sum.config.capturePayload;
+    
+    switch (st.doc) {
+        case ResultsDoc::CSV:
+            if (st.phase == 0) {
+                appendCsvHeader(st.pending, payloads);
+                st.phase = 1;
+                return true;
+            }
+            if (st.row < st.page.end) {
+                appendCsvRow(st.pending, table, st.page.rows()[st.row++], payloads);
+                return true;
+            }
+            return false;
             
-            if (dev->haveName()) {
-                String nm = String(dev->getName().c_str());
-                if (nm.length() > 0) {
-                    safeCopy(o.name, sizeof(o.name), nm);
+        case ResultsDoc::HTML:
+            if (st.phase == 0) {
+                st.pending.reserve(3072);
+                appendHtmlHead(st.pending, sum, st.page);
+                st.phase = 1;
+                return true;
+            }
+            if (st.phase == 1) {
+                if (st.row < st.page.end) {
+                    appendHtmlRow(st.pending, table, st.page.rows()[st.row++], payloads);
+                    return true;
                 }
+                appendHtmlFoot(st.pending, sum, st.page);
+                st.phase = 2;
+                return true;
             }
+            return false;
             
-            // Capture payload if enabled and memory permits
-            if (config.capturePayload && !o.hasPayload) {
-                if (devicesWithPayload < Config::MAX_PAYLOAD_DEVICES &&
-                    payloadMemoryUsed < Config::MAX_PAYLOAD_MEMORY) {
-                    
-                    uint8_t* payload = dev->getPayload();
-                    uint8_t payloadLen = dev->getPayloadLength();
-                    
-                    if (payloadLen > 0 && payloadLen <= Config::MAX_PAYLOAD_SIZE) {
-                        memcpy(o.payloadData, payload, payloadLen);
-                        o.payloadLength = payloadLen;
-                        o.hasPayload = true;
-                        
-                        payloadMemoryUsed += payloadLen;
-                        devicesWithPayload++;
-                        
-                        Serial.printf("[PAYLOAD] Captured %u bytes for %s (Total: %u/%u devices, %u/%u bytes)\n",
-                                      payloadLen, macNo.c_str(), devicesWithPayload, 
-                                      Config::MAX_PAYLOAD_DEVICES, payloadMemoryUsed, 
-                                      Config::MAX_PAYLOAD_MEMORY);
+        case ResultsDoc::BIN:
+            if (st.phase == 0) {
+                st.binLen = encodeCaptureHeader(sum.config, sum.builtMs,
+                                                st.page.end - st.page.begin, st.bin);
+                st.phase = 1;
+                return true;
+            }
+            if (st.row < st.page.end) {
+                st.binLen = encodeCaptureRecord(table, st.page.rows()[st.row++], st.bin);
+                return true;
+            }
+            return false;
+            
+        case ResultsDoc::TXT:
+            switch (st.phase) {
+                case 0:
+                    appendTxtHead(st.pending, sum, st.page);
+                    st.phase = 1;
+                    if (sum.wifiCount > 0) {
+                        st.pending += "################################################################################\n";
+                        st.pending += "#                          Wi-Fi ACCESS POINTS                                 #\n";
+                        st.pending += "################################################################################\n\n";
                     }
-                } else if (devicesWithPayload >= Config::MAX_PAYLOAD_DEVICES) {
-                    // Only log once when we hit the limit
-                    static bool limitLogged = false;
-                    if (!limitLogged) {
-                        Serial.println("[WARN] Payload device limit reached");
-                        limitLogged = true;
+                    return true;
+                case 1:
+                    if (sum.wifiCount > 0 && nextFlaggedRow(st, table, DEV_WIFI)) return true;
+                    st.phase = 2;
+                    if (payloads && sum.bleWithPayload > 0) {
+                        st.pending = "################################################################################\n";
+                        st.pending += "#                       BLE DEVICES (with payloads)                            #\n";
+                        st.pending += "################################################################################\n\n";
+                        return true;
                     }
-                }
+                    st.phase = 3;
+                    if (sum.bleCount > 0 && !payloads) {
+                        st.pending = "BLE devices found but payload capture was disabled.\n";
+                        st.pending += "Enable payload capture to see detailed BLE advertisement data.\n";
+                        return true;
+                    }
+                    return false;
+                case 2:
+                    if (nextFlaggedRow(st, table, DEV_HAS_PAYLOAD)) return true;
+                    st.phase = 3;
+                    return false;
+                default:
+                    return false;
             }
-            
-            xSemaphoreGive(mutex);
+    }
+    return false;
+}
+
+size_t resultsStreamFill(ResultsStream& st, uint8_t* buffer, size_t maxLen) {
+    const int64_t startUs = esp_timer_get_time();
+    if (!lockTake(LockId::RESULTS, resultsMutex, pdMS_TO_TICKS(50))) {
+        return RESPONSE_TRY_AGAIN;
+    }
+    
+    const bool binary = st.doc == ResultsDoc::BIN;
+    size_t written = 0;
+    while (written < maxLen) {
+        const size_t pendingLen = binary ? st.binLen : st.pending.length();
+        if (st.pendingOff >= pendingLen) {
+            st.pending = "";
+            st.binLen = 0;
+            st.pendingOff = 0;
+            if (!resultsTable || st.generation != resultsGeneration) break;
+            if (!st.page.resolved) {
+                resolveResultsPage(st.page);
+                st.row = st.page.begin;
+            }
+            if (!resultsStreamNext(st, *resultsTable)) break;
+            continue;
         }
+        const char* src = binary ? (const char*)st.bin : st.pending.c_str();
+        size_t n = pendingLen - st.pendingOff;
+        if (n > maxLen - written) n = maxLen - written;
+        memcpy(buffer + written, src + st.pendingOff, n);
+        st.pendingOff += n;
+        written += n;
     }
-};
+    
+    xSemaphoreGive(resultsMutex);
+    histRecordSince(metrics.resultsChunkUs, startUs);
+    return written;
+}
 
-void enhancedBaselineTask(void* pv) {
-    BaselineConfig* pConfig = (BaselineConfig*)pv;
-    BaselineConfig config = *pConfig;
-    delete pConfig;
+// Returns null (caller sends a fallback) when there are no published results.
+// HTML defaults to one page; downloads to every row.
+AsyncWebServerResponse* beginResultsStream(AsyncWebServerRequest* req, ResultsDoc doc, const char* type) {
+    if (!lockTake(LockId::RESULTS, resultsMutex, pdMS_TO_TICKS(500))) return nullptr;
+    const bool ready = resultsTable != nullptr;
+    const uint32_t gen = resultsGeneration;
+    xSemaphoreGive(resultsMutex);
+    if (!ready) return nullptr;
     
-    currentBaselineConfig = config;
-    baselineRunning = true;
-    currentPayloadMemory = 0;
+    std::shared_ptr<ResultsStream> st = std::make_shared<ResultsStream>(doc, gen);
+    parseResultsPage(req, doc == ResultsDoc::HTML ? Config::RESULTS_PAGE_LIMIT : 0, st->page);
+    return req->beginChunkedResponse(type, [st](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+        return resultsStreamFill(*st, buffer, maxLen);
+    });
+}
+
+void startEnhancedBaseline(BaselineConfig cfg) {
+    if (baselineRunning || benchRunning) {
+        Serial.println("[BASELINE] Already running");
+        return;
+    }
     
-    Serial.printf("[BASELINE-ENHANCED] Start mode=%d, secs=%u, RSSI>=%d, payload=%s\n", 
-                  (int)config.mode, config.durationSecs, config.rssiThreshold,
-                  config.capturePayload ? "ON" : "OFF");
+    if (cfg.durationSecs < 5) cfg.durationSecs = 5;
+    if (cfg.durationSecs > 600) cfg.durationSecs = 600;
+    if (cfg.snapshotSecs < Config::SURVEY_SNAPSHOT_MIN_SECS) cfg.snapshotSecs = Config::SURVEY_SNAPSHOT_MIN_SECS;
+    if (cfg.snapshotSecs > Config::SURVEY_SNAPSHOT_MAX_SECS) cfg.snapshotSecs = Config::SURVEY_SNAPSHOT_MAX_SECS;
+    if (cfg.rssiThreshold < -100) cfg.rssiThreshold = -100;
+    if (cfg.rssiThreshold > -10) cfg.rssiThreshold = -10;
+    if (cfg.dwellMs < Config::WIFI_SCAN_DWELL_MIN_MS) cfg.dwellMs = Config::WIFI_SCAN_DWELL_MIN_MS;
+    if (cfg.dwellMs > Config::WIFI_SCAN_DWELL_MAX_MS) cfg.dwellMs = Config::WIFI_SCAN_DWELL_MAX_MS;
     
-    EnhancedBLECollector bleCb(config);
-    NimBLEScan* bleScan = nullptr;
+    BaselineConfig* config = new BaselineConfig(cfg);
     
-    if (config.mode == BaselineMode::BLE_ONLY || config.mode == BaselineMode::WIFI_AND_BLE) {
-        NimBLEDevice::init("baseline");
-        
-        bleScan = NimBLEDevice::getScan();
-        if (!bleScan) {
-            Serial.println("[ERROR] Failed to get BLE scan object");
-            baselineRunning = false;
-            NimBLEDevice::deinit(true);
-            vTaskDelete(nullptr);
-            return;
+    if (!launchTask(TaskRole::BASELINE, enhancedBaselineTask, config)) {
+        delete config;
+    }
+}
+
+// ================================
+// BENCHMARK
+// ================================
+// Synthetic load for measuring the hot paths without a room full of
+// devices. Adverts go through the functions the NimBLE callbacks call
+// (detect, hunt, baseline), the real ring and the consumer task; AP records
+// go through recordWiFiAp(); then tables of 100 / 1k / 10k devices are
+// published and rendered as CSV and as the detailed report. Needs the radio
+// idle and keeps the AP up. The benchmark table is published while it runs
+// and unpublished afterwards, so the previous baseline results are gone.
+
+struct BenchParams {
+    uint32_t rate;           // adverts/s, 0 = as fast as BENCH_BATCH per tick allows
+    uint16_t uniques;        // distinct addresses
+    uint8_t payloadLen;
+    uint8_t hitPct;          // share of addresses that match the filters
+    uint8_t phaseSecs;
+};
+
+struct BenchIngest {
+    uint32_t offered;
+    uint32_t queued;         // accepted by the ring
+    uint32_t dropped;        // ring full
+    uint32_t matched;
+    uint32_t elapsedMs;
+    uint32_t drainMs;        // consumer catching up after the last report
+    uint32_t callbackNs;     // mean time per report in the callback path
+};
+
+struct BenchBuild {
+    uint32_t devices;
+    uint32_t fillMs;
+    uint32_t buildMs;
+    uint32_t csvMs;          // render time only, not the yields between chunks
+    uint32_t csvBytes;
+    uint32_t txtMs;
+    uint32_t txtBytes;
+};
+
+static const uint8_t BENCH_SINKS = 3;
+static const char* const BENCH_SINK_NAMES[BENCH_SINKS] = {"detect", "hunt", "baseline"};
+static const uint32_t BENCH_SIZES[] = {100, 1000, 10000};
+static const uint8_t BENCH_SIZE_COUNT = sizeof(BENCH_SIZES) / sizeof(BENCH_SIZES[0]);
+static const uint16_t BENCH_COMPANIES[] = {0x004C, 0x0006, 0x0075, 0x00E0};
+
+// Written by the bench task only; the web side reads plain 32-bit fields
+struct BenchState {
+    BenchParams params;
+    const char* phase;
+    uint32_t run;
+    uint32_t startedMs;
+    uint32_t finishedMs;
+    uint8_t hitKeys;         // filter entries the hits were drawn from
+    uint8_t ingestDone;
+    BenchIngest ingest[BENCH_SINKS];
+    uint32_t wifiRecords;
+    uint32_t wifiInsertNs;   // first sweep: new records
+    uint32_t wifiUpdateNs;   // later sweeps
+    uint8_t buildsDone;
+    BenchBuild builds[BENCH_SIZE_COUNT];
+};
+
+static BenchState bench = {};
+static DeviceTable benchTable;
+
+struct BenchLoad {
+    uint64_t* macs;          // params.uniques addresses, hits first
+    AdvReport* batch;
+    uint8_t payloads[4][Config::MAX_PAYLOAD_SIZE];
+    uint32_t rng;
+};
+
+inline uint32_t benchRand(BenchLoad& l) {
+    l.rng ^= l.rng << 13;
+    l.rng ^= l.rng >> 17;
+    l.rng ^= l.rng << 5;
+    return l.rng;
+}
+
+// Stable per-address RSSI in -40..-89, so hunt trends and sort keys behave
+inline int benchRssi(uint64_t mac48) {
+    return -40 - (int)((mac48 * 0x9E3779B97F4A7C15ULL) >> 58) % 50;
+}
+
+// Flags plus manufacturer data filling the rest, one template per company
+void benchMakePayloads(BenchLoad& l, uint8_t len) {
+    for (uint8_t t = 0; t < 4; t++) {
+        uint8_t* p = l.payloads[t];
+        p[0] = 0x02; p[1] = 0x01; p[2] = 0x06;
+        if (len < 7) continue;
+        p[3] = len - 4;
+        p[4] = 0xFF;
+        p[5] = BENCH_COMPANIES[t] & 0xFF;
+        p[6] = BENCH_COMPANIES[t] >> 8;
+        for (uint8_t i = 7; i < len; i++) p[i] = (uint8_t)(i * 31 + t);
+    }
+}
+
+// Hits reuse OUIs/MACs from the live filter index, so lookups walk the real
+// sorted arrays. Misses are locally administered addresses the index rejects.
+uint8_t benchMakeAddresses(BenchLoad& l, const BenchParams& p) {
+    uint32_t ouis[Config::BENCH_HIT_KEYS];
+    uint64_t macs[Config::BENCH_HIT_KEYS];
+    uint8_t ouiCount = 0;
+    uint8_t macCount = 0;
+    if (lockTake(LockId::FILTERS, filtersMutex, pdMS_TO_TICKS(1000))) {
+        const FilterIndex* idx = activeFilterIndex.load(std::memory_order_acquire);
+        for (uint32_t i = 0; idx && i < idx->ouiCount && ouiCount < Config::BENCH_HIT_KEYS; i++) {
+            ouis[ouiCount++] = idx->ouis[i];
         }
-        
-        bleScan->setAdvertisedDeviceCallbacks(&bleCb, false);
-        bleScan->setActiveScan(true);
-        bleScan->setInterval(Config::BLE_SCAN_INTERVAL);
-        bleScan->setWindow(Config::BLE_SCAN_WINDOW);
-        
-        if (!bleScan->start(0, nullptr, false)) {
-            Serial.println("[ERROR] BLE scan start failed");
-            baselineRunning = false;
-            NimBLEDevice::deinit(true);
-            vTaskDelete(nullptr);
-            return;
+        for (uint32_t i = 0; idx && i < idx->macCount && macCount < Config::BENCH_HIT_KEYS; i++) {
+            macs[macCount++] = idx->macs[i];
         }
+        xSemaphoreGive(filtersMutex);
     }
     
-    std::map<String, ObservedEnhanced> macMap;
-    uint32_t startMs = millis();
-    uint32_t durMs = config.durationSecs * 1000UL;
-    
-    // WiFi scanning with full metadata capture
-    if (config.mode == BaselineMode::WIFI_ONLY || config.mode == BaselineMode::WIFI_AND_BLE) {
-        captureWiFiMetadata(macMap, config, startMs, durMs);
-    } else {
-        while (millis() - startMs < durMs) {
-            esp_task_wdt_reset();
-            vTaskDelay(pdMS_TO_TICKS(100));
+    const uint32_t hits = (ouiCount || macCount) ? (uint32_t)p.uniques * p.hitPct / 100 : 0;
+    for (uint32_t i = 0; i < p.uniques; i++) {
+        const uint32_t mix = (uint32_t)((i + 1) * 2654435761u);
+        if (i < hits) {
+            l.macs[i] = ouiCount ? ((uint64_t)ouis[i % ouiCount] << 24) | (mix & 0xFFFFFF)
+                                 : macs[i % macCount];
+            continue;
         }
+        uint64_t mac = 0x02BE00000000ULL | mix;
+        while (matchesCompiledFilter(mac)) mac += 0x0100000000ULL;
+        l.macs[i] = mac;
     }
-    
-    if (bleScan) {
-        bleScan->stop();
+    return ouiCount + macCount;
+}
+
+void benchFillBatch(BenchLoad& l, const BenchParams& p, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        const uint32_t r = benchRand(l);
+        const uint64_t mac = l.macs[r % p.uniques];
+        l.batch[i] = AdvReport{mac, benchRssi(mac) + (int)(r >> 30) - 1, BLE_ADDR_RANDOM,
+                               l.payloads[(r >> 8) & 3], p.payloadLen};
     }
-    
-    // Merge BLE results
-    if (xSemaphoreTake(bleCb.mutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
-        for (auto it = bleCb.entries.begin(); it != bleCb.entries.end(); ++it) {
-            const String &mac = it->first;
-            const ObservedEnhanced &oBle = it->second;
-            
-            auto it2 = macMap.find(mac);
-            if (it2 == macMap.end()) {
-                macMap[mac] = oBle;
-            } else {
-                if (it2->second.name[0] == '\0' && oBle.name[0] != '\0') {
-                    safeCopy(it2->second.name, sizeof(it2->second.name), oBle.name);
-                }
-                if (oBle.hasRssi && oBle.rssi > it2->second.rssi) {
-                    it2->second.rssi = oBle.rssi;
-                    it2->second.hasRssi = true;
-                }
-                // Preserve payload from BLE
-                if (oBle.hasPayload && !it2->second.hasPayload) {
-                    memcpy(it2->second.payloadData, oBle.payloadData, oBle.payloadLength);
-                    it2->second.payloadLength = oBle.payloadLength;
-                    it2->second.hasPayload = true;
-                    it2->second.addrType = oBle.addrType;
-                }
-            }
+}
+
+// One ingest phase: reports at params.rate through the sink's callback path
+void benchIngest(BenchLoad& l, uint8_t sink, EnhancedBLECollector& collector, BenchIngest& out) {
+    const BenchParams& p = bench.params;
+    if (lockTake(LockId::DETECT, detectMutex, pdMS_TO_TICKS(1000))) {
+        detectState.reset();
+        foxState.reset();
+        xSemaphoreGive(detectMutex);
+    }
+    if (sink == 2) {
+        if (lockTake(LockId::LIVE, liveMutex, pdMS_TO_TICKS(1000))) {
+            benchTable.clear();
+            rotationReset();
+            xSemaphoreGive(liveMutex);
         }
-        
-        currentPayloadMemory = bleCb.payloadMemoryUsed;
-        xSemaphoreGive(bleCb.mutex);
+        activeCollector = &collector;
     }
-    
-    if (NimBLEDevice::getInitialized()) {
-        NimBLEDevice::deinit(true);
+    advSink = sink == 0 ? AdvSink::DETECT : (sink == 1 ? AdvSink::FOX : AdvSink::BASELINE);
+    
+    const uint32_t pushed0 = advRing.pushed;
+    const uint32_t dropped0 = advRing.dropped;
+    const uint32_t matched0 = metrics.advMatched.load(std::memory_order_relaxed);
+    const uint64_t durUs = p.phaseSecs * 1000000ULL;
+    const int64_t startUs = esp_timer_get_time();
+    uint64_t callbackUs = 0;
+    uint32_t offered = 0;
+    
+    while (!benchStopRequested) {
+        const uint64_t elapsedUs = esp_timer_get_time() - startUs;
+        if (elapsedUs >= durUs) break;
+        uint32_t due = p.rate ? (uint32_t)(p.rate * elapsedUs / 1000000ULL) - offered : Config::BENCH_BATCH;
+        if (due > Config::BENCH_BATCH) due = Config::BENCH_BATCH;
+        
+        benchFillBatch(l, p, due);
+        const int64_t batchUs = esp_timer_get_time();
+        for (uint32_t i = 0; i < due; i++) {
+            switch (sink) {
+                case 0:  detectOnReport(l.batch[i]); break;
+                case 1:  foxOnReport(l.batch[i]); break;
+                default: collector.onReport(l.batch[i]); break;
+            }
+        }
+        callbackUs += esp_timer_get_time() - batchUs;
+        offered += due;
+        vTaskDelay(1);
     }
-    
-    buildEnhancedResults(macMap, config);
-    
-    Serial.printf("[BASELINE-ENHANCED] Done, %u devices, %u with payloads\n", 
-                  (unsigned)macMap.size(), bleCb.devicesWithPayload);
-    Hardware::baselineDoneBeep();
-    
-    baselineRunning = false;
-    vTaskDelete(nullptr);
+    out.elapsedMs = (uint32_t)((esp_timer_get_time() - startUs) / 1000);
+    
+    const uint32_t drainStart = millis();
+    advRingQuiesce();
+    out.drainMs = millis() - drainStart;
+    activeCollector = nullptr;
+    
+    out.offered = offered;
+    out.queued = advRing.pushed - pushed0;
+    out.dropped = advRing.dropped - dropped0;
+    out.matched = metrics.advMatched.load(std::memory_order_relaxed) - matched0;
+    out.callbackNs = offered ? (uint32_t)(callbackUs * 1000 / offered) : 0;
+    
+    Serial.printf("[BENCH] %-8s offered %u (%u/s), queued %u, dropped %u, matched %u, "
+                  "callback %u ns, drain %u ms\n",
+                  BENCH_SINK_NAMES[sink], (unsigned)out.offered,
+                  (unsigned)(out.elapsedMs ? (uint64_t)out.offered * 1000 / out.elapsedMs : 0),
+                  (unsigned)out.queued, (unsigned)out.dropped, (unsigned)out.matched,
+                  (unsigned)out.callbackNs, (unsigned)out.drainMs);
 }
 
-void buildEnhancedResults(const std::map<String, ObservedEnhanced>& macMap, const BaselineConfig& config) {
-    if (xSemaphoreTake(resultsMutex, pdMS_TO_TICKS(2000)) != pdTRUE) {
-        Serial.println("[ERROR] Failed to acquire results mutex");
+void benchMakeAp(wifi_ap_record_t& ap, uint32_t i) {
+    memset(&ap, 0, sizeof(ap));
+    const uint64_t mac = 0x02BF00000000ULL | (uint32_t)((i + 1) * 2654435761u);
+    for (int b = 0; b < 6; b++) ap.bssid[b] = (uint8_t)(mac >> (40 - 8 * b));
+    if (i % 8) snprintf((char*)ap.ssid, sizeof(ap.ssid), "bench-%u", (unsigned)i);
+    ap.primary = 1 + i % 13;
+    ap.rssi = (int8_t)benchRssi(mac);
+    ap.authmode = (wifi_auth_mode_t)(i % 8);
+    ap.pairwise_cipher = WIFI_CIPHER_TYPE_CCMP;
+    ap.group_cipher = WIFI_CIPHER_TYPE_CCMP;
+}
+
+// Same aggregation as a scan sweep, minus the per-AP serial line
+void benchWiFi() {
+    wifi_ap_record_t* aps = (wifi_ap_record_t*)psramAlloc(Config::BENCH_WIFI_APS * sizeof(wifi_ap_record_t));
+    if (!aps) {
+        Serial.println("[BENCH] OOM allocating AP records");
         return;
     }
+    for (uint16_t i = 0; i < Config::BENCH_WIFI_APS; i++) benchMakeAp(aps[i], i);
     
-    enhancedResultsRows.clear();
-    enhancedResultsRows.reserve(macMap.size());
-    enhancedResultsRows.assign(macMap.begin(), macMap.end());
-    
-    // Sort by RSSI (strongest first)
-    std::sort(
-        enhancedResultsRows.begin(), 
-        enhancedResultsRows.end(),
-        [](const std::pair<String, ObservedEnhanced>& a, const std::pair<String, ObservedEnhanced>& b) -> bool {
-            return a.second.rssi > b.second.rssi;
+    if (lockTake(LockId::LIVE, liveMutex, pdMS_TO_TICKS(1000))) {
+        benchTable.clear();
+        xSemaphoreGive(liveMutex);
+    }
+    uint64_t insertUs = 0;
+    uint64_t updateUs = 0;
+    for (uint8_t sweep = 0; sweep < Config::BENCH_WIFI_SWEEPS && !benchStopRequested; sweep++) {
+        const int64_t startUs = esp_timer_get_time();
+        for (uint16_t i = 0; i < Config::BENCH_WIFI_APS; i++) {
+            recordWiFiAp(benchTable, aps[i], -100, false);
         }
-    );
+        (sweep ? updateUs : insertUs) += esp_timer_get_time() - startUs;
+        vTaskDelay(1);
+    }
+    free(aps);
+    
+    bench.wifiRecords = Config::BENCH_WIFI_APS;
+    bench.wifiInsertNs = (uint32_t)(insertUs * 1000 / Config::BENCH_WIFI_APS);
+    bench.wifiUpdateNs = (uint32_t)(updateUs * 1000 / ((uint32_t)Config::BENCH_WIFI_APS * (Config::BENCH_WIFI_SWEEPS - 1)));
+    Serial.printf("[BENCH] wifi     %u APs, insert %u ns, update %u ns per record\n",
+                  (unsigned)bench.wifiRecords, (unsigned)bench.wifiInsertNs, (unsigned)bench.wifiUpdateNs);
+}
 
-    // ---- Count device types ----
-    uint16_t wifiCount = 0;
-    uint16_t bleCount = 0;
-    uint16_t bleWithPayload = 0;
-    for (size_t i = 0; i < enhancedResultsRows.size(); ++i) {
-        if (strcmp(enhancedResultsRows[i].second.source, "Wi-Fi") == 0) {
-            wifiCount++;
-        } else {
-            bleCount++;
-            if (enhancedResultsRows[i].second.hasPayload) bleWithPayload++;
+// Renders a published document chunk by chunk, like a web response
+uint32_t benchRender(ResultsDoc doc, uint8_t* buf, uint32_t& bytes) {
+    ResultsStream st(doc, resultsGeneration);
+    uint64_t renderUs = 0;
+    int64_t lastYieldUs = esp_timer_get_time();
+    bytes = 0;
+    while (!benchStopRequested) {
+        const int64_t startUs = esp_timer_get_time();
+        const size_t n = resultsStreamFill(st, buf, Config::BENCH_CHUNK_BYTES);
+        const int64_t endUs = esp_timer_get_time();
+        if (n == RESPONSE_TRY_AGAIN) {
+            vTaskDelay(1);
+            continue;
+        }
+        if (n == 0) break;
+        renderUs += endUs - startUs;
+        bytes += n;
+        // Let IDLE0 feed the watchdog on long documents
+        if (endUs - lastYieldUs > 20000) {
+            vTaskDelay(1);
+            lastYieldUs = esp_timer_get_time();
         }
     }
-    
-    // ---- Build CSV with Wi-Fi metadata columns ----
-    String csv;
-    csv.reserve(4096);
-    csv += "MAC,Source,RSSI,Channel,Band,Encryption,Pairwise Cipher,Group Cipher,Hidden,Name";
-    if (config.capturePayload) {
-        csv += ",Has Payload,Payload Length";
+    return (uint32_t)(renderUs / 1000);
+}
+
+// Publishes a table of n synthetic devices (one in ten Wi-Fi) and times the
+// publish and both text documents
+void benchBuild(BenchLoad& l, EnhancedBLECollector& collector, uint32_t n, uint8_t* buf, BenchBuild& out) {
+    const uint32_t fillStart = millis();
+    if (lockTake(LockId::LIVE, liveMutex, pdMS_TO_TICKS(1000))) {
+        benchTable.clear();
+        rotationReset();
+        xSemaphoreGive(liveMutex);
     }
-    csv += "\n";
-    
-    for (size_t i = 0; i < enhancedResultsRows.size(); ++i) {
-        const String macP = macPretty(enhancedResultsRows[i].first);
-        const ObservedEnhanced& obs = enhancedResultsRows[i].second;
-        
-        csv += "\"" + macP + "\",";
-        csv += "\"" + String(obs.source) + "\",";
-        csv += obs.hasRssi ? String(obs.rssi) : "";
-        csv += ",";
-        
-        if (obs.hasWiFiMeta) {
-            csv += String(obs.channel) + ",";
-            csv += "\"" + String(getBandFromChannel(obs.channel)) + "\",";
-            csv += "\"" + String(getEncryptionType(obs.authMode)) + "\",";
-            csv += "\"" + String(getCipherType(obs.pairwiseCipher)) + "\",";
-            csv += "\"" + String(getCipherType(obs.groupCipher)) + "\",";
-            csv += obs.isHidden ? "Yes" : "No";
-        } else {
-            csv += ",,,,,"  ; // 5 empty cells for BLE devices
-        }
-        csv += ",";
-        
-        String nm = obs.name[0] ? String(obs.name) : "UNKNOWN";
-        nm.replace("\"", "\"\"");
-        csv += "\"" + nm + "\"";
-        
-        if (config.capturePayload) {
-            csv += "," + String(obs.hasPayload ? "Yes" : "No");
-            csv += "," + String(obs.payloadLength);
-        }
-        csv += "\n";
-    }
-    lastResultsCSV = csv;
-    
-    // ---- Build detailed TXT report ----
-    detailedReportTxt = "";
-    detailedReportTxt.reserve(8192);
-    
-    detailedReportTxt += "OUI-SPY ENHANCED BASELINE REPORT\n";
-    detailedReportTxt += "Generated: " + String(millis() / 1000) + "s since boot\n";
-    detailedReportTxt += "Scan Duration: " + String(config.durationSecs) + " seconds\n";
-    detailedReportTxt += "RSSI Threshold: >= " + String(config.rssiThreshold) + " dBm\n";
-    detailedReportTxt += "Payload Capture: " + String(config.capturePayload ? "Enabled" : "Disabled") + "\n";
-    detailedReportTxt += "Total Devices: " + String(enhancedResultsRows.size()) + "\n";
-    detailedReportTxt += "Wi-Fi APs:    " + String(wifiCount) + "\n";
-    detailedReportTxt += "BLE Devices:  " + String(bleCount) + " (" + String(bleWithPayload) + " with payloads)\n\n";
-    
-    if (wifiCount > 0) {
-        detailedReportTxt += "################################################################################\n";
-        detailedReportTxt += "#                          Wi-Fi ACCESS POINTS                                 #\n";
-        detailedReportTxt += "################################################################################\n\n";
-        for (size_t i = 0; i < enhancedResultsRows.size(); ++i) {
-            if (strcmp(enhancedResultsRows[i].second.source, "Wi-Fi") == 0) {
-                detailedReportTxt += generateWiFiDeviceReport(enhancedResultsRows[i].first,
-                                                              enhancedResultsRows[i].second);
-            }
+    collector.devicesWithPayload = 0;
+    RawAdvert adv = {};
+    wifi_ap_record_t ap;
+    for (uint32_t i = 0; i < n && !benchStopRequested; i++) {
+        if (i % 10 == 9) {
+            benchMakeAp(ap, i);
+            recordWiFiAp(benchTable, ap, -100, false);
+            continue;
         }
-    }
-    
-    if (config.capturePayload && bleWithPayload > 0) {
-        detailedReportTxt += "################################################################################\n";
-        detailedReportTxt += "#                       BLE DEVICES (with payloads)                            #\n";
-        detailedReportTxt += "################################################################################\n\n";
-        for (size_t i = 0; i < enhancedResultsRows.size(); ++i) {
-            if (enhancedResultsRows[i].second.hasPayload) {
-                detailedReportTxt += generateDeviceReport(enhancedResultsRows[i].first,
-                                                          enhancedResultsRows[i].second);
-            }
+        adv.mac48 = 0x02BD00000000ULL | (uint32_t)((i + 1) * 2654435761u);
+        adv.addrType = BLE_ADDR_RANDOM;
+        adv.payloadLen = bench.params.payloadLen;
+        memcpy(adv.payload, l.payloads[i & 3], adv.payloadLen);
+        for (uint8_t k = 0; k < 2; k++) {
+            adv.timestampMs = millis();
+            adv.rssi = (int8_t)(benchRssi(adv.mac48) + (int)(benchRand(l) % 5) - 2);
+            collector.consume(adv);
         }
-    } else if (bleCount > 0 && !config.capturePayload) {
-        detailedReportTxt += "BLE devices found but payload capture was disabled.\n";
-        detailedReportTxt += "Enable payload capture to see detailed BLE advertisement data.\n";
+        if (i % 512 == 511) vTaskDelay(1);
     }
-    
-    // ---- Build full HTML results page ----
-    String html;
-    html.reserve(6144);
-    
-    html += F(
-        "<!DOCTYPE html><html><head><meta charset='utf-8'>"
-        "<title>Enhanced Baseline Results</title>"
-        "<meta name='viewport' content='width=device-width, initial-scale=1'>"
-        "<style>"
-        "body{margin:0;padding:24px;background:#0f0f23;color:#e6ffee;"
-        "font-family:'Segoe UI',Tahoma,Arial,sans-serif}"
-        ".card{max-width:1100px;margin:0 auto;background:#1a1f2b;"
-        "border:1px solid #22314a;border-radius:14px;"
-        "box-shadow:0 10px 28px rgba(0,0,0,.45);padding:22px;overflow:hidden}"
-        "h1{margin:0 0 14px 0;font-size:28px;font-weight:700;color:#9be7a6}"
-        "table{width:100%;border-collapse:collapse;margin-top:10px;"
-        "background:#0f1420;border-radius:10px;overflow:hidden}"
-        "th,td{border-bottom:1px solid #26354d;padding:10px 12px;text-align:left}"
-        "th{background:#0c111b;color:#9be7a6;font-weight:600}"
-        "tr:hover td{background:#11192a}"
-        "a.btn{display:inline-block;margin-top:16px;padding:10px 16px;"
-        "border-radius:8px;text-decoration:none;background:#1db954;color:#00100a;"
-        "font-weight:600;border:1px solid #2fe26c;margin-right:8px}"
-        "a.link{color:#78f0a8;text-decoration:none}"
-        "a.btn:hover{filter:brightness(1.05)}"
-        ".rssi{display:inline-block;min-width:76px;text-align:center;"
-        "padding:4px 8px;border-radius:999px;font-weight:700}"
-        ".rssi-unk{background:#2a3344;color:#cbd5e1}"
-        ".rssi-g{background:#1db954;color:#00100a}"
-        ".rssi-y{background:#f4d03f;color:#1b1400}"
-        ".rssi-o{background:#ff9f1a;color:#1f1200}"
-        ".rssi-r{background:#ff4d4d;color:#1a0000}"
-        ".info{background:#002a1a;border:1px solid #1db954;padding:12px;border-radius:8px;margin:16px 0}"
-        ".enc-open{color:#ff4d4d;font-weight:700}"
-        ".enc-weak{color:#ff9f1a;font-weight:700}"
-        ".enc-good{color:#9be7a6}"
-        ".enc-great{color:#1db954;font-weight:700}"
-        "</style></head><body><div class='card'>"
-        "<h1>Enhanced Baseline Results</h1>"
-    );
-    
-    html += "<div class='info'>";
-    html += "<strong>Scan Settings:</strong> ";
-    html += "RSSI &gt;= " + String(config.rssiThreshold) + " dBm &nbsp;|&nbsp; ";
-    html += "Duration: " + String(config.durationSecs) + "s &nbsp;|&nbsp; ";
-    html += "Wi-Fi APs: " + String(wifiCount) + " &nbsp;|&nbsp; ";
-    html += "BLE Devices: " + String(bleCount);
-    if (config.capturePayload) html += " (" + String(bleWithPayload) + " with payloads)";
-    html += "</div>";
-    
-    // Table header — conditional columns
-    html += "<table><tr><th>MAC</th><th>Source</th><th>RSSI</th>"
-            "<th>Ch / Band</th><th>Encryption</th><th>Pairwise</th><th>Name</th>";
-    if (config.capturePayload) html += "<th>Payload</th>";
-    html += "</tr>";
-    
-    if (enhancedResultsRows.empty()) {
-        html += F("<tr><td colspan='8'>No devices observed.</td></tr>");
-    } else {
-        for (size_t i = 0; i < enhancedResultsRows.size(); ++i) {
-            const String macP = macPretty(enhancedResultsRows[i].first);
-            const String oui  = macP.substring(0, 8);
-            const String dev  = macP.substring(9);
-            const ObservedEnhanced& obs = enhancedResultsRows[i].second;
-            const char* src = obs.source[0] ? obs.source : "BLE";
-            const char* nm  = obs.name[0]   ? obs.name   : "UNKNOWN";
-            
-            html += "<tr><td>"
-                    "<a class='link' href='/append_filter?v=" + oui + "'>" + oui + "</a>:"
-                    "<a class='link' href='/append_filter?v=" + macP + "'>" + dev + "</a>"
-                    "</td><td>" + String(src) + "</td><td>" +
-                    rssiCellHtmlEnhanced(obs) + "</td><td>";
-            
-            if (obs.hasWiFiMeta) {
-                html += String(obs.channel) + " / " + String(getBandFromChannel(obs.channel));
-            } else {
-                html += "<span style='color:#4a6080'>BLE</span>";
-            }
-            html += "</td><td>";
-            
-            if (obs.hasWiFiMeta) {
-                // Colour-code encryption
-                const char* enc = getEncryptionType(obs.authMode);
-                const char* cls = "enc-good";
-                if (obs.authMode == WIFI_AUTH_OPEN)    cls = "enc-open";
-                else if (obs.authMode == WIFI_AUTH_WEP || obs.authMode == WIFI_AUTH_WPA_PSK) cls = "enc-weak";
-                else if (obs.authMode == WIFI_AUTH_WPA3_PSK || obs.authMode == WIFI_AUTH_WPA2_WPA3_PSK) cls = "enc-great";
-                html += "<span class='" + String(cls) + "'>" + String(enc) + "</span>";
-            } else {
-                html += "-";
-            }
-            html += "</td><td>";
-            
-            if (obs.hasWiFiMeta && obs.authMode != WIFI_AUTH_OPEN) {
-                html += String(getCipherType(obs.pairwiseCipher));
-            } else {
-                html += "-";
-            }
-            html += "</td><td>" + htmlEscape(String(nm)) + "</td>";
-            
-            if (config.capturePayload) {
-                html += obs.hasPayload
-                    ? "<td>" + String(obs.payloadLength) + "B</td>"
-                    : "<td>-</td>";
-            }
-            html += "</tr>";
+    out.fillMs = millis() - fillStart;
+    out.devices = benchTable.count;
+    
+    const int64_t buildStart = esp_timer_get_time();
+    buildEnhancedResults(benchTable, collector.config);
+    out.buildMs = (uint32_t)((esp_timer_get_time() - buildStart) / 1000);
+    out.csvMs = benchRender(ResultsDoc::CSV, buf, out.csvBytes);
+    out.txtMs = benchRender(ResultsDoc::TXT, buf, out.txtBytes);
+    
+    Serial.printf("[BENCH] build    %u devices: fill %u ms, publish %u ms, CSV %u ms (%u B), report %u ms (%u B)\n",
+                  (unsigned)out.devices, (unsigned)out.fillMs, (unsigned)out.buildMs,
+                  (unsigned)out.csvMs, (unsigned)out.csvBytes, (unsigned)out.txtMs, (unsigned)out.txtBytes);
+}
+
+void benchTask(void* pv) {
+    const uint32_t run = bench.run;
+    BenchLoad* load = new (std::nothrow) BenchLoad();
+    uint8_t* chunk = (uint8_t*)malloc(Config::BENCH_CHUNK_BYTES);
+    if (load) {
+        load->macs = (uint64_t*)psramAlloc(bench.params.uniques * sizeof(uint64_t));
+        load->batch = (AdvReport*)malloc(Config::BENCH_BATCH * sizeof(AdvReport));
+        load->rng = 0x9E3779B9u ^ run;
+    }
+    if (!load || !load->macs || !load->batch || !chunk ||
+        !benchTable.init(Config::BENCH_TABLE_CAPACITY)) {
+        Serial.println("[BENCH] OOM, not started");
+        bench.phase = "failed";
+    } else {
+        const BenchParams& p = bench.params;
+        Serial.printf("[BENCH] Run %u: %u adverts/s, %u addresses, %u B payload, %u%% hits, %u s per phase\n",
+                      (unsigned)run, (unsigned)p.rate, p.uniques, p.payloadLen, p.hitPct, p.phaseSecs);
+        benchMakePayloads(*load, p.payloadLen);
+        bench.hitKeys = benchMakeAddresses(*load, p);
+        if (!bench.hitKeys && p.hitPct) {
+            Serial.println("[BENCH] No OUI/MAC filters saved, every report is a miss");
+        }
+        
+        BaselineConfig cfg = {BaselineMode::WIFI_AND_BLE, 0, -100, true, false, false,
+                              Config::WIFI_SCAN_DWELL_MS, ScanProfile::MAX_CAPTURE,
+                              false, Config::SURVEY_SNAPSHOT_SECS, ResultsSort::BEST_RSSI};
+        EnhancedBLECollector collector(benchTable, cfg);
+        
+        for (uint8_t sink = 0; sink < BENCH_SINKS && !benchStopRequested; sink++) {
+            bench.phase = BENCH_SINK_NAMES[sink];
+            benchIngest(*load, sink, collector, bench.ingest[sink]);
+            bench.ingestDone = sink + 1;
+        }
+        if (!benchStopRequested) {
+            bench.phase = "wifi";
+            benchWiFi();
         }
+        for (uint8_t i = 0; i < BENCH_SIZE_COUNT && !benchStopRequested; i++) {
+            bench.phase = "build";
+            benchBuild(*load, collector, BENCH_SIZES[i], chunk, bench.builds[i]);
+            bench.buildsDone = i + 1;
+        }
+        bench.phase = benchStopRequested ? "stopped" : "done";
     }
     
-    html += F("</table><div style='margin-top:10px'>"
-              "<a class='btn' href='/'>Home</a> "
-              "<a class='btn' href='/baseline_results.csv'>Download CSV</a>");
-    
-    // Show detailed report link whenever there is Wi-Fi OR BLE payload data
-    if (wifiCount > 0 || (config.capturePayload && bleWithPayload > 0)) {
-        html += F(" <a class='btn' href='/baseline_results_detailed.txt'>Download Detailed Report</a>");
+    // Leave nothing pointing at the benchmark table
+    if (lockTake(LockId::RESULTS, resultsMutex, pdMS_TO_TICKS(2000))) {
+        if (resultsTable == &benchTable) {
+            resultsTable = nullptr;
+            std::vector<uint32_t>().swap(enhancedResultsRows);
+            resultsSummary = ResultsSummary();
+            resultsGeneration++;
+        }
+        xSemaphoreGive(resultsMutex);
     }
+    if (lockTake(LockId::LIVE, liveMutex, pdMS_TO_TICKS(1000))) {
+        rotationReset();
+        xSemaphoreGive(liveMutex);
+    }
+    if (lockTake(LockId::DETECT, detectMutex, pdMS_TO_TICKS(1000))) {
+        detectState.reset();
+        foxState.reset();
+        xSemaphoreGive(detectMutex);
+    }
+    benchTable.release();
+    if (load) {
+        free(load->macs);
+        free(load->batch);
+        delete load;
+    }
+    free(chunk);
     
-    html += F("</div></div></body></html>");
-    lastResultsHTMLFull = html;
-    
-    xSemaphoreGive(resultsMutex);
+    bench.finishedMs = millis();
+    Serial.printf("[BENCH] Run %u %s in %u ms\n", (unsigned)run, bench.phase,
+                  (unsigned)(bench.finishedMs - bench.startedMs));
+    benchStopRequested = false;
+    benchRunning = false;
+    vTaskDelete(nullptr);
 }
 
-void startEnhancedBaseline(BaselineMode mode, uint32_t secs, int16_t rssiThreshold, bool capturePayload) {
-    if (baselineRunning) {
-        Serial.println("[BASELINE] Already running");
-        return;
+bool startBenchmark(const BenchParams& p) {
+    if (modeBusy()) return false;
+    benchRunning = true;
+    benchStopRequested = false;
+    const uint32_t run = bench.run + 1;
+    bench = BenchState();
+    bench.params = p;
+    bench.run = run;
+    bench.phase = "starting";
+    bench.startedMs = millis();
+    if (!launchTask(TaskRole::BENCH, benchTask, nullptr)) {
+        bench.phase = "failed";
+        benchRunning = false;
+        return false;
     }
-    
-    if (secs < 5) secs = 5;
-    if (secs > 600) secs = 600;
-    if (rssiThreshold < -100) rssiThreshold = -100;
-    if (rssiThreshold > -10) rssiThreshold = -10;
-    
-    BaselineConfig* config = new BaselineConfig{mode, secs, rssiThreshold, capturePayload};
-    
-    BaseType_t result = xTaskCreatePinnedToCore(
-        enhancedBaselineTask, 
-        "baselineTask", 
-        Config::BASELINE_STACK_SIZE,
-        config, 
-        Config::TASK_PRIORITY, 
-        NULL, 
-        Config::TASK_CORE
-    );
-    
-    if (result != pdPASS) {
-        Serial.println("[ERROR] Failed to create baseline task");
-        delete config;
+    return true;
+}
+
+String renderBenchJson() {
+    const BenchParams& p = bench.params;
+    String json;
+    json.reserve(1536);
+    json += "{\"build\":\"" __DATE__ " " __TIME__ "\"";
+    json += ",\"sdk\":\"" + String(ESP.getSdkVersion()) + "\"";
+    json += ",\"cpu_mhz\":" + String(getCpuFrequencyMhz());
+    json += ",\"run\":" + String(bench.run);
+    json += ",\"running\":" + String(benchRunning ? "true" : "false");
+    json += ",\"phase\":\"" + String(bench.phase ? bench.phase : "idle") + "\"";
+    if (!bench.run) return json + "}";
+    
+    json += ",\"elapsed_ms\":" + String((benchRunning ? millis() : bench.finishedMs) - bench.startedMs);
+    json += ",\"params\":{\"rate\":" + String(p.rate) + ",\"uniques\":" + String(p.uniques);
+    json += ",\"payload\":" + String(p.payloadLen) + ",\"hit_pct\":" + String(p.hitPct);
+    json += ",\"secs\":" + String(p.phaseSecs) + ",\"hit_keys\":" + String(bench.hitKeys) + "}";
+    json += ",\"ingest\":{";
+    for (uint8_t i = 0; i < bench.ingestDone; i++) {
+        const BenchIngest& g = bench.ingest[i];
+        if (i) json += ",";
+        json += "\"" + String(BENCH_SINK_NAMES[i]) + "\":{";
+        json += "\"offered\":" + String(g.offered);
+        json += ",\"offered_per_s\":" + String(g.elapsedMs ? (uint32_t)((uint64_t)g.offered * 1000 / g.elapsedMs) : 0);
+        json += ",\"queued\":" + String(g.queued);
+        json += ",\"dropped\":" + String(g.dropped);
+        json += ",\"matched\":" + String(g.matched);
+        json += ",\"consumed_per_s\":" + String(g.elapsedMs + g.drainMs ? (uint32_t)((uint64_t)g.queued * 1000 / (g.elapsedMs + g.drainMs)) : 0);
+        json += ",\"callback_ns\":" + String(g.callbackNs);
+        json += ",\"drain_ms\":" + String(g.drainMs) + "}";
+    }
+    json += "}";
+    if (bench.wifiRecords) {
+        json += ",\"wifi\":{\"aps\":" + String(bench.wifiRecords);
+        json += ",\"insert_ns\":" + String(bench.wifiInsertNs);
+        json += ",\"update_ns\":" + String(bench.wifiUpdateNs) + "}";
+    }
+    json += ",\"builds\":[";
+    for (uint8_t i = 0; i < bench.buildsDone; i++) {
+        const BenchBuild& b = bench.builds[i];
+        if (i) json += ",";
+        json += "{\"devices\":" + String(b.devices);
+        json += ",\"fill_ms\":" + String(b.fillMs);
+        json += ",\"publish_ms\":" + String(b.buildMs);
+        json += ",\"csv_ms\":" + String(b.csvMs) + ",\"csv_bytes\":" + String(b.csvBytes);
+        json += ",\"report_ms\":" + String(b.txtMs) + ",\"report_bytes\":" + String(b.txtBytes) + "}";
     }
+    json += "]}";
+    return json;
 }
 
 // ================================
 // ENHANCED WEB INTERFACE
 // ================================
 
-static const char* INDEX_HTML = R"HTML(
-<!DOCTYPE html>
-<html>
-<head>
-  <meta charset="utf-8">
-  <title>OUI-Spy Enhanced</title>
-  <meta name="viewport" content="width=device-width, initial-scale=1">
-  <style>
-    *{box-sizing:border-box}
-    body{margin:0;padding:24px;background:#0f0f23;color:#e6ffee;font-family:'Segoe UI',Tahoma,Arial,sans-serif}
-    .container{max-width:980px;margin:0 auto;background:#1a1f2b;border:1px solid #22314a;border-radius:14px;
-               box-shadow:0 10px 28px rgba(0,0,0,.45);padding:22px;overflow:hidden}
-    h1{margin:0 0 8px 0;font-size:30px;font-weight:700;color:#9be7a6}
-    .muted{color:#a8cbb5;font-size:14px}
-    .section{margin:16px 0;padding:16px;border:1px solid #22314a;border-radius:10px;background:#0f1420}
-    textarea,input[type=number],input[type=range]{width:100%;max-width:720px;padding:10px;border-radius:8px;border:1px solid #2a405f;
-                                background:#09101b;color:#dff6e6;font-family:Consolas,Menlo,monospace}
-    textarea{white-space:pre-wrap;overflow-wrap:anywhere;word-break:break-word;}
-    label{display:block;margin:6px 0}
-    .btn{display:inline-block;border:1px solid #2fe26c;background:#1db954;color:#00100a;
-         padding:10px 16px;border-radius:8px;cursor:pointer;text-decoration:none;font-weight:600;margin:4px}
-    .btn:hover{filter:brightness(1.05)}
-    a{color:#78f0a8}
-    .row{display:flex;gap:10px;flex-wrap:wrap;align-items:center}
-    .slider-container{display:flex;align-items:center;gap:12px;margin:10px 0}
-    .slider{flex:1;max-width:400px}
-    .slider-value{min-width:80px;font-weight:600;color:#9be7a6;font-size:16px}
-    .warning-box{background:#3d2a00;border:1px solid #f4d03f;padding:12px;border-radius:8px;margin:10px 0}
-    .info-box{background:#002a1a;border:1px solid #1db954;padding:12px;border-radius:8px;margin:10px 0}
-  </style>
-  <script>
-    function updateRssiValue(val) {
-      document.getElementById('rssiValue').textContent = val + ' dBm';
-    }
-    
-    function togglePayloadWarning() {
-      const checkbox = document.getElementById('capturePayload');
-      const warning = document.getElementById('payloadWarning');
-      warning.style.display = checkbox.checked ? 'block' : 'none';
-    }
-    
-    async function updateMemoryStatus() {
-      try {
-        const res = await fetch('/memory_status');
-        const data = await res.json();
-        document.getElementById('memStatus').innerHTML = 
-          `Free Heap: ${(data.free_heap/1024).toFixed(1)}KB | ` +
-          `Payload Memory: ${data.payload_memory}/${data.max_payload_memory} bytes | ` +
-          `Max Devices: ${data.max_devices}`;
-      } catch(e) {}
-    }
-    
-    setInterval(updateMemoryStatus, 5000);
-    window.onload = updateMemoryStatus;
-  </script>
-</head>
-<body>
-  <div class="container">
-    <h1>OUI-SPY ENHANCED</h1>
-    <p class="muted">Advanced baseline scanning with RSSI filtering and payload capture.</p>
-    <div class="muted" id="memStatus" style="margin-top:8px">Loading memory status...</div>
-
-    <div class="section">
-      <h3 style="margin-top:0;color:#9be7a6">Detection Filters</h3>
-      <form method="POST" action="/save">
-        <textarea id="filtersTa" name="filters" rows="7" placeholder="AA:BB:CC or AA:BB:CC:11:22:33, one per line">%FILTERS%</textarea><br><br>
-        <input class="btn" type="submit" value="Save Filters">
-        <button class="btn" formaction="/filters_clear" formmethod="POST" type="submit"
-                onclick="return confirm('Clear all detection filters?');">Clear Filters</button>
-      </form>
-      <p class="muted">OUI = first 3 bytes. Full MAC = 6 bytes. One entry per line. Max %MAX_FILTERS% filters.</p>
-    </div>
-
-    <div class="section">
-      <h3 style="margin-top:0;color:#9be7a6">Enhanced Baseline Scan</h3>
-      <form method="POST" action="/baseline_start">
-        <label class="muted" style="margin-bottom:8px">Scan Mode:</label>
-        <label><input type="radio" name="mode" value="wifi" checked> Wi-Fi</label>
-        <label><input type="radio" name="mode" value="ble"> BLE</label>
-        <label><input type="radio" name="mode" value="both"> Wi-Fi &amp; BLE</label>
-        
-        <br><br>
-        <label>Duration (seconds): <input type="number" min="5" max="600" value="60" name="secs" style="width:120px"></label>
-        
-        <br><br>
-        <label class="muted">RSSI Threshold (filter nearby devices):</label>
-        <div class="slider-container">
-          <span class="muted" style="min-width:60px">Weak</span>
-          <input type="range" name="rssi_threshold" class="slider" min="-100" max="-10" value="-100" 
-                 oninput="updateRssiValue(this.value)">
-          <span class="muted" style="min-width:60px">Strong</span>
-          <span class="slider-value" id="rssiValue">-100 dBm</span>
-        </div>
-        <p class="muted">Only scan devices with RSSI >= selected value. -100 = capture all, -50 = nearby only</p>
-        
-        <div class="info-box">
-          <label>
-            <input type="checkbox" name="capture_payload" id="capturePayload" onchange="togglePayloadWarning()"> 
-            <strong>Capture BLE Payloads (Advertisement Data)</strong>
-          </label>
-          <p class="muted" style="margin:8px 0 0 24px">
-            Captures raw BLE advertisement data including manufacturer info, UUIDs, and service data.
-            Useful for device fingerprinting and analysis.
-          </p>
-        </div>
-        
-        <div class="warning-box" id="payloadWarning" style="display:none">
-          <strong>⚠️ Memory Warning</strong>
-          <p class="muted" style="margin:4px 0 0 0">
-            Payload capture is memory-intensive. Limited to 50 devices or 10KB total.
-            Long scans in crowded areas may hit limits.
-          </p>
-        </div>
-        
-        <br>
-        <div class="row">
-          <button class="btn" type="submit">Start Enhanced Baseline</button>
-          <a class="btn" href="/baseline_results.csv">Download CSV</a>
-          <a class="btn" href="/baseline_results_detailed.txt">Download Detailed Report</a>
-        </div>
-      </form>
-      <p class="muted">You'll hear 3 beeps when baseline finishes; results appear below.</p>
-    </div>
-
-    <div class="section">
-      <h3 style="margin-top:0;color:#9be7a6">Detection Mode</h3>
-      <form method="POST" action="/detect_start">
-        <div class="row">
-          <span class="muted">Status: %RUN_STATUS%</span>
-        </div>
-        <hr style="border:0;border-top:1px solid #22314a;margin:12px 0">
-        <label class="muted">Scan mode:</label>
-        <label><input type="radio" name="d_mode" value="wifi" checked> Wi-Fi</label>
-        <label><input type="radio" name="d_mode" value="ble"> BLE</label>
-        <label><input type="radio" name="d_mode" value="both"> Wi-Fi &amp; BLE</label><br><br>
-        <label><input type="checkbox" name="stealth" value="1"> Stealth (LED only)</label><br><br>
-        <button class="btn" type="submit">Start Detect (drops AP)</button>
-      </form>
-      <p class="muted">To stop, power-cycle or reset the device.</p>
-    </div>
-
-    <div class="section">
-      <h3 style="margin-top:0;color:#9be7a6">Hunt (BLE only)</h3>
-      <form method="POST" action="/hunt_start">
-        <p class="muted" style="margin-top:0">Uses your saved Detection Filters. Beep rate follows strongest RSSI match.</p>
-        <label><input type="checkbox" name="stealth" value="1"> Stealth (LED only)</label><br><br>
-        <button class="btn" type="submit">Start Hunt (drops AP)</button>
-      </form>
-      <p class="muted">Hunt runs BLE-only for stability. To stop, power-cycle or reset.</p>
-    </div>
-
-    %LAST_RESULTS_SECTION%
-  </div>
-</body>
-</html>
-)HTML";
-
-String renderIndexResultsSection() {
-    if (xSemaphoreTake(resultsMutex, pdMS_TO_TICKS(500)) != pdTRUE) {
+// First page by default, so the landing page stays small however big the run
+String renderIndexResultsSection(ResultsPage& page) {
+    if (!lockTake(LockId::RESULTS, resultsMutex, pdMS_TO_TICKS(500))) {
         return String("<div class='section'><h3>Results temporarily unavailable</h3></div>");
     }
     
-    if (enhancedResultsRows.empty()) {
+    if (!resultsTable || enhancedResultsRows.empty()) {
         xSemaphoreGive(resultsMutex);
         return String(
-            "<div class='section'><h3 style='margin-top:0;color:#9be7a6'>Last Results</h3>"
+            "<div class='section'><h3>Last Results</h3>"
             "<p class='muted'>No baseline run yet.</p></div>"
         );
     }
     
+    resolveResultsPage(page);
+    
     String html;
     html.reserve(2048);
     
     html += F(
-        "<div class='section'><h3 style='margin-top:0;color:#9be7a6'>Last Results</h3>"
+        "<div class='section'><h3>Last Results</h3>"
         "<p class='muted'>Click the <b>first 3 bytes</b> to add an OUI, "
         "or the <b>last 3 bytes</b> to add the full MAC.</p>"
-        "<div style='max-height:360px;overflow-y:auto;overflow-x:hidden;border-radius:10px'>"
-        "<table style='width:100%;border-collapse:collapse;background:#0f1420;table-layout:fixed'>"
-        "<tr style='color:#9be7a6'><th style='padding:8px'>MAC</th><th style='padding:8px'>Src</th>"
-        "<th style='padding:8px'>RSSI</th><th style='padding:8px'>Ch/Band</th>"
-        "<th style='padding:8px'>Encryption</th><th style='padding:8px'>Name</th>"
+        "<div class='scroll'><table class='grid compact'>"
+        "<tr><th>MAC</th><th>Src</th><th>RSSI</th><th>Ch/Band</th><th>Encryption</th><th>Name</th>"
     );
     
-    if (currentBaselineConfig.capturePayload) {
-        html += "<th style='padding:8px'>Payload</th>";
+    if (resultsSummary.config.capturePayload) {
+        html += "<th>Payload</th>";
     }
     
     html += "</tr>";
     
-    for (size_t i = 0; i < enhancedResultsRows.size() && i < 50; ++i) {
-        const String macP = macPretty(enhancedResultsRows[i].first);
+    const DeviceTable& t = *resultsTable;
+    const std::vector<uint32_t>& rows = page.rows();
+    for (size_t i = page.begin; i < page.end; ++i) {
+        const uint32_t slot = rows[i];
+        const DeviceRecord& obs = t.hot[slot];
+        const String macP = macPrettyU64(t.macAt(slot));
         const String oui = macP.substring(0, 8);
         const String dev = macP.substring(9);
-        const char* src = enhancedResultsRows[i].second.source[0] ? 
-                          enhancedResultsRows[i].second.source : "BLE";
-        const char* nm = enhancedResultsRows[i].second.name[0] ? 
-                         enhancedResultsRows[i].second.name : "UNKNOWN";
+        const char* src = deviceSource(obs);
+        const char* nm = obs.nameRef ? t.name(slot) : "UNKNOWN";
         
         String escapedName = htmlEscape(String(nm));
         
-        html += "<tr style='border-bottom:1px solid #26354d'>"
-                "<td style='padding:8px;word-break:break-word'>"
-                "<a href='/append_filter?v=" + oui + "' style='color:#78f0a8;text-decoration:none'>" + 
-                oui + "</a>:"
-                "<a href='/append_filter?v=" + macP + "' style='color:#78f0a8;text-decoration:none'>" + 
-                dev + "</a>"
-                "</td>"
-                "<td style='padding:8px'>" + String(src) + "</td>"
-                "<td style='padding:8px'>" + rssiCellHtmlEnhanced(enhancedResultsRows[i].second) + "</td>";
-        
-        const ObservedEnhanced& obs = enhancedResultsRows[i].second;
-        if (obs.hasWiFiMeta) {
-            html += "<td style='padding:8px'>" + String(obs.channel) + "/" + 
-                    String(getBandFromChannel(obs.channel)) + "</td>";
-            html += "<td style='padding:8px'>" + String(getEncryptionType(obs.authMode)) + "</td>";
+        html += "<tr><td>"
+                "<a class='link' href='/append_filter?v=" + oui + "'>" + oui + "</a>:"
+                "<a class='link' href='/append_filter?v=" + macP + "'>" + dev + "</a>"
+                "</td><td>" + String(src) + "</td><td>" + rssiCellHtmlEnhanced(obs) + "</td>";
+        
+        if (obs.flags & DEV_HAS_WIFI_META) {
+            const WiFiMeta& meta = t.wifi[slot];
+            html += "<td>" + String(meta.channel) + "/" + String(getBandFromChannel(meta.channel)) + "</td>";
+            html += "<td>" + String(getEncryptionType((wifi_auth_mode_t)meta.authMode)) + "</td>";
         } else {
-            html += "<td style='padding:8px;color:#4a6080'>-</td>"
-                    "<td style='padding:8px;color:#4a6080'>BLE</td>";
+            html += "<td class='dim'>-</td><td class='dim'>BLE</td>";
         }
         
-        html += "<td style='padding:8px'>" + escapedName + "</td>";
+        html += "<td>" + escapedName + "</td>";
         
-        if (currentBaselineConfig.capturePayload) {
-            if (enhancedResultsRows[i].second.hasPayload) {
-                html += "<td style='padding:8px'>" + String(enhancedResultsRows[i].second.payloadLength) + "B</td>";
+        if (resultsSummary.config.capturePayload) {
+            if (obs.flags & DEV_HAS_PAYLOAD) {
+                html += "<td>" + String(obs.payloadLength) + "B</td>";
             } else {
-                html += "<td style='padding:8px'>-</td>";
+                html += "<td>-</td>";
             }
         }
         
         html += "</tr>";
     }
     
+    html += F("</table></div>");
+    if (page.paged()) {
+        html += "<p class='muted'>Showing " + String((unsigned)(page.end - page.begin)) + " of " +
+                String((unsigned)page.total) + " devices.</p>";
+    }
     html += F(
-        "</table></div>"
-        "<div style='margin-top:10px'>"
+        "<div class='actions'>"
         "<a class='btn' href='/baseline_results.csv'>Download CSV</a> "
         "<a class='btn' href='/baseline_results'>Open Full Page</a>"
     );
+    if (page.end < page.total) {
+        html += " <a class='btn' href='/baseline_results" + resultsPageQuery(page, page.end, page.sort) + "'>Next &rsaquo;</a>";
+    }
     
-    if (currentBaselineConfig.capturePayload) {
+    // Detailed report whenever there are payloads or Wi-Fi results with metadata
+    if (resultsSummary.config.capturePayload || resultsSummary.wifiCount > 0) {
         html += " <a class='btn' href='/baseline_results_detailed.txt'>Detailed Report</a>";
-    } else {
-        // Show detailed report whenever there are Wi-Fi results with metadata
-        bool hasWiFiResults = false;
-        for (size_t i = 0; i < enhancedResultsRows.size(); ++i) {
-            if (enhancedResultsRows[i].second.hasWiFiMeta) { hasWiFiResults = true; break; }
-        }
-        if (hasWiFiResults) {
-            html += " <a class='btn' href='/baseline_results_detailed.txt'>Detailed Report</a>";
-        }
     }
     
     html += F("</div></div>");
@@ -2099,47 +5695,413 @@ String renderIndexResultsSection() {
     return html;
 }
 
-String buildIndex() {
-    String fl;
+// "run_min" form field -> seconds, 0 = run until stopped
+uint32_t parseRunSecs(AsyncWebServerRequest* req) {
+    if (!req->hasParam("run_min", true)) return 0;
+    const long mins = req->getParam("run_min", true)->value().toInt();
+    return (uint32_t)constrain(mins, 0L, (long)Config::MODE_RUN_MAX_MIN) * 60UL;
+}
+
+String renderMemoryStatusJson() {
+    String json = "{";
+    json += "\"free_heap\":" + String(ESP.getFreeHeap()) + ",";
+    json += "\"payload_memory\":" + String(currentPayloadMemory) + ",";
+    json += "\"max_payload_memory\":" + String(Config::MAX_PAYLOAD_MEMORY) + ",";
+    json += "\"max_devices\":" + String(Config::MAX_PAYLOAD_DEVICES) + ",";
+    json += "\"device_table_capacity\":" + String(baselineTables[0].capacity) + ",";
+    json += "\"device_table_limit\":" + String(baselineTables[0].loadLimit) + ",";
+    json += "\"live_devices\":" + String(liveTable ? liveTable->count : 0) + ",";
+    json += "\"name_pool_used\":" + String(liveTable ? liveTable->names.used : 0) + ",";
+    json += "\"adv_ring_slots\":" + String(Config::ADV_RING_SLOTS) + ",";
+    json += "\"adv_ring_pushed\":" + String(advRing.pushed) + ",";
+    json += "\"adv_ring_dropped\":" + String(advRing.dropped) + ",";
+    json += "\"adv_ring_high_water\":" + String(advRing.highWater) + ",";
+    json += "\"promisc_frames\":" + String(promiscStats.frames) + ",";
+    json += "\"promisc_hits\":" + String(promiscStats.hits) + ",";
+    json += "\"promisc_dropped\":" + String(promiscStats.dropped) + ",";
+    json += "\"rotation_clusters\":" + String(rotation.count) + ",";
+    json += "\"rotation_linked\":" + String(rotation.linked) + ",";
+    json += "\"rotation_conflicts\":" + String(rotation.conflicts) + ",";
+    json += "\"device_evictions\":" + String(baselineTables[0].evictions + baselineTables[1].evictions);
+    json += "}";
+    return json;
+}
+
+// ---- Metrics export ----
+
+struct HeapPool {
+    const char* name;
+    uint32_t caps;
+};
+
+static const HeapPool HEAP_POOLS[] = {
+    {"internal", MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT},
+    {"psram",    MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT},
+};
+
+void appendHistJson(String& json, const char* key, const LatencyHist& h) {
+    json += "\"" + String(key) + "\":{";
+    json += "\"count\":" + String(h.count.load(std::memory_order_relaxed));
+    json += ",\"sum_us\":" + String(h.sumUs.load(std::memory_order_relaxed));
+    json += ",\"max_us\":" + String(h.maxUs.load(std::memory_order_relaxed));
+    json += ",\"p50_us\":" + String(histQuantileUs(h, 0.50f));
+    json += ",\"p99_us\":" + String(histQuantileUs(h, 0.99f));
+    json += ",\"buckets\":[";
+    for (uint8_t i = 0; i < Config::METRICS_HIST_BUCKETS; i++) {
+        if (i) json += ",";
+        json += String(h.buckets[i].load(std::memory_order_relaxed));
+    }
+    json += "]}";
+}
+
+// Histogram buckets are non-cumulative here; bounds are 4^i us, the last +Inf
+String renderMetricsJson() {
+    String json;
+    json.reserve(2048);
+    json += "{\"uptime_ms\":" + String(millis());
+    json += ",\"adverts\":{";
+    json += "\"received\":" + String(metrics.advReceived.load(std::memory_order_relaxed));
+    json += ",\"matched\":" + String(metrics.advMatched.load(std::memory_order_relaxed));
+    json += ",\"dropped\":" + String(metrics.advDropped.load(std::memory_order_relaxed));
+    json += ",\"received_per_s\":" + String(metrics.perSec.received);
+    json += ",\"matched_per_s\":" + String(metrics.perSec.matched);
+    json += ",\"dropped_per_s\":" + String(metrics.perSec.dropped);
+    json += ",\"ring_high_water\":" + String(advRing.highWater);
+    json += "},\"latency\":{";
+    appendHistJson(json, "on_result", metrics.onResultUs);
+    json += ",";
+    appendHistJson(json, "wifi_scan", metrics.wifiScanUs);
+    json += ",";
+    appendHistJson(json, "results_build", metrics.resultsBuildUs);
+    json += ",";
+    appendHistJson(json, "results_chunk", metrics.resultsChunkUs);
+    json += "},\"locks\":{";
+    for (size_t i = 0; i < (size_t)LockId::COUNT; i++) {
+        const LockStats& ls = metrics.locks[i];
+        if (i) json += ",";
+        json += "\"" + String(LOCK_NAMES[i]) + "\":{\"timeouts\":";
+        json += String(ls.timeouts.load(std::memory_order_relaxed)) + ",";
+        appendHistJson(json, "wait", ls.waitUs);
+        json += "}";
+    }
+    json += "},\"heap\":{";
+    for (size_t i = 0; i < sizeof(HEAP_POOLS) / sizeof(HEAP_POOLS[0]); i++) {
+        const uint32_t caps = HEAP_POOLS[i].caps;
+        if (i) json += ",";
+        json += "\"" + String(HEAP_POOLS[i].name) + "\":{";
+        json += "\"free\":" + String(heap_caps_get_free_size(caps));
+        json += ",\"min_free\":" + String(heap_caps_get_minimum_free_size(caps));
+        json += ",\"largest_block\":" + String(heap_caps_get_largest_free_block(caps));
+        json += "}";
+    }
+    json += "},\"stack_free\":{";
+    bool first = true;
+    forEachKnownTask([&json, &first](const char* name, TaskHandle_t h) {
+        if (!first) json += ",";
+        first = false;
+        json += "\"" + String(name) + "\":" + String(uxTaskGetStackHighWaterMark(h));
+    });
+    json += "}}";
+    return json;
+}
+
+void appendPromHeader(String& out, const char* name, const char* type, const char* help) {
+    out += "# HELP ouispy_" + String(name) + " " + help + "\n";
+    out += "# TYPE ouispy_" + String(name) + " " + type + "\n";
+}
+
+void appendPromValue(String& out, const char* name, const char* labels, const String& value) {
+    out += "ouispy_" + String(name);
+    if (labels && *labels) out += "{" + String(labels) + "}";
+    out += " " + value + "\n";
+}
+
+// Cumulative buckets in seconds; `labels` is e.g. mutex="detect" or empty
+void appendPromHist(String& out, const char* name, const char* labels, const LatencyHist& h) {
+    const String base = "ouispy_" + String(name);
+    const String sep = labels && *labels ? String(labels) + "," : String();
+    uint32_t cumulative = 0;
+    for (uint8_t i = 0; i < Config::METRICS_HIST_BUCKETS; i++) {
+        cumulative += h.buckets[i].load(std::memory_order_relaxed);
+        out += base + "_bucket{" + sep + "le=\"";
+        out += i + 1 < Config::METRICS_HIST_BUCKETS ? String((1UL << (2 * i)) / 1e6, 6) : String("+Inf");
+        out += "\"} " + String(cumulative) + "\n";
+    }
+    const String tail = labels && *labels ? "{" + String(labels) + "}" : String();
+    out += base + "_sum" + tail + " " + String(h.sumUs.load(std::memory_order_relaxed) / 1e6, 6) + "\n";
+    out += base + "_count" + tail + " " + String(cumulative) + "\n";
+}
+
+// Prometheus text exposition format 0.0.4
+String renderMetricsPrometheus() {
+    String out;
+    out.reserve(6144);
+    
+    appendPromHeader(out, "uptime_seconds", "gauge", "Time since boot.");
+    appendPromValue(out, "uptime_seconds", nullptr, String(millis() / 1000));
+    
+    appendPromHeader(out, "adverts_total", "counter", "BLE advertisements by outcome.");
+    appendPromValue(out, "adverts_total", "outcome=\"received\"", String(metrics.advReceived.load(std::memory_order_relaxed)));
+    appendPromValue(out, "adverts_total", "outcome=\"matched\"", String(metrics.advMatched.load(std::memory_order_relaxed)));
+    appendPromValue(out, "adverts_total", "outcome=\"dropped\"", String(metrics.advDropped.load(std::memory_order_relaxed)));
+    appendPromHeader(out, "adverts_per_second", "gauge", "BLE advertisement rate over the last second.");
+    appendPromValue(out, "adverts_per_second", "outcome=\"received\"", String(metrics.perSec.received));
+    appendPromValue(out, "adverts_per_second", "outcome=\"matched\"", String(metrics.perSec.matched));
+    appendPromValue(out, "adverts_per_second", "outcome=\"dropped\"", String(metrics.perSec.dropped));
+    
+    appendPromHeader(out, "on_result_seconds", "histogram", "Time spent in the NimBLE scan callback.");
+    appendPromHist(out, "on_result_seconds", nullptr, metrics.onResultUs);
+    appendPromHeader(out, "wifi_scan_seconds", "histogram", "Wi-Fi scan sweep duration.");
+    appendPromHist(out, "wifi_scan_seconds", nullptr, metrics.wifiScanUs);
+    appendPromHeader(out, "results_build_seconds", "histogram", "Publishing and sorting baseline results.");
+    appendPromHist(out, "results_build_seconds", nullptr, metrics.resultsBuildUs);
+    appendPromHeader(out, "results_chunk_seconds", "histogram", "Rendering one chunk of a results download.");
+    appendPromHist(out, "results_chunk_seconds", nullptr, metrics.resultsChunkUs);
+    
+    appendPromHeader(out, "mutex_wait_seconds", "histogram", "Time spent waiting for a mutex.");
+    for (size_t i = 0; i < (size_t)LockId::COUNT; i++) {
+        const String label = "mutex=\"" + String(LOCK_NAMES[i]) + "\"";
+        appendPromHist(out, "mutex_wait_seconds", label.c_str(), metrics.locks[i].waitUs);
+    }
+    appendPromHeader(out, "mutex_timeouts_total", "counter", "Mutex acquisitions that timed out.");
+    for (size_t i = 0; i < (size_t)LockId::COUNT; i++) {
+        const String label = "mutex=\"" + String(LOCK_NAMES[i]) + "\"";
+        appendPromValue(out, "mutex_timeouts_total", label.c_str(),
+                        String(metrics.locks[i].timeouts.load(std::memory_order_relaxed)));
+    }
     
-    if (xSemaphoreTake(filtersMutex, pdMS_TO_TICKS(500)) == pdTRUE) {
+    static const char* const HEAP_FIGURES[] = {"heap_free_bytes", "heap_min_free_bytes", "heap_largest_block_bytes"};
+    static const char* const HEAP_HELP[] = {"Free heap.", "Lowest free heap since boot.", "Largest allocatable block."};
+    for (uint8_t f = 0; f < 3; f++) {
+        appendPromHeader(out, HEAP_FIGURES[f], "gauge", HEAP_HELP[f]);
+        for (size_t i = 0; i < sizeof(HEAP_POOLS) / sizeof(HEAP_POOLS[0]); i++) {
+            const uint32_t caps = HEAP_POOLS[i].caps;
+            const size_t v = f == 0 ? heap_caps_get_free_size(caps) :
+                             f == 1 ? heap_caps_get_minimum_free_size(caps) :
+                                      heap_caps_get_largest_free_block(caps);
+            const String label = "pool=\"" + String(HEAP_POOLS[i].name) + "\"";
+            appendPromValue(out, HEAP_FIGURES[f], label.c_str(), String((uint32_t)v));
+        }
+    }
+    
+    appendPromHeader(out, "task_stack_free_bytes", "gauge", "Task stack high-water mark (least free since start).");
+    forEachKnownTask([&out](const char* name, TaskHandle_t h) {
+        const String label = "task=\"" + String(name) + "\"";
+        appendPromValue(out, "task_stack_free_bytes", label.c_str(), String(uxTaskGetStackHighWaterMark(h)));
+    });
+    return out;
+}
+
+// Everything the static index page fills in after it loads
+String renderUiStateJson() {
+    String json = "{\"filters\":[";
+    if (lockTake(LockId::FILTERS, filtersMutex, pdMS_TO_TICKS(500))) {
         for (size_t i = 0; i < filters.size(); ++i) {
-            if (i) fl += "\n";
-            fl += filters[i];
+            if (i) json += ",";
+            json += "\"" + jsonEscape(filters[i].c_str()) + "\"";
         }
         xSemaphoreGive(filtersMutex);
     }
+    json += "],\"max_filters\":" + String(Config::MAX_FILTERS);
+    json += ",\"watchlist_count\":" + String(watchlist.count);
+    json += ",\"watchlist_max\":" + String(Config::WATCHLIST_MAX_ENTRIES);
+    json += ",\"mode_run_max_min\":" + String(Config::MODE_RUN_MAX_MIN);
+    json += ",\"mode\":" + renderModeStatusJson();
+    json += ",\"memory\":" + renderMemoryStatusJson();
+    json += "}";
+    return json;
+}
+
+// Status pages link the cached stylesheet, so each one carries only its text
+String messagePage(const char* title, const String& body, bool homeLink = true) {
+    String html;
+    html.reserve(320 + body.length());
+    html += F("<!DOCTYPE html><html><head><meta charset='utf-8'>"
+              "<meta name='viewport' content='width=device-width, initial-scale=1'>"
+              "<link rel='stylesheet' href='");
+    html += WEB_STYLE_CSS_URL;
+    html += F("'><title>");
+    html += title;
+    html += F("</title></head><body><div class='card'><h2>");
+    html += title;
+    html += F("</h2>");
+    html += body;
+    if (homeLink) html += F("<p><a href='/'>Home</a></p>");
+    html += F("</div></body></html>");
+    return html;
+}
+
+// Static assets are gzipped at build time (tools/gen_web_assets.py). The
+// ETag changes with the content, so a revalidating browser gets a 304.
+// Pages are no-cache; the stylesheet is immutable behind a versioned URL.
+void sendWebAsset(AsyncWebServerRequest* req, const WebAsset& asset) {
+    if (req->hasHeader("If-None-Match") && req->header("If-None-Match") == asset.etag) {
+        AsyncWebServerResponse* res = req->beginResponse(304, "text/plain", String());
+        res->addHeader("ETag", asset.etag);
+        req->send(res);
+        return;
+    }
+    AsyncWebServerResponse* res = req->beginResponse(200, asset.contentType, asset.gz, asset.gzLen);
+    res->addHeader("Content-Encoding", "gzip");
+    res->addHeader("Cache-Control", asset.cacheControl);
+    res->addHeader("ETag", asset.etag);
+    req->send(res);
+}
+
+// ================================
+// LIVE EVENT STREAM
+// ================================
+// One /events channel for every open page. loop() pushes at most once per
+// EVENTS_INTERVAL_MS and only what changed; several updates inside that
+// window collapse into one event. A push is skipped while clients are
+// still draining earlier ones, and the next push re-reads current state.
+//   status   - memory counters, every EVENTS_STATUS_MS
+//   mode     - current mode, on change
+//   baseline - progress plus the newest changed devices, while it changes
+// Detect and hunt drop the AP, so their events can't reach a browser; the
+// page catches up from the mode event when the AP comes back.
+
+AsyncEventSource events("/events");
+
+struct EventStream {
+    uint32_t nextId;
+    uint32_t lastPushMs;
+    uint32_t lastStatusMs;
+    uint32_t liveRun;
+    uint32_t liveSeq;
+    bool baselineWas;
+    const char* modeWas;
+};
+
+static EventStream eventStream = {1, 0, 0, 0, 0, false, nullptr};
+
+inline const char* currentModeName() {
+    return baselineRunning ? "baseline" : runModeName(runMode);
+}
+
+// Newest changes first, capped, and the cursor jumps to the head, so a busy
+// scan still produces one small event per push. Empty = nothing new (or busy).
+String renderLiveEventJson(uint32_t& cursor, uint32_t& run, bool force) {
+    if (!lockTake(LockId::LIVE, liveMutex, pdMS_TO_TICKS(20))) return String();
+    
+    if (!liveTable) {
+        xSemaphoreGive(liveMutex);
+        if (!force) return String();
+        return String("{\"run\":0,\"seq\":0,\"running\":false,\"count\":0,\"devices\":[]}");
+    }
     
-    String resultsSection = renderIndexResultsSection();
+    const DeviceTable& t = *liveTable;
+    if (run != liveRunId || cursor > t.seqCounter) {
+        run = liveRunId;
+        cursor = 0;
+        force = true;
+    }
+    if (!force && t.seqCounter == cursor) {
+        xSemaphoreGive(liveMutex);
+        return String();
+    }
+    
+    std::vector<uint32_t> changed;
+    for (uint32_t slot = 0; slot < t.capacity; ++slot) {
+        if (t.used(slot) && t.seq[slot] > cursor) changed.push_back(slot);
+    }
+    const uint32_t* seq = t.seq;
+    auto newest = [seq](uint32_t a, uint32_t b) { return seq[a] > seq[b]; };
+    const size_t shown = std::min(changed.size(), (size_t)Config::EVENTS_DEVICE_LIMIT);
+    std::partial_sort(changed.begin(), changed.begin() + shown, changed.end(), newest);
+    
+    String json;
+    json.reserve(128 + shown * 120);
+    json += "{\"run\":" + String(liveRunId);
+    json += ",\"seq\":" + String(t.seqCounter);
+    json += ",\"running\":" + String(baselineRunning ? "true" : "false");
+    json += ",\"count\":" + String(t.count);
+    json += ",\"evictions\":" + String(t.evictions);
+    json += ",\"changed\":" + String((unsigned)changed.size());
+    json += ",\"devices\":[";
+    for (size_t i = 0; i < shown; ++i) {
+        if (i) json += ",";
+        appendLiveRecordJson(json, t, changed[i]);
+    }
+    json += "]}";
+    cursor = t.seqCounter;
     
-    String status;
-    if (runMode == RunMode::DETECT) {
-        status = "Detecting (AP down)";
-    } else if (runMode == RunMode::FOXHUNT) {
-        status = "Hunt (AP down)";
+    xSemaphoreGive(liveMutex);
+    return json;
+}
+
+void eventsSend(AsyncEventSourceClient* client, const String& json, const char* name) {
+    if (json.length() == 0) return;
+    const uint32_t id = eventStream.nextId++;
+    if (client) {
+        client->send(json.c_str(), name, id, Config::EVENTS_RETRY_MS);
     } else {
-        status = "Stopped";
+        events.send(json.c_str(), name, id);
+    }
+}
+
+// New clients get the full current state at once
+void eventsOnConnect(AsyncEventSourceClient* client) {
+    uint32_t cursor = 0;
+    uint32_t run = 0;
+    eventsSend(client, renderMemoryStatusJson(), "status");
+    eventsSend(client, renderModeStatusJson(), "mode");
+    eventsSend(client, renderLiveEventJson(cursor, run, true), "baseline");
+}
+
+// Called from loop()
+void eventsTick(uint32_t now) {
+    if (now - eventStream.lastPushMs < Config::EVENTS_INTERVAL_MS) return;
+    eventStream.lastPushMs = now;
+    if (events.count() == 0) return;
+    if (events.avgPacketsWaiting() > Config::EVENTS_MAX_QUEUED) return;
+    
+    const char* mode = currentModeName();
+    if (mode != eventStream.modeWas) {
+        eventStream.modeWas = mode;
+        eventsSend(nullptr, renderModeStatusJson(), "mode");
     }
     
-    String html = String(INDEX_HTML);
-    html.replace("%FILTERS%", fl);
-    html.replace("%LAST_RESULTS_SECTION%", resultsSection);
-    html.replace("%RUN_STATUS%", status);
-    html.replace("%MAX_FILTERS%", String(Config::MAX_FILTERS));
+    const bool running = baselineRunning;
+    if (running || running != eventStream.baselineWas || eventStream.liveRun != liveRunId) {
+        const bool edge = running != eventStream.baselineWas;
+        String json = renderLiveEventJson(eventStream.liveSeq, eventStream.liveRun, edge);
+        if (json.length() || !edge) eventStream.baselineWas = running;
+        eventsSend(nullptr, json, "baseline");
+    }
     
-    return html;
+    if (now - eventStream.lastStatusMs >= Config::EVENTS_STATUS_MS) {
+        eventStream.lastStatusMs = now;
+        eventsSend(nullptr, renderMemoryStatusJson(), "status");
+    }
 }
 
 void setupWeb() {
-    server.on("/", HTTP_GET, [](AsyncWebServerRequest *req) {
-        req->send(200, "text/html", buildIndex());
+    for (const WebAsset& asset : WEB_ASSETS) {
+        const WebAsset* a = &asset;
+        server.on(a->path, HTTP_GET, [a](AsyncWebServerRequest *req) {
+            sendWebAsset(req, *a);
+        });
+    }
+    
+    server.on("/ui_state", HTTP_GET, [](AsyncWebServerRequest *req) {
+        req->send(200, "application/json", renderUiStateJson());
+    });
+    
+    server.on("/results_section", HTTP_GET, [](AsyncWebServerRequest *req) {
+        ResultsPage page;
+        parseResultsPage(req, Config::RESULTS_SECTION_ROWS, page);
+        req->send(200, "text/html", renderIndexResultsSection(page));
     });
     
+    events.onConnect(eventsOnConnect);
+    server.addHandler(&events);
+    
     server.on("/save", HTTP_POST, [](AsyncWebServerRequest *req) {
         if (req->hasParam("filters", true)) {
             String body = req->getParam("filters", true)->value();
             
-            if (xSemaphoreTake(filtersMutex, pdMS_TO_TICKS(1000)) == pdTRUE) {
+            if (lockTake(LockId::FILTERS, filtersMutex, pdMS_TO_TICKS(1000))) {
                 filters.clear();
                 
                 int start = 0;
@@ -2151,7 +6113,7 @@ void setupWeb() {
                     line.trim();
                     if (!line.length()) continue;
                     
-                    if (isValidMAC(line)) {
+                    if (isValidFilterEntry(line)) {
                         filters.push_back(line);
                     } else {
                         Serial.printf("[WARN] Skipping invalid filter: %s\n", line.c_str());
@@ -2179,136 +6141,317 @@ void setupWeb() {
         req->redirect("/");
     });
     
+    server.on("/watchlist_upload", HTTP_POST,
+        [](AsyncWebServerRequest *req) {
+            bool merge = req->hasParam("merge") || req->hasParam("merge", true);
+            String reply;
+            const int status = watchlistUploadCommit(req, merge, reply);
+            if (status == 200 && req->hasParam("redirect", true)) {
+                req->redirect("/");
+                return;
+            }
+            req->send(status, "text/plain", reply);
+        },
+        [](AsyncWebServerRequest *req, const String& filename, size_t index,
+           uint8_t *data, size_t len, bool final) {
+            watchlistUploadFeed(req, data, len, index);
+        },
+        [](AsyncWebServerRequest *req, uint8_t *data, size_t len, size_t index, size_t total) {
+            watchlistUploadFeed(req, data, len, index);
+        });
+    
+    server.on("/watchlist_add", HTTP_POST, [](AsyncWebServerRequest *req) {
+        if (!req->hasParam("v", true)) {
+            req->send(400, "text/plain", "missing v\n");
+            return;
+        }
+        String v = req->getParam("v", true)->value();
+        v.trim();
+        WatchlistResult r = watchlistAdd(v);
+        req->send(r == WatchlistResult::ADDED ? 200 : 409, "text/plain",
+                  r == WatchlistResult::ADDED ? "added\n" :
+                  r == WatchlistResult::EXISTS ? "exists\n" :
+                  r == WatchlistResult::FULL ? "full\n" : "invalid\n");
+    });
+    
+    server.on("/watchlist_remove", HTTP_POST, [](AsyncWebServerRequest *req) {
+        if (!req->hasParam("v", true)) {
+            req->send(400, "text/plain", "missing v\n");
+            return;
+        }
+        String v = req->getParam("v", true)->value();
+        v.trim();
+        WatchlistResult r = watchlistRemove(v);
+        req->send(r == WatchlistResult::REMOVED ? 200 : 404, "text/plain",
+                  r == WatchlistResult::REMOVED ? "removed\n" : "not found\n");
+    });
+    
+    server.on("/watchlist_clear", HTTP_POST, [](AsyncWebServerRequest *req) {
+        watchlistClear();
+        req->redirect("/");
+    });
+    
+    server.on("/watchlist.bin", HTTP_GET, [](AsyncWebServerRequest *req) {
+        bool ok = false;
+        if (lockTake(LockId::FILTERS, filtersMutex, pdMS_TO_TICKS(1000))) {
+            ok = (watchlist.journalOps == 0 && LittleFS.exists(Config::WATCHLIST_PATH)) ||
+                 watchlistCompactLocked();
+            xSemaphoreGive(filtersMutex);
+        }
+        if (!ok) {
+            req->send(404, "text/plain", "No watchlist stored\n");
+            return;
+        }
+        req->send(LittleFS, Config::WATCHLIST_PATH, "application/octet-stream", true);
+    });
+    
+    server.on("/watchlist_status", HTTP_GET, [](AsyncWebServerRequest *req) {
+        uint32_t count = 0, journal = 0, ouis = 0, macs = 0;
+        bool fsReady = false;
+        if (lockTake(LockId::FILTERS, filtersMutex, pdMS_TO_TICKS(500))) {
+            count = watchlist.count;
+            journal = watchlist.journalOps;
+            fsReady = watchlist.fsReady;
+            // Indexes are only freed under filtersMutex
+            const FilterIndex* idx = activeFilterIndex.load(std::memory_order_acquire);
+            if (idx) {
+                ouis = idx->ouiCount;
+                macs = idx->macCount;
+            }
+            xSemaphoreGive(filtersMutex);
+        }
+        
+        String json = "{";
+        json += "\"entries\":" + String(count) + ",";
+        json += "\"capacity\":" + String(Config::WATCHLIST_MAX_ENTRIES) + ",";
+        json += "\"journal_ops\":" + String(journal) + ",";
+        json += "\"flash\":" + String(fsReady ? "true" : "false") + ",";
+        json += "\"compiled_ouis\":" + String(ouis) + ",";
+        json += "\"compiled_macs\":" + String(macs);
+        json += "}";
+        req->send(200, "application/json", json);
+    });
+    
     server.on("/baseline_start", HTTP_POST, [](AsyncWebServerRequest *req) {
         if (baselineRunning) {
-            req->send(200, "text/html",
-                "<!DOCTYPE html><html><head><meta name='viewport' content='width=device-width, initial-scale=1'>"
-                "<style>body{margin:0;padding:24px;background:#0f0f23;color:#e6ffee;font-family:Segoe UI}</style></head><body>"
-                "<div style='max-width:720px;margin:0 auto;background:#1a1f2b;padding:22px;border-radius:14px'>"
-                "<h2 style='color:#9be7a6'>Baseline already running</h2>"
-                "<p>When it finishes, you'll hear three beeps.</p>"
-                "<p><a href='/' style='color:#78f0a8'>Home</a></p></div></body></html>");
+            req->send(200, "text/html", messagePage("Baseline already running",
+                "<p>When it finishes, you'll hear three beeps.</p>"));
+            return;
+        }
+        if (benchRunning) {
+            req->send(200, "text/html", messagePage("Benchmark running",
+                "<p>See <a href='/bench_results'>/bench_results</a>; press BOOT to stop it.</p>"));
             return;
         }
         
         // Parse enhanced parameters
         String modeStr = "wifi";
-        uint32_t secs = 60;
-        int16_t rssiThreshold = -100;
-        bool capturePayload = false;
+        BaselineConfig cfg = {BaselineMode::WIFI_ONLY, 60, -100, false, false, false,
+                              Config::WIFI_SCAN_DWELL_MS, ScanProfile::ACTIVE_SCAN_RSP,
+                              false, Config::SURVEY_SNAPSHOT_SECS, ResultsSort::BEST_RSSI};
         
         if (req->hasParam("mode", true)) {
             modeStr = req->getParam("mode", true)->value();
         }
         if (req->hasParam("secs", true)) {
-            secs = req->getParam("secs", true)->value().toInt();
+            cfg.durationSecs = req->getParam("secs", true)->value().toInt();
         }
         if (req->hasParam("rssi_threshold", true)) {
-            rssiThreshold = req->getParam("rssi_threshold", true)->value().toInt();
+            cfg.rssiThreshold = req->getParam("rssi_threshold", true)->value().toInt();
         }
         if (req->hasParam("capture_payload", true)) {
-            capturePayload = true;
+            cfg.capturePayload = true;
+        }
+        if (req->hasParam("save_capture", true)) {
+            cfg.saveCapture = true;
+        }
+        if (req->hasParam("scan_type", true)) {
+            cfg.passiveScan = req->getParam("scan_type", true)->value() == "passive";
+        }
+        if (req->hasParam("dwell_ms", true)) {
+            cfg.dwellMs = req->getParam("dwell_ms", true)->value().toInt();
+        }
+        if (req->hasParam("scan_profile", true)) {
+            cfg.bleProfile = parseScanProfile(req->getParam("scan_profile", true)->value(), cfg.bleProfile);
+        }
+        if (req->hasParam("continuous", true)) {
+            cfg.continuous = true;
+        }
+        if (req->hasParam("sort_by", true)) {
+            cfg.sortKey = parseResultsSort(req->getParam("sort_by", true)->value(), cfg.sortKey);
+        }
+        if (req->hasParam("snapshot_secs", true)) {
+            cfg.snapshotSecs = req->getParam("snapshot_secs", true)->value().toInt();
         }
         
-        BaselineMode mode = BaselineMode::WIFI_ONLY;
-        if (modeStr == "ble") mode = BaselineMode::BLE_ONLY;
-        if (modeStr == "both") mode = BaselineMode::WIFI_AND_BLE;
+        if (modeStr == "ble") cfg.mode = BaselineMode::BLE_ONLY;
+        if (modeStr == "both") cfg.mode = BaselineMode::WIFI_AND_BLE;
         
-        startEnhancedBaseline(mode, secs, rssiThreshold, capturePayload);
+        startEnhancedBaseline(cfg);
         
-        String msg = "Baseline started with RSSI >= " + String(rssiThreshold) + " dBm";
+        const bool capturePayload = cfg.capturePayload;
+        String msg = "Baseline started with RSSI >= " + String(cfg.rssiThreshold) + " dBm";
         if (capturePayload) {
             msg += " (Payload capture enabled - max " + String(Config::MAX_PAYLOAD_DEVICES) + " devices)";
         }
+        if (cfg.continuous) {
+            msg += ". Continuous survey, snapshot every " + String(cfg.snapshotSecs) + " s until stopped";
+        }
         
-        req->send(200, "text/html",
-            "<!DOCTYPE html><html><head><meta charset='utf-8'><meta name='viewport' content='width=device-width, initial-scale=1'>"
-            "<style>body{margin:0;padding:24px;background:#0f0f23;color:#e6ffee;font-family:Segoe UI}"
-            ".card{max-width:720px;margin:0 auto;background:#1a1f2b;border-radius:14px;padding:22px}</style>"
-            "</head><body><div class='card'>"
-            "<h2 style='color:#9be7a6'>Baseline Started</h2>"
+        req->send(200, "text/html", messagePage("Baseline Started",
             "<p>" + msg + "</p>"
             "<p>When baseline completes, you'll hear three beeps and results will appear on the home page.</p>"
-            "<p><a href='/' style='color:#78f0a8'>Home</a></p>"
-            "</div></body></html>");
+            "<p>Devices so far: <b id='live'>0</b> <span id='liveState'></span></p>"
+            "<script>"
+            "let since=0,run=0;"
+            "function poll(){fetch('/baseline_live?since='+since+'&run='+run).then(r=>r.json()).then(j=>{"
+            "run=j.run;since=j.seq;document.getElementById('live').textContent=j.count;"
+            "document.getElementById('liveState').textContent=j.running?'(scanning)':'(done)';"
+            "setTimeout(poll,j.more?100:2000);}).catch(()=>setTimeout(poll,3000));}"
+            "setTimeout(poll,1000);"
+            "</script>"));
+    });
+    
+    server.on("/baseline_stop", HTTP_POST, [](AsyncWebServerRequest *req) {
+        if (!baselineRunning) {
+            req->send(200, "text/plain", "No baseline running");
+            return;
+        }
+        baselineStopRequested = true;
+        req->redirect("/");
+    });
+    
+    server.on("/survey_status", HTTP_GET, [](AsyncWebServerRequest *req) {
+        req->send(200, "application/json", renderSurveyStatusJson());
+    });
+    
+    server.on("/survey.bin", HTTP_GET, [](AsyncWebServerRequest *req) {
+        std::shared_ptr<SurveyStream> st = std::make_shared<SurveyStream>();
+        st->started = false;
+        AsyncWebServerResponse *res = req->beginChunkedResponse("application/octet-stream",
+            [st](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+                return surveyStreamFill(*st, buffer, maxLen);
+            });
+        res->addHeader("Content-Disposition", "attachment; filename=\"survey.bin\"");
+        req->send(res);
     });
     
     server.on("/baseline_results", HTTP_GET, [](AsyncWebServerRequest *req) {
-        if (xSemaphoreTake(resultsMutex, pdMS_TO_TICKS(500)) == pdTRUE) {
-            String html = lastResultsHTMLFull.length() ? lastResultsHTMLFull :
-                "<!DOCTYPE html><html><head><meta charset='utf-8'><title>Baseline Results</title></head>"
-                "<body style='background:#0f0f23;color:#e6ffee;font-family:Segoe UI,Tahoma,Arial,sans-serif;padding:24px'>"
-                "<div style='max-width:720px;margin:0 auto;background:#1a1f2b;border:1px solid #22314a;border-radius:14px;padding:22px'>"
-                "<h2 style='color:#9be7a6'>Baseline Results</h2>"
-                "<p>No baseline run yet.</p><a href='/' style='color:#78f0a8'>Back</a></div></body></html>";
-            xSemaphoreGive(resultsMutex);
-            req->send(200, "text/html", html);
-        } else {
-            req->send(503, "text/plain", "Results temporarily unavailable");
+        AsyncWebServerResponse *res = beginResultsStream(req, ResultsDoc::HTML, "text/html");
+        if (res) {
+            req->send(res);
+            return;
         }
+        req->send(200, "text/html", messagePage("Baseline Results", "<p>No baseline run yet.</p>"));
     });
     
     server.on("/baseline_results.csv", HTTP_GET, [](AsyncWebServerRequest *req) {
-        String payload;
-        
-        if (xSemaphoreTake(resultsMutex, pdMS_TO_TICKS(500)) == pdTRUE) {
-            payload = lastResultsCSV.length() ? lastResultsCSV : 
-                      String("MAC,Source,RSSI,Complete Local Name\n");
-            xSemaphoreGive(resultsMutex);
-        } else {
-            payload = "MAC,Source,RSSI,Complete Local Name\n";
+        AsyncWebServerResponse *res = beginResultsStream(req, ResultsDoc::CSV, "text/csv");
+        if (!res) {
+            res = req->beginResponse(200, "text/csv", "MAC,Source,RSSI,Complete Local Name\n");
         }
-        
-        AsyncWebServerResponse *res = req->beginResponse(200, "text/csv", payload);
         res->addHeader("Content-Disposition", "attachment; filename=\"baseline_results.csv\"");
         req->send(res);
     });
     
+    server.on("/baseline_live", HTTP_GET, [](AsyncWebServerRequest *req) {
+        uint32_t since = 0;
+        uint32_t run = 0;
+        if (req->hasParam("since")) since = strtoul(req->getParam("since")->value().c_str(), nullptr, 10);
+        if (req->hasParam("run")) run = strtoul(req->getParam("run")->value().c_str(), nullptr, 10);
+        
+        String json = renderLiveJson(since, run);
+        if (json.length() == 0) {
+            req->send(503, "application/json", "{\"error\":\"busy\"}");
+            return;
+        }
+        req->send(200, "application/json", json);
+    });
+    
+    server.on("/baseline_results.bin", HTTP_GET, [](AsyncWebServerRequest *req) {
+        AsyncWebServerResponse *res = beginResultsStream(req, ResultsDoc::BIN, "application/octet-stream");
+        if (!res) {
+            req->send(404, "text/plain", "No baseline run yet");
+            return;
+        }
+        res->addHeader("Content-Disposition", "attachment; filename=\"baseline_capture.bin\"");
+        req->send(res);
+    });
+    
+    server.on("/capture.bin", HTTP_GET, [](AsyncWebServerRequest *req) {
+        if (!LittleFS.exists(Config::CAPTURE_PATH)) {
+            req->send(404, "text/plain", "No saved capture");
+            return;
+        }
+        req->send(LittleFS, Config::CAPTURE_PATH, "application/octet-stream", true);
+    });
+    
     server.on("/baseline_results_detailed.txt", HTTP_GET, [](AsyncWebServerRequest *req) {
-        String payload;
+        AsyncWebServerResponse *res = beginResultsStream(req, ResultsDoc::TXT, "text/plain");
+        if (!res) {
+            res = req->beginResponse(200, "text/plain", "No detailed report available.\n");
+        }
+        res->addHeader("Content-Disposition", "attachment; filename=\"baseline_detailed.txt\"");
+        req->send(res);
+    });
+    
+    server.on("/captures", HTTP_GET, [](AsyncWebServerRequest *req) {
+        String json = renderCaptureLogJson();
+        if (json.length() == 0) {
+            req->send(503, "application/json", "{\"error\":\"busy\"}");
+            return;
+        }
+        req->send(200, "application/json", json);
+    });
+    
+    server.on("/capture_log.bin", HTTP_GET, [](AsyncWebServerRequest *req) {
+        const uint32_t id = req->hasParam("id") ? strtoul(req->getParam("id")->value().c_str(), nullptr, 10) : 0;
+        std::shared_ptr<LogStream> st = std::make_shared<LogStream>();
+        st->started = false;
+        st->done = false;
+        st->len = 0;
+        st->off = 0;
         
-        if (xSemaphoreTake(resultsMutex, pdMS_TO_TICKS(500)) == pdTRUE) {
-            payload = detailedReportTxt.length() ? detailedReportTxt : 
-                      String("No detailed report available.\n");
-            xSemaphoreGive(resultsMutex);
+        int code = 200;
+        if (!capLog.ready) {
+            code = 404;
+        } else if (xSemaphoreTake(logMutex, pdMS_TO_TICKS(200)) != pdTRUE) {
+            code = 503;
         } else {
-            payload = "Results temporarily unavailable.\n";
+            const LogSession* s = logFindLocked(id);
+            if (!s || !logCursorOpen(st->cur, *s)) code = 404;
+            else st->records = s->records;
+            xSemaphoreGive(logMutex);
+        }
+        if (code != 200) {
+            req->send(code, "text/plain", code == 503 ? "Busy" : "No such session");
+            return;
         }
         
-        AsyncWebServerResponse *res = req->beginResponse(200, "text/plain", payload);
-        res->addHeader("Content-Disposition", "attachment; filename=\"baseline_detailed.txt\"");
+        AsyncWebServerResponse *res = req->beginChunkedResponse("application/octet-stream",
+            [st](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+                return logStreamFill(*st, buffer, maxLen);
+            });
+        res->addHeader("Content-Disposition", "attachment; filename=\"session_" + String(id) + ".bin\"");
         req->send(res);
     });
     
     server.on("/memory_status", HTTP_GET, [](AsyncWebServerRequest *req) {
-        String json = "{";
-        json += "\"free_heap\":" + String(ESP.getFreeHeap()) + ",";
-        json += "\"payload_memory\":" + String(currentPayloadMemory) + ",";
-        json += "\"max_payload_memory\":" + String(Config::MAX_PAYLOAD_MEMORY) + ",";
-        json += "\"max_devices\":" + String(Config::MAX_PAYLOAD_DEVICES);
-        json += "}";
-        req->send(200, "application/json", json);
+        req->send(200, "application/json", renderMemoryStatusJson());
     });
     
     server.on("/detect_start", HTTP_POST, [](AsyncWebServerRequest *req) {
-        if (detectState.running) {
-            req->send(200, "text/html",
-                "<!DOCTYPE html><html><body style='background:#0f0f23;color:#e6ffee;font-family:Segoe UI;padding:24px'>"
-                "<p>Already running (AP is dropped). Power-cycle to stop.</p></body></html>");
+        if (modeBusy()) {
+            req->send(200, "text/html", messagePage("Busy",
+                "<p>Another mode is running. Stop it first (BOOT button, or Stop on the home page for a baseline).</p>"));
             return;
         }
         
-        bool hasFilters = false;
-        if (xSemaphoreTake(filtersMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-            hasFilters = !filters.empty();
-            xSemaphoreGive(filtersMutex);
-        }
+        bool hasFilters = compiledFilterCount() > 0;
         
         if (!hasFilters) {
-            req->send(200, "text/html",
-                "<!DOCTYPE html><html><body style='background:#0f0f23;color:#e6ffee;font-family:Segoe UI;padding:24px'>"
-                "<p>Please add at least one filter (OUI or MAC) before starting detection.</p>"
-                "<p><a href='/' style='color:#78f0a8'>Back</a></p></body></html>");
+            req->send(200, "text/html", messagePage("No filters",
+                "<p>Please add at least one filter (OUI or MAC) before starting detection.</p>"));
             return;
         }
         
@@ -2319,90 +6462,156 @@ void setupWeb() {
         
         bool stealth = req->hasParam("stealth", true);
         
+        HopPolicy hop = HopPolicy::WEIGHTED;
+        if (req->hasParam("hop", true)) {
+            hop = parseHopPolicy(req->getParam("hop", true)->value());
+        }
+        ScanProfile profile = ScanProfile::BALANCED;
+        if (req->hasParam("scan_profile", true)) {
+            profile = parseScanProfile(req->getParam("scan_profile", true)->value(), profile);
+        }
+        int lockCh = 0;
+        if (req->hasParam("lock_ch", true)) {
+            lockCh = constrain(req->getParam("lock_ch", true)->value().toInt(), 0, (int)Config::PROMISC_MAX_CHANNEL);
+        }
+        
         DetectionMode mode = DetectionMode::WIFI_ONLY;
         if (modeStr == "ble") mode = DetectionMode::BLE_ONLY;
         if (modeStr == "both") mode = DetectionMode::WIFI_AND_BLE;
+        const uint32_t runSecs = parseRunSecs(req);
+        uint16_t latencySecs = 0;
+        if (req->hasParam("latency_s", true)) {
+            const long v = req->getParam("latency_s", true)->value().toInt();
+            if (v > 0) latencySecs = (uint16_t)constrain(v, (long)Config::POWER_LATENCY_MIN_S, (long)Config::POWER_LATENCY_MAX_S);
+        }
         
-        req->send(200, "text/html",
-            "<!DOCTYPE html><html><head><meta charset='utf-8'><meta name='viewport' content='width=device-width, initial-scale=1'>"
-            "<style>body{margin:0;padding:24px;background:#0f0f23;color:#e6ffee;font-family:Segoe UI}"
-            ".card{max-width:720px;margin:0 auto;background:#1a1f2b;border:1px solid #22314a;border-radius:14px;padding:22px}</style>"
-            "</head><body><div class='card'>"
-            "<h2 style='color:#9be7a6'>Starting Detection</h2>"
-            "<p>The access point will shut down now. Detection will run continuously. Power-cycle to stop.</p>"
-            "<p>Close this page.</p>"
-            "</div></body></html>");
+        req->send(200, "text/html", messagePage("Starting Detection",
+            "<p>The access point will shut down now. Detection runs until you press BOOT"
+            " (or the return-to-AP time passes), then the AP comes back.</p>"
+            "<p>Close this page.</p>", false));
         
         vTaskDelay(pdMS_TO_TICKS(200));
         
-        DetectParams* dp = new DetectParams{mode, stealth};
-        BaseType_t result = xTaskCreatePinnedToCore(
-            detectionTask, 
-            "detectionTask", 
-            Config::DETECTION_STACK_SIZE, 
-            dp, 
-            Config::TASK_PRIORITY, 
-            NULL, 
-            Config::TASK_CORE
-        );
-        
-        if (result != pdPASS) {
-            Serial.println("[ERROR] Failed to create detection task");
-            delete dp;
-        }
+        modeStartDetect(DetectParams{mode, stealth, hop, (uint8_t)lockCh, profile, runSecs, latencySecs});
     });
     
     server.on("/hunt_start", HTTP_POST, [](AsyncWebServerRequest *req) {
-        if (foxState.running) {
-            req->send(200, "text/html",
-                "<!DOCTYPE html><html><body style='background:#0f0f23;color:#e6ffee;font-family:Segoe UI;padding:24px'>"
-                "<p>Already running (AP is dropped). Power-cycle to stop.</p></body></html>");
+        if (modeBusy()) {
+            req->send(200, "text/html", messagePage("Busy",
+                "<p>Another mode is running. Stop it first (BOOT button, or Stop on the home page for a baseline).</p>"));
             return;
         }
         
-        bool hasFilters = false;
-        if (xSemaphoreTake(filtersMutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-            hasFilters = !filters.empty();
-            xSemaphoreGive(filtersMutex);
-        }
+        bool hasFilters = compiledFilterCount() > 0;
         
         if (!hasFilters) {
-            req->send(200, "text/html",
-                "<!DOCTYPE html><html><body style='background:#0f0f23;color:#e6ffee;font-family:Segoe UI;padding:24px'>"
-                "<p>Hunt uses your saved Detection Filters. Please add at least one filter first.</p>"
-                "<p><a href='/' style='color:#78f0a8'>Back</a></p></body></html>");
+            req->send(200, "text/html", messagePage("No filters",
+                "<p>Hunt uses your saved Detection Filters. Please add at least one filter first.</p>"));
             return;
         }
         
         bool stealth = req->hasParam("stealth", true);
         
-        req->send(200, "text/html",
-            "<!DOCTYPE html><html><head><meta charset='utf-8'><meta name='viewport' content='width=device-width, initial-scale=1'>"
-            "<style>body{margin:0;padding:24px;background:#0f0f23;color:#e6ffee;font-family:Segoe UI}"
-            ".card{max-width:720px;margin:0 auto;background:#1a1f2b;border:1px solid #22314a;border-radius:14px;padding:22px}</style>"
-            "</head><body><div class='card'>"
-            "<h2 style='color:#9be7a6'>Starting Hunt (BLE only)</h2>"
-            "<p>The access point will shut down now. Hunt will run continuously. Power-cycle to stop.</p>"
-            "<p>Close this page.</p>"
-            "</div></body></html>");
+        // Kalman presets: process noise q (dB^2/s), measurement noise r (dB^2)
+        float q = Config::FOX_KALMAN_Q;
+        float r = Config::FOX_KALMAN_R;
+        if (req->hasParam("smooth", true)) {
+            const String smooth = req->getParam("smooth", true)->value();
+            if (smooth == "light") { q = 12.0f; r = 9.0f; }
+            if (smooth == "heavy") { q = 1.5f; r = 36.0f; }
+        }
+        
+        ScanProfile profile = ScanProfile::MAX_CAPTURE;
+        if (req->hasParam("scan_profile", true)) {
+            profile = parseScanProfile(req->getParam("scan_profile", true)->value(), profile);
+        }
+        
+        const uint32_t runSecs = parseRunSecs(req);
+        uint64_t focusMac = 0;
+        if (req->hasParam("focus", true)) {
+            const String focus = req->getParam("focus", true)->value();
+            if (focus.length() && parseMacFilter(focus, focusMac) != 12) {
+                req->send(400, "text/plain", "Focus must be a full MAC (12 hex digits)");
+                return;
+            }
+        }
+        
+        req->send(200, "text/html", messagePage("Starting Hunt (BLE only)",
+            "<p>The access point will shut down now. Hunt runs until you press BOOT"
+            " (or the return-to-AP time passes), then the AP comes back.</p>"
+            "<p>Close this page.</p>", false));
         
         vTaskDelay(pdMS_TO_TICKS(200));
         
-        FoxParams* fp = new FoxParams{DetectionMode::BLE_ONLY, stealth};
-        BaseType_t result = xTaskCreatePinnedToCore(
-            foxHuntTask, 
-            "foxHuntTask", 
-            Config::DETECTION_STACK_SIZE, 
-            fp, 
-            Config::TASK_PRIORITY, 
-            NULL, 
-            Config::TASK_CORE
-        );
+        modeStartFox(FoxParams{DetectionMode::BLE_ONLY, stealth, q, r, focusMac, profile, runSecs});
+    });
+    
+    server.on("/channel_stats", HTTP_GET, [](AsyncWebServerRequest *req) {
+        req->send(200, "application/json", renderChannelStatsJson());
+    });
+    
+    server.on("/mode_status", HTTP_GET, [](AsyncWebServerRequest *req) {
+        req->send(200, "application/json", renderModeStatusJson());
+    });
+    
+    server.on("/filter_stats", HTTP_GET, [](AsyncWebServerRequest *req) {
+        req->send(200, "application/json", renderFilterStatsJson());
+    });
+    
+    server.on("/hunt_status", HTTP_GET, [](AsyncWebServerRequest *req) {
+        req->send(200, "application/json", renderHuntStatusJson());
+    });
+    
+    server.on("/hunt_focus", HTTP_POST, [](AsyncWebServerRequest *req) {
+        uint64_t mac48 = 0;
+        if (req->hasParam("mac", true)) {
+            const String mac = req->getParam("mac", true)->value();
+            if (mac.length() && mac != "auto" && parseMacFilter(mac, mac48) != 12) {
+                req->send(400, "text/plain", "mac must be a full MAC or 'auto'");
+                return;
+            }
+        }
+        foxSetFocus(mac48);
+        req->send(200, "application/json", renderHuntStatusJson());
+    });
+    
+    server.on("/scan_profiles", HTTP_GET, [](AsyncWebServerRequest *req) {
+        req->send(200, "application/json", renderScanProfilesJson());
+    });
+    
+    server.on("/task_status", HTTP_GET, [](AsyncWebServerRequest *req) {
+        req->send(200, "application/json", renderTaskStatusJson());
+    });
+    
+    server.on("/metrics", HTTP_GET, [](AsyncWebServerRequest *req) {
+        req->send(200, "text/plain; version=0.0.4", renderMetricsPrometheus());
+    });
+    server.on("/metrics.json", HTTP_GET, [](AsyncWebServerRequest *req) {
+        req->send(200, "application/json", renderMetricsJson());
+    });
+    
+    // Query or form parameters, clamped
+    server.on("/bench_start", HTTP_POST, [](AsyncWebServerRequest *req) {
+        auto param = [req](const char* name, long def, long lo, long hi) -> long {
+            const AsyncWebParameter* p = req->hasParam(name, true) ? req->getParam(name, true) :
+                                         req->hasParam(name) ? req->getParam(name) : nullptr;
+            return p ? constrain(p->value().toInt(), lo, hi) : def;
+        };
+        BenchParams p;
+        p.rate = (uint32_t)param("rate", Config::BENCH_RATE, 0, Config::BENCH_MAX_RATE);
+        p.uniques = (uint16_t)param("uniques", Config::BENCH_UNIQUES, 1, Config::BENCH_MAX_UNIQUES);
+        p.payloadLen = (uint8_t)param("payload", Config::BENCH_PAYLOAD_BYTES, 3, Config::MAX_PAYLOAD_SIZE);
+        p.hitPct = (uint8_t)param("hit_pct", Config::BENCH_HIT_PCT, 0, 100);
+        p.phaseSecs = (uint8_t)param("secs", Config::BENCH_PHASE_SECS, 1, Config::BENCH_MAX_PHASE_SECS);
         
-        if (result != pdPASS) {
-            Serial.println("[ERROR] Failed to create fox hunt task");
-            delete fp;
+        if (!startBenchmark(p)) {
+            req->send(409, "application/json", "{\"error\":\"busy\"}");
+            return;
         }
+        req->send(202, "application/json", "{\"run\":" + String(bench.run) + "}");
+    });
+    server.on("/bench_results", HTTP_GET, [](AsyncWebServerRequest *req) {
+        req->send(200, "application/json", renderBenchJson());
     });
     
     server.on("/health", HTTP_GET, [](AsyncWebServerRequest *req) {
@@ -2410,7 +6619,7 @@ void setupWeb() {
     });
     
     server.on("/beep", HTTP_GET, [](AsyncWebServerRequest *req) {
-        Hardware::detectBeep();
+        outputPlay(OUT_PRESENCE);
         req->send(200, "text/plain", "beep");
     });
     
@@ -2430,23 +6639,35 @@ void setup() {
     detectMutex = xSemaphoreCreateMutex();
     filtersMutex = xSemaphoreCreateMutex();
     resultsMutex = xSemaphoreCreateMutex();
+    liveMutex = xSemaphoreCreateMutex();
+    surveyMutex = xSemaphoreCreateMutex();
     
-    if (!detectMutex || !filtersMutex || !resultsMutex) {
+    if (!detectMutex || !filtersMutex || !resultsMutex || !liveMutex || !surveyMutex) {
         Serial.println("[ERROR] Failed to create mutexes!");
         return;
     }
     
-    Hardware::ledOff();
-    Hardware::startupBeep();
-    
-    loadFilters();
-    Serial.printf("[BOOT] filters=%u\n", (unsigned)filters.size());
+    if (!baselineTables[0].init(Config::DEVICE_TABLE_CAPACITY) ||
+        !baselineTables[1].init(Config::DEVICE_TABLE_CAPACITY)) {
+        Serial.println("[ERROR] Failed to allocate device tables!");
+    }
     
-    WiFi.mode(WIFI_AP);
-    bool ok = WiFi.softAP(Config::AP_SSID, Config::AP_PASS);
-    Serial.printf("[AP] %s, IP=%s\n", ok ? "started" : "FAILED", 
-                  WiFi.softAPIP().toString().c_str());
+    outputInit();
+    outputPlay(OUT_STARTUP);
     
+    loadFilters();
+    loadScanProfileStats();
+    watchlistInit();
+    captureLogInit();
+    advRingInit();
+    rotationInit();
+    wifiScanEngineInit();
+    Serial.printf("[BOOT] filters=%u watchlist=%u\n", (unsigned)filters.size(),
+                  (unsigned)watchlist.count);
+    
+    pinMode(Config::BUTTON_PIN, INPUT_PULLUP);
+    
+    bool ok = restoreWiFiAP();
     if (!ok) {
         Serial.println("[ERROR] Failed to start AP!");
     }
@@ -2458,13 +6679,17 @@ void setup() {
 }
 
 void loop() {
-    static uint32_t lastCheck = 0;
-    const uint32_t CHECK_INTERVAL_MS = 250;
-    
     uint32_t now = millis();
-    if (now - lastCheck >= CHECK_INTERVAL_MS) {
-        lastCheck = now;
+    modeButtonPoll(now);
+    eventsTick(now);
+    metricsTick(now);
+    filterIndexReclaimTick();
+    
+    // The AP is down during a power-plan run: only the button needs polling
+    if (powerPlan.active) {
+        powerPlan.wakeups++;
+        vTaskDelay(pdMS_TO_TICKS(Config::LOOP_POWER_MS));
+        return;
     }
-    
-    vTaskDelay(pdMS_TO_TICKS(10));
+    vTaskDelay(pdMS_TO_TICKS(Config::LOOP_MS));
 }
\ No newline at end of file
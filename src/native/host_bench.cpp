@@ -0,0 +1,625 @@
+/*
+ * Host benchmark and capture replay for the radio-independent core
+ * (lib/ouispy_core). Built only by the native environments:
+ *
+ *   pio run -e native && .pio/build/native/program [options] [capture.bin ...]
+ *   pio run -e native_asan && .pio/build/native_asan/program ...   (ASan + UBSan)
+ *
+ * Without captures it times the hot paths on synthetic adverts: adParse, the
+ * MAC and content filter lookups, MAC text helpers, table aggregation, the
+ * result sort and the CSV / detailed report renderers. Each capture file
+ * (/baseline_results.bin, /capture.bin or /capture_log.bin?id=N) is replayed
+ * through the same aggregation path and rendered again, so real recordings
+ * can be profiled and sanitized the same way.
+ *
+ * Options:
+ *   --iters N      operations per micro benchmark (default 200000)
+ *   --devices N    distinct devices for aggregation and reports (default 1000)
+ *   --filters F    filter list, one entry per line (default: synthetic)
+ *   --fuzz N       also run N random / mutated payloads through the parsers
+ *   --out DIR      write <capture>.csv and <capture>.txt for each replay
+ */
+
+#include "text_util.h"
+#include "ad_parse.h"
+#include "device_table.h"
+#include "filter_index.h"
+#include "reports.h"
+#include "capture_format.h"
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+// ================================
+// CONFIGURATION CONSTANTS
+// ================================
+namespace HostConfig {
+    static const uint32_t ITERS = 200000;
+    static const uint32_t DEVICES = 1000;
+    static const uint32_t MAX_DEVICES = 1000000;
+    static const uint16_t FILTERS = 100;             // Config::MAX_FILTERS on the board
+    static const uint32_t WATCHLIST_KEYS = 10000;
+    static const uint8_t HIT_PCT = 10;
+    static const uint32_t LOOKUP_MACS = 4096;        // power of two
+    static const uint32_t MIN_TABLE_CAPACITY = 4096;
+    static const uint16_t WIFI_SHARE = 8;            // one AP per this many devices
+}
+
+// ================================
+// UTILITY FUNCTIONS
+// ================================
+
+static volatile uint64_t sink;   // keeps results observable to the optimizer
+
+static inline uint64_t nowNs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct Rng {
+    uint32_t s;
+    explicit Rng(uint32_t seed) : s(seed ? seed : 1) {}
+    uint32_t next() {
+        s ^= s << 13;
+        s ^= s >> 17;
+        s ^= s << 5;
+        return s;
+    }
+};
+
+static void report(const char* name, uint64_t ops, uint64_t ns, uint64_t bytes = 0) {
+    const double perOp = ops ? (double)ns / ops : 0.0;
+    printf("[BENCH] %-28s %10llu ops %10.1f ns/op %8.2f Mops/s", name, (unsigned long long)ops, perOp,
+           perOp > 0 ? 1000.0 / perOp : 0.0);
+    if (bytes) printf(" %8.1f MB/s", ns ? bytes * 1000.0 / ns : 0.0);
+    printf("\n");
+}
+
+static uint32_t tableCapacityFor(uint32_t devices) {
+    const uint64_t need = (uint64_t)devices * 100 / Config::DEVICE_TABLE_MAX_LOAD_PCT + 1;
+    uint32_t cap = HostConfig::MIN_TABLE_CAPACITY;
+    while (cap < need) cap <<= 1;
+    return cap;
+}
+
+static bool readFile(const char* path, std::vector<uint8_t>& out) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    uint8_t buf[4096];
+    size_t n;
+    out.clear();
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out.insert(out.end(), buf, buf + n);
+    const bool ok = !ferror(f);
+    fclose(f);
+    return ok;
+}
+
+static bool writeFile(const std::string& path, const String& text) {
+    FILE* f = fopen(path.c_str(), "wb");
+    if (!f) return false;
+    const bool ok = fwrite(text.c_str(), 1, text.length(), f) == text.length();
+    return fclose(f) == 0 && ok;
+}
+
+// ================================
+// SYNTHETIC LOAD
+// ================================
+// Payload shapes seen in the field, each within MAX_PAYLOAD_SIZE (advert +
+// scan response): plain manufacturer data, an iBeacon, a named sensor with
+// UUID lists and service data, and a long combined payload.
+
+static const uint16_t COMPANIES[] = {0x004C, 0x0006, 0x0075, 0x00E0};
+static const uint8_t SHAPES = 4;
+
+struct Payload {
+    uint8_t data[Config::MAX_PAYLOAD_SIZE];
+    uint8_t len;
+};
+
+static void putAd(Payload& p, uint8_t type, const uint8_t* v, uint8_t n) {
+    if (p.len + 2 + n > Config::MAX_PAYLOAD_SIZE) return;
+    p.data[p.len++] = n + 1;
+    p.data[p.len++] = type;
+    memcpy(p.data + p.len, v, n);
+    p.len += n;
+}
+
+static Payload makePayload(uint8_t shape, Rng& rng) {
+    Payload p = {};
+    const uint8_t flags = 0x06;
+    putAd(p, 0x01, &flags, 1);
+    uint8_t v[40];
+    for (uint8_t i = 0; i < sizeof(v); i++) v[i] = (uint8_t)rng.next();
+    const uint16_t company = COMPANIES[rng.next() % 4];
+    v[0] = company & 0xFF;
+    v[1] = company >> 8;
+
+    switch (shape) {
+        case 0:
+            putAd(p, 0xFF, v, 24);
+            break;
+        case 1:
+            v[0] = 0x4C; v[1] = 0x00; v[2] = 0x02; v[3] = 0x15;   // iBeacon
+            putAd(p, 0xFF, v, 25);
+            break;
+        case 2: {
+            char name[12];
+            const int n = snprintf(name, sizeof(name), "Sensor-%04X", rng.next() & 0xFFFF);
+            putAd(p, 0x09, (const uint8_t*)name, (uint8_t)n);
+            const uint8_t uuids[] = {0x0F, 0x18, 0x1A, 0x18, 0x0A, 0x18};
+            putAd(p, 0x03, uuids, sizeof(uuids));
+            uint8_t svc[8] = {0x1A, 0x18};
+            memcpy(svc + 2, v + 2, 6);
+            putAd(p, 0x16, svc, sizeof(svc));
+            const uint8_t tx = 0xF4;
+            putAd(p, 0x0A, &tx, 1);
+            break;
+        }
+        default: {
+            putAd(p, 0xFF, v, 20);
+            putAd(p, 0x07, v + 20, 16);
+            const char* name = "Headphones";
+            putAd(p, 0x08, (const uint8_t*)name, (uint8_t)strlen(name));
+            const uint8_t appearance[] = {0x41, 0x09};
+            putAd(p, 0x19, appearance, sizeof(appearance));
+            break;
+        }
+    }
+    return p;
+}
+
+// Same mix the firmware allows: OUIs, full MACs and content rules, plus a
+// watchlist of packed keys
+static void makeFilters(Rng& rng, std::vector<String>& filters, std::vector<uint64_t>& watch) {
+    char buf[40];
+    for (uint16_t i = 0; i < HostConfig::FILTERS; i++) {
+        const uint32_t r = rng.next();
+        switch (i % 8) {
+            case 0:
+                snprintf(buf, sizeof(buf), "mfg:%04X:%02X", COMPANIES[r % 4], (r >> 8) & 0xFF);
+                break;
+            case 1:
+                snprintf(buf, sizeof(buf), "uuid:%04X", 0x1800 | (r & 0xFF));
+                break;
+            case 2:
+                snprintf(buf, sizeof(buf), "name:sensor-%X", r & 0xF);
+                break;
+            case 3: case 4:
+                snprintf(buf, sizeof(buf), "%02X:%02X:%02X", r & 0xFF, (r >> 8) & 0xFF, (r >> 16) & 0xFF);
+                break;
+            default:
+                snprintf(buf, sizeof(buf), "%02X:%02X:%02X:%02X:%02X:%02X", r & 0xFF, (r >> 8) & 0xFF,
+                         (r >> 16) & 0xFF, (r >> 24) & 0xFF, rng.next() & 0xFF, rng.next() & 0xFF);
+                break;
+        }
+        filters.push_back(String(buf));
+    }
+    for (uint32_t i = 0; i < HostConfig::WATCHLIST_KEYS; i++) {
+        const uint64_t v = ((uint64_t)rng.next() << 16) ^ rng.next();
+        watch.push_back(i % 4 ? (WATCH_KEY_MAC | (v & WATCH_VALUE_MASK)) : (WATCH_KEY_OUI | (v & 0xFFFFFF)));
+    }
+    std::sort(watch.begin(), watch.end());
+    watch.erase(std::unique(watch.begin(), watch.end()), watch.end());
+}
+
+static bool loadFilterFile(const char* path, std::vector<String>& filters) {
+    std::vector<uint8_t> raw;
+    if (!readFile(path, raw)) return false;
+    String line;
+    for (size_t i = 0; i <= raw.size(); i++) {
+        const char c = i < raw.size() ? (char)raw[i] : '\n';
+        if (c != '\n') {
+            line += c;
+            continue;
+        }
+        line.trim();
+        if (line.length() && line[0] != '#' && isValidFilterEntry(line)) filters.push_back(line);
+        line = "";
+    }
+    return true;
+}
+
+// Hits reuse keys from the index so lookups walk the real arrays; misses are
+// locally administered addresses the index rejects
+static uint64_t makeMac(const FilterIndex* idx, Rng& rng, bool hit) {
+    const uint64_t low = ((uint64_t)rng.next() << 16 ^ rng.next()) & 0xFFFFFF;
+    if (hit && idx && idx->ouiCount && (rng.next() & 1)) {
+        return ((uint64_t)idx->ouis[rng.next() % idx->ouiCount] << 24) | low;
+    }
+    if (hit && idx && idx->macCount) return idx->macs[rng.next() % idx->macCount];
+    uint64_t mac = 0x02BE00000000ULL | ((uint64_t)rng.next() & 0xFFFFFFFF);
+    while (filterIndexMatchesMac(idx, mac)) mac += 0x0100000000ULL;
+    return mac;
+}
+
+// ================================
+// MICRO BENCHMARKS
+// ================================
+
+static void benchParsing(uint32_t iters, Rng& rng) {
+    std::vector<Payload> payloads;
+    for (uint32_t i = 0; i < 256; i++) payloads.push_back(makePayload(i % SHAPES, rng));
+
+    AdView ad;
+    uint64_t sum = 0, bytes = 0;
+    const uint64_t t0 = nowNs();
+    for (uint32_t i = 0; i < iters; i++) {
+        const Payload& p = payloads[i & 255];
+        adParse(p.data, p.len, ad);
+        sum += ad.fieldCount + ad.name.len;
+        bytes += p.len;
+    }
+    report("adParse", iters, nowNs() - t0, bytes);
+
+    const uint32_t n = iters / 100 + 1;
+    bytes = 0;
+    const uint64_t t1 = nowNs();
+    for (uint32_t i = 0; i < n; i++) {
+        const Payload& p = payloads[i & 255];
+        adParse(p.data, p.len, ad);
+        const String txt = formatAdStructures(p.data, ad) + formatHexDump(p.data, p.len);
+        bytes += txt.length();
+    }
+    report("formatAdStructures+hexdump", n, nowNs() - t1, bytes);
+    sink = sum;
+}
+
+static void benchMacText(uint32_t iters, Rng& rng) {
+    std::vector<String> macs;
+    char buf[20];
+    for (uint32_t i = 0; i < 256; i++) {
+        const uint32_t a = rng.next(), b = rng.next();
+        snprintf(buf, sizeof(buf), i & 1 ? "%02x:%02x:%02x:%02x:%02x:%02x" : "%02X-%02X-%02X-%02X-%02X-%02X",
+                 a & 0xFF, (a >> 8) & 0xFF, (a >> 16) & 0xFF, a >> 24, b & 0xFF, (b >> 8) & 0xFF);
+        macs.push_back(String(buf));
+    }
+
+    uint64_t sum = 0;
+    uint64_t t0 = nowNs();
+    for (uint32_t i = 0; i < iters; i++) sum += macPretty(toUpperNoDelim(macs[i & 255])).length();
+    report("toUpperNoDelim+macPretty", iters, nowNs() - t0);
+
+    uint64_t v = 0;
+    t0 = nowNs();
+    for (uint32_t i = 0; i < iters; i++) sum += parseMacFilter(macs[i & 255], v) + (v & 1);
+    report("parseMacFilter", iters, nowNs() - t0);
+
+    t0 = nowNs();
+    for (uint32_t i = 0; i < iters; i++) sum += macPrettyU64(0xA4C138000000ULL + i).length();
+    report("macPrettyU64", iters, nowNs() - t0);
+    sink = sum;
+}
+
+static void benchFilters(uint32_t iters, const FilterIndex* idx, Rng& rng) {
+    std::vector<uint64_t> macs(HostConfig::LOOKUP_MACS);
+    for (uint32_t i = 0; i < macs.size(); i++) macs[i] = makeMac(idx, rng, rng.next() % 100 < HostConfig::HIT_PCT);
+
+    uint64_t hits = 0;
+    uint64_t t0 = nowNs();
+    for (uint32_t i = 0; i < iters; i++) hits += filterIndexMatchesMac(idx, macs[i & (HostConfig::LOOKUP_MACS - 1)]);
+    report("filterIndexMatchesMac", iters, nowNs() - t0);
+    printf("        %u OUIs, %u MACs, %u content rules; %.1f%% MAC hits\n", (unsigned)idx->ouiCount,
+           (unsigned)idx->macCount, (unsigned)idx->ruleCount, iters ? 100.0 * hits / iters : 0.0);
+
+    std::vector<Payload> payloads;
+    payloads.reserve(256);                // views point into it
+    std::vector<AdView> views(256);
+    for (uint32_t i = 0; i < 256; i++) {
+        payloads.push_back(makePayload(i % SHAPES, rng));
+        adParse(payloads[i].data, payloads[i].len, views[i]);
+    }
+    hits = 0;
+    t0 = nowNs();
+    for (uint32_t i = 0; i < iters; i++) hits += filterIndexMatchContent(idx, views[i & 255]) >= 0;
+    report("filterIndexMatchContent", iters, nowNs() - t0);
+    printf("        %.1f%% content hits\n", iters ? 100.0 * hits / iters : 0.0);
+}
+
+// The consumer path without the lock and rotation tracking: parse, content
+// rules, fold into the table, capture the first payloads
+static void ingestAdvert(DeviceTable& t, const FilterIndex* idx, uint64_t mac, int rssi, uint32_t now,
+                         const uint8_t* payload, uint8_t len) {
+    AdView ad;
+    adParse(payload, len, ad);
+    const bool ruleMatch = filterIndexMatchContent(idx, ad) >= 0;
+    DeviceRecord* rec = observeBleAdvert(t, mac, rssi, 1, now, ad, ruleMatch);
+    if (rec && !(rec->flags & DEV_HAS_PAYLOAD) && len) t.setPayload(rec, payload, len);
+}
+
+static void benchAggregation(uint32_t iters, uint32_t devices, DeviceTable& t, const FilterIndex* idx, Rng& rng) {
+    std::vector<uint64_t> macs(devices);
+    for (uint32_t i = 0; i < devices; i++) macs[i] = makeMac(idx, rng, rng.next() % 100 < HostConfig::HIT_PCT);
+    std::vector<Payload> payloads;
+    for (uint32_t i = 0; i < 256; i++) payloads.push_back(makePayload(i % SHAPES, rng));
+
+    t.clear();
+    uint64_t t0 = nowNs();
+    for (uint32_t i = 0; i < iters; i++) {
+        const uint32_t r = rng.next();
+        const uint64_t mac = macs[r % devices];
+        const Payload& p = payloads[(r >> 12) & 255];
+        const int rssi = -40 - (int)((mac * 0x9E3779B97F4A7C15ULL) >> 58) % 50 + (int)(r >> 30) - 1;
+        ingestAdvert(t, idx, mac, rssi, i / 10, p.data, p.len);
+    }
+    report("ble ingest (parse+rules+table)", iters, nowNs() - t0);
+
+    // One AP per WIFI_SHARE devices, swept repeatedly like a baseline run
+    const uint32_t aps = devices / HostConfig::WIFI_SHARE + 1;
+    const uint32_t sweeps = iters / aps + 1;
+    char ssid[24];
+    t0 = nowNs();
+    for (uint32_t s = 0; s < sweeps; s++) {
+        for (uint32_t a = 0; a < aps; a++) {
+            const uint64_t mac = 0xA4C138000000ULL | (a * 2654435761u & 0xFFFFFF);
+            const int n = a % 7 ? snprintf(ssid, sizeof(ssid), "Net-%05u", (unsigned)a) : 0;
+            const WiFiMeta meta = {(uint8_t)(1 + a % 11), (uint8_t)(a % 8), 4, 4};
+            observeWiFiAp(t, mac, -45 - (int)(a % 40), s * 1000, ssid, n, meta);
+        }
+    }
+    report("wifi ingest", (uint64_t)sweeps * aps, nowNs() - t0);
+    printf("        %u devices in a %u-slot table, %u evicted, payload arena %u/%u bytes\n",
+           (unsigned)t.count, (unsigned)t.capacity, (unsigned)t.evictions, (unsigned)t.payloads.used,
+           (unsigned)t.payloads.size);
+}
+
+static void benchResults(const DeviceTable& t) {
+    std::vector<uint32_t> rows;
+    for (size_t k = 0; k < (size_t)ResultsSort::COUNT; k++) {
+        const uint64_t t0 = nowNs();
+        collectResultRows(t, (ResultsSort)k, rows);
+        char name[40];
+        snprintf(name, sizeof(name), "collectResultRows(%s)", RESULTS_SORT_KEYS[k]);
+        report(name, rows.size(), nowNs() - t0);
+    }
+    {
+        // One page of the landing table in a non-published order
+        const uint64_t t0 = nowNs();
+        collectResultRows(t, ResultsSort::VENDOR, rows, 50);
+        report("collectResultRows(vendor, top 50)", rows.size(), nowNs() - t0);
+        collectResultRows(t, ResultsSort::BEST_RSSI, rows);
+    }
+
+    String out;
+    uint64_t bytes = 0;
+    uint64_t t0 = nowNs();
+    appendCsvHeader(out, true);
+    for (uint32_t slot : rows) {
+        appendCsvRow(out, t, slot, true);
+        bytes += out.length();
+        out = "";
+    }
+    report("appendCsvRow", rows.size(), nowNs() - t0, bytes);
+
+    bytes = 0;
+    uint32_t n = 0;
+    t0 = nowNs();
+    for (uint32_t slot : rows) {
+        const uint8_t flags = t.hot[slot].flags;
+        if (flags & DEV_WIFI) {
+            bytes += generateWiFiDeviceReport(t, slot).length();
+        } else if (flags & DEV_HAS_PAYLOAD) {
+            bytes += generateDeviceReport(t, slot).length();
+        } else {
+            continue;
+        }
+        n++;
+    }
+    report("device reports (TXT)", n, nowNs() - t0, bytes);
+}
+
+// Random bytes and bit flips of valid payloads through every parser and
+// renderer; meant for the sanitizer build
+static void fuzzParsers(uint32_t iters, const FilterIndex* idx, Rng& rng) {
+    uint64_t malformed = 0, bytes = 0;
+    Payload p;
+    AdView ad;
+    const uint64_t t0 = nowNs();
+    for (uint32_t i = 0; i < iters; i++) {
+        if (i & 1) {
+            p = makePayload(rng.next() % SHAPES, rng);
+            for (uint8_t f = 1 + rng.next() % 4; f > 0 && p.len; f--) {
+                p.data[rng.next() % p.len] ^= (uint8_t)(1 << (rng.next() & 7));
+            }
+        } else {
+            p.len = (uint8_t)(rng.next() % (Config::MAX_PAYLOAD_SIZE + 1));
+            for (uint8_t b = 0; b < p.len; b++) p.data[b] = (uint8_t)rng.next();
+        }
+        malformed += !adParse(p.data, p.len, ad);
+        filterIndexMatchContent(idx, ad);
+        bytes += formatAdStructures(p.data, ad).length();
+
+        String entry;
+        for (uint8_t n = rng.next() % 24; n > 0; n--) entry += (char)(32 + rng.next() % 95);
+        ContentRule rule;
+        if (parseContentRule(entry, rule)) bytes += formatContentRule(rule).length();
+        bytes += isValidMAC(entry);
+    }
+    report("fuzz parsers", iters, nowNs() - t0, bytes);
+    printf("        %llu malformed payloads\n", (unsigned long long)malformed);
+}
+
+// ================================
+// CAPTURE REPLAY
+// ================================
+
+static bool replayCapture(const char* path, const FilterIndex* idx, const char* outDir) {
+    std::vector<uint8_t> raw;
+    if (!readFile(path, raw)) {
+        printf("[REPLAY] %s: cannot read\n", path);
+        return false;
+    }
+    CaptureHeader hdr;
+    if (raw.size() < sizeof(hdr)) {
+        printf("[REPLAY] %s: too short for a header\n", path);
+        return false;
+    }
+    memcpy(&hdr, raw.data(), sizeof(hdr));
+    if (hdr.magic != CAPTURE_MAGIC || hdr.headerLen < sizeof(hdr) || hdr.headerLen > raw.size()) {
+        printf("[REPLAY] %s: not an OCP1 capture\n", path);
+        return false;
+    }
+
+    DeviceTable t;
+    if (!t.init(tableCapacityFor(hdr.recordCount))) {
+        printf("[REPLAY] %s: OOM for %u records\n", path, (unsigned)hdr.recordCount);
+        return false;
+    }
+
+    uint32_t records = 0, wifi = 0, withPayload = 0, ruleMatches = 0;
+    size_t off = hdr.headerLen;
+    const uint64_t t0 = nowNs();
+    while (off < raw.size()) {
+        CaptureRecordView r;
+        const size_t n = decodeCaptureRecord(raw.data() + off, raw.size() - off, r);
+        if (!n) {
+            printf("[REPLAY] %s: truncated or damaged record at offset %u\n", path, (unsigned)off);
+            break;
+        }
+        off += n;
+        records++;
+
+        DeviceRecord* rec;
+        if (r.flags & DEV_WIFI) {
+            rec = observeWiFiAp(t, r.mac48, r.rssi, r.lastSeenMs, (const char*)r.name, r.nameLen, r.wifi);
+            wifi++;
+        } else {
+            AdView ad;
+            adParse(r.payload, r.payloadLen, ad);
+            const bool ruleMatch = filterIndexMatchContent(idx, ad) >= 0;
+            rec = observeBleAdvert(t, r.mac48, r.rssi, r.addrType, r.lastSeenMs, ad, ruleMatch);
+            if (rec && r.payloadLen && t.setPayload(rec, r.payload, r.payloadLen)) withPayload++;
+            ruleMatches += ruleMatch;
+        }
+        if (rec && !rec->nameRef && r.nameLen) t.setName(rec, (const char*)r.name, r.nameLen);
+    }
+    const uint64_t ingestNs = nowNs() - t0;
+
+    std::vector<uint32_t> rows;
+    uint64_t t1 = nowNs();
+    collectResultRows(t, ResultsSort::BEST_RSSI, rows);
+    const uint64_t sortNs = nowNs() - t1;
+
+    String csv, txt;
+    t1 = nowNs();
+    appendCsvHeader(csv, hdr.capturePayload != 0);
+    for (uint32_t slot : rows) appendCsvRow(csv, t, slot, hdr.capturePayload != 0);
+    const uint64_t csvNs = nowNs() - t1;
+
+    t1 = nowNs();
+    for (uint32_t slot : rows) {
+        if (t.hot[slot].flags & DEV_WIFI) txt += generateWiFiDeviceReport(t, slot);
+    }
+    for (uint32_t slot : rows) {
+        if (t.hot[slot].flags & DEV_HAS_PAYLOAD) txt += generateDeviceReport(t, slot);
+    }
+    const uint64_t txtNs = nowNs() - t1;
+
+    printf("[REPLAY] %s: %u records (header says %u), %u Wi-Fi, %u BLE payloads, %u content rule hits\n",
+           path, (unsigned)records, (unsigned)hdr.recordCount, (unsigned)wifi, (unsigned)withPayload,
+           (unsigned)ruleMatches);
+    report("replay ingest", records, ingestNs, raw.size());
+    report("replay sort", rows.size(), sortNs);
+    report("replay CSV", rows.size(), csvNs, csv.length());
+    report("replay TXT", rows.size(), txtNs, txt.length());
+
+    bool ok = records == hdr.recordCount;
+    if (outDir) {
+        std::string base = path;
+        const size_t slash = base.find_last_of('/');
+        if (slash != std::string::npos) base = base.substr(slash + 1);
+        const std::string stem = std::string(outDir) + "/" + base;
+        if (!writeFile(stem + ".csv", csv) || !writeFile(stem + ".txt", txt)) {
+            printf("[REPLAY] cannot write %s.csv / .txt\n", stem.c_str());
+            ok = false;
+        }
+    }
+    t.release();
+    return ok;
+}
+
+// ================================
+// MAIN
+// ================================
+
+static void usage(const char* argv0) {
+    fprintf(stderr, "usage: %s [--iters N] [--devices N] [--filters FILE] [--fuzz N] [--out DIR] "
+                    "[capture.bin ...]\n", argv0);
+}
+
+int main(int argc, char** argv) {
+    uint32_t iters = HostConfig::ITERS;
+    uint32_t devices = HostConfig::DEVICES;
+    uint32_t fuzz = 0;
+    const char* filterPath = nullptr;
+    const char* outDir = nullptr;
+    std::vector<const char*> captures;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--iters" && hasValue) {
+            iters = strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--devices" && hasValue) {
+            devices = strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--fuzz" && hasValue) {
+            fuzz = strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--filters" && hasValue) {
+            filterPath = argv[++i];
+        } else if (arg == "--out" && hasValue) {
+            outDir = argv[++i];
+        } else if (arg.size() > 1 && arg[0] == '-') {
+            usage(argv[0]);
+            return 2;
+        } else {
+            captures.push_back(argv[i]);
+        }
+    }
+    if (devices < 1) devices = 1;
+    if (devices > HostConfig::MAX_DEVICES) devices = HostConfig::MAX_DEVICES;
+
+    Rng rng(0x5EED1234);
+    std::vector<String> filters;
+    std::vector<uint64_t> watch;
+    if (filterPath) {
+        if (!loadFilterFile(filterPath, filters)) {
+            printf("[ERROR] cannot read %s\n", filterPath);
+            return 1;
+        }
+    } else {
+        makeFilters(rng, filters, watch);
+    }
+
+    // Counts content-rule hits as the firmware does
+    static RuleHitTable ruleHits;
+    uint64_t t0 = nowNs();
+    FilterIndex* idx = compileFilterIndex(filters, watch.data(), watch.size(), &ruleHits);
+    if (!idx) {
+        printf("[ERROR] OOM compiling filter index\n");
+        return 1;
+    }
+    report("compileFilterIndex", filters.size() + watch.size(), nowNs() - t0);
+
+    bool ok = true;
+    if (captures.empty()) {
+        DeviceTable t;
+        if (!t.init(tableCapacityFor(devices))) {
+            printf("[ERROR] OOM allocating a table for %u devices\n", (unsigned)devices);
+            delete idx;
+            return 1;
+        }
+        benchParsing(iters, rng);
+        benchMacText(iters, rng);
+        benchFilters(iters, idx, rng);
+        benchAggregation(iters, devices, t, idx, rng);
+        benchResults(t);
+        if (fuzz) fuzzParsers(fuzz, idx, rng);
+        t.release();
+    } else {
+        for (const char* path : captures) ok &= replayCapture(path, idx, outDir);
+        if (fuzz) fuzzParsers(fuzz, idx, rng);
+    }
+
+    delete idx;
+    return ok ? 0 : 1;
+}
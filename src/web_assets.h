@@ -0,0 +1,370 @@
+// Gzipped web UI assets, sorted by file name.
+// Generated by tools/gen_web_assets.py from web/, do not edit by hand.
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct WebAsset {
+    const char* path;
+    const char* contentType;
+    const uint8_t* gz;
+    size_t gzLen;
+    const char* etag;
+    const char* cacheControl;
+};
+
+static const char* const WEB_STYLE_CSS_URL = "/style.css?v=9da02d6e";
+
+// index.html: 14959 bytes, 4312 gzipped
+static const uint8_t WEB_INDEX_HTML_GZ[] = {
+    0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xED, 0x3B, 0xDB, 0x72, 0xDB, 0x48,
+    0x76, 0xEF, 0xFE, 0x8A, 0x63, 0x8C, 0x63, 0x42, 0x35, 0x24, 0x48, 0x49, 0xB6, 0xD7, 0xA1, 0x48,
+    0xBA, 0x74, 0x2D, 0x3B, 0xE3, 0x8B, 0xCA, 0xB4, 0xC7, 0x35, 0xB5, 0x99, 0xA2, 0x9B, 0x40, 0x93,
+    0xEC, 0x11, 0x6E, 0x8B, 0x6E, 0x88, 0x62, 0x1C, 0x7D, 0x43, 0xDE, 0xF7, 0x69, 0x3F, 0x23, 0xDF,
+    0x93, 0x1F, 0xC8, 0x2F, 0xE4, 0x9C, 0xEE, 0x06, 0x08, 0x90, 0x94, 0x44, 0xC9, 0x33, 0xC9, 0x56,
+    0x92, 0x99, 0x1A, 0x11, 0x68, 0x74, 0x9F, 0x3E, 0xF7, 0x5B, 0xF7, 0xF4, 0x1E, 0x9F, 0x7C, 0x38,
+    0xFE, 0xF4, 0xCB, 0xF9, 0x29, 0xCC, 0x54, 0x14, 0x0E, 0x1E, 0xF5, 0x8A, 0x1F, 0xCE, 0x82, 0xC1,
+    0x23, 0x80, 0x5E, 0xC4, 0x15, 0x03, 0x7F, 0xC6, 0x32, 0xC9, 0x55, 0xDF, 0xC9, 0xD5, 0xA4, 0xF5,
+    0xD2, 0xD1, 0x1F, 0x94, 0x50, 0x21, 0x1F, 0x7C, 0xF8, 0xFC, 0xA6, 0x35, 0x4C, 0x17, 0x70, 0x1A,
+    0xCF, 0x58, 0xEC, 0xF3, 0xA0, 0xD7, 0x36, 0xE3, 0xE5, 0xD2, 0x98, 0x45, 0xBC, 0xEF, 0x5C, 0x0A,
+    0x3E, 0x4F, 0x93, 0x4C, 0x39, 0xE0, 0x27, 0xB1, 0xE2, 0x31, 0x82, 0x9A, 0x8B, 0x40, 0xCD, 0xFA,
+    0x01, 0xBF, 0x14, 0x3E, 0x6F, 0xE9, 0x97, 0x26, 0x88, 0x58, 0x28, 0xC1, 0xC2, 0x96, 0xF4, 0x59,
+    0xC8, 0xFB, 0xBB, 0x66, 0xA3, 0x50, 0xC4, 0x17, 0x90, 0xF1, 0xB0, 0xEF, 0x48, 0xB5, 0x08, 0xB9,
+    0x9C, 0x71, 0x8E, 0x70, 0x66, 0x19, 0x9F, 0xF4, 0x9D, 0xB6, 0x1E, 0xF2, 0x7C, 0x29, 0x5F, 0x5D,
+    0xF6, 0xFF, 0x31, 0x60, 0x9D, 0xBD, 0xE0, 0x05, 0x37, 0xCB, 0xA4, 0x9F, 0x89, 0x54, 0xD1, 0x23,
+    0xC0, 0x24, 0x8F, 0x7D, 0x25, 0x92, 0x18, 0xF2, 0x34, 0x60, 0x8A, 0x7F, 0x94, 0x52, 0xFC, 0xCC,
+    0xC2, 0x9C, 0xBB, 0x97, 0x2C, 0xDC, 0x81, 0x6F, 0x7A, 0x0E, 0x40, 0x90, 0xF8, 0x79, 0x84, 0xB8,
+    0x79, 0x53, 0xAE, 0x4E, 0x43, 0x4E, 0x8F, 0x47, 0x8B, 0x37, 0x81, 0xDB, 0xC8, 0x8A, 0xF9, 0x8D,
+    0x1D, 0x4F, 0xF1, 0x2B, 0x75, 0x6C, 0x68, 0x80, 0x3E, 0xE0, 0x7A, 0xF8, 0x11, 0x1A, 0x10, 0x1C,
+    0x45, 0x8D, 0x03, 0x0D, 0xE6, 0x5A, 0xFF, 0xAD, 0xEF, 0xAA, 0x92, 0xE9, 0x34, 0xE4, 0xE7, 0x6C,
+    0x11, 0x26, 0x2C, 0xF8, 0xC2, 0xB2, 0x58, 0xC4, 0x53, 0x77, 0xB9, 0x2F, 0xB2, 0x44, 0x2A, 0xE4,
+    0x31, 0xF7, 0x2F, 0xC6, 0xC9, 0x15, 0x42, 0xBD, 0x11, 0x11, 0x9F, 0xA5, 0x2A, 0xCF, 0x0A, 0x48,
+    0x8D, 0x9D, 0x83, 0x1A, 0x84, 0xB9, 0x81, 0x7C, 0x1B, 0x80, 0xB4, 0x86, 0xC3, 0x12, 0x80, 0x5D,
+    0xEA, 0x19, 0x76, 0x06, 0x42, 0xA6, 0x21, 0x5B, 0x20, 0xA0, 0x02, 0x29, 0x4F, 0x3F, 0xF0, 0x00,
+    0x5E, 0x41, 0x63, 0x1C, 0x26, 0xFE, 0x45, 0x03, 0xBA, 0xD0, 0x88, 0x93, 0x98, 0xAF, 0x93, 0xDD,
+    0x6E, 0xC3, 0xA7, 0x19, 0x87, 0x94, 0x4D, 0x39, 0x08, 0x25, 0x79, 0x38, 0x01, 0x21, 0x41, 0x2A,
+    0xA6, 0x84, 0x0F, 0x2C, 0x0E, 0xC0, 0x67, 0x08, 0x2D, 0x38, 0xD0, 0x43, 0x1C, 0x71, 0x8F, 0xB8,
+    0x84, 0x49, 0x96, 0x44, 0xD0, 0xCE, 0xC5, 0x48, 0x0F, 0x36, 0x0B, 0x40, 0xED, 0x8C, 0xCB, 0x3C,
+    0x54, 0x72, 0x24, 0xB9, 0x61, 0x25, 0xAD, 0x57, 0x08, 0xBD, 0xCD, 0x2F, 0x91, 0x28, 0x02, 0x9B,
+    0x71, 0x16, 0xD5, 0xD9, 0xFD, 0xC4, 0x15, 0x01, 0x72, 0x17, 0x75, 0x06, 0x99, 0x15, 0xDF, 0xC8,
+    0x0C, 0x9C, 0x74, 0xB0, 0x51, 0x5C, 0x72, 0x96, 0xCC, 0xDF, 0xF1, 0x28, 0xC9, 0x16, 0x2E, 0x6A,
+    0x0B, 0x5B, 0x0A, 0xEA, 0x89, 0xDB, 0x88, 0x78, 0x34, 0x44, 0x0C, 0x73, 0xB9, 0xAA, 0x0A, 0x76,
+    0x0A, 0xC0, 0xD7, 0xB3, 0x8C, 0x73, 0x78, 0xCD, 0x59, 0xDA, 0x85, 0x27, 0xDF, 0x34, 0x04, 0x6F,
+    0x82, 0x43, 0x23, 0x34, 0xA9, 0xB4, 0xBD, 0xDB, 0xD9, 0x7B, 0x86, 0x2B, 0x93, 0x33, 0x71, 0xC5,
+    0x03, 0x77, 0x77, 0xE7, 0xFA, 0xA7, 0x23, 0xF8, 0x57, 0xF8, 0x0A, 0x3F, 0x2E, 0xD7, 0x5B, 0xE9,
+    0x82, 0x41, 0x81, 0x80, 0x68, 0x18, 0x56, 0x74, 0xA3, 0x48, 0x0F, 0x5F, 0xB7, 0xED, 0x70, 0xC4,
+    0xAE, 0x46, 0x2B, 0x9F, 0x60, 0xBC, 0x50, 0xC8, 0xD2, 0x15, 0xB0, 0xEF, 0xD8, 0x15, 0x9C, 0x68,
+    0x6B, 0x93, 0x25, 0x4C, 0x5A, 0x6C, 0x2C, 0x50, 0x5E, 0x7F, 0xBD, 0x59, 0x7F, 0x35, 0x43, 0x92,
+    0x80, 0xBB, 0x51, 0x8D, 0x17, 0x59, 0x1E, 0x6F, 0xE6, 0x05, 0x44, 0x5E, 0x84, 0xD3, 0xA1, 0xDF,
+    0xEF, 0xA3, 0xBA, 0x30, 0x54, 0x01, 0x81, 0x8A, 0x42, 0xBA, 0x73, 0x64, 0x5F, 0x00, 0xD7, 0x6A,
+    0x0D, 0x24, 0x35, 0x1A, 0xAA, 0x24, 0x4D, 0x79, 0xB0, 0xAE, 0x49, 0x21, 0x57, 0x10, 0x8A, 0x4B,
+    0xFE, 0x31, 0x8F, 0x11, 0x68, 0xA7, 0xA9, 0x5F, 0x86, 0xFC, 0x2F, 0xE6, 0x65, 0xCE, 0xE4, 0x47,
+    0x03, 0x05, 0xDF, 0x27, 0x2C, 0x94, 0xFC, 0x60, 0x1D, 0xED, 0x62, 0x43, 0x77, 0xBC, 0x44, 0x5D,
+    0x4C, 0xC0, 0x1D, 0x7B, 0x88, 0x01, 0x3C, 0x46, 0x04, 0xED, 0x06, 0xA4, 0x30, 0xCB, 0xBD, 0xF4,
+    0xE7, 0x83, 0xEA, 0x7E, 0x85, 0xAA, 0x14, 0xCB, 0x25, 0x0E, 0xF7, 0x8A, 0x09, 0x3B, 0x56, 0xD7,
+    0x0A, 0x73, 0x5A, 0xAE, 0xD3, 0x13, 0x0F, 0x96, 0x3C, 0xA3, 0x2F, 0x05, 0x4E, 0x6B, 0x6C, 0x33,
+    0x48, 0xBD, 0x5A, 0xCA, 0xEC, 0xC9, 0x37, 0x3D, 0xA4, 0x69, 0x44, 0xEE, 0x0D, 0x7D, 0xB6, 0xE4,
+    0xDA, 0x5B, 0x86, 0x26, 0x8F, 0x1F, 0x1B, 0xD7, 0x24, 0xCE, 0xB1, 0xE7, 0x27, 0x79, 0xAC, 0xAE,
+    0xC1, 0x8A, 0xB3, 0x2A, 0x7A, 0xC4, 0x96, 0x06, 0x89, 0x27, 0x12, 0xC1, 0x7C, 0x6D, 0xEA, 0xF9,
+    0xE5, 0xD0, 0x35, 0xE8, 0x47, 0x1E, 0x7C, 0x25, 0xB0, 0x8D, 0x1D, 0xFA, 0xFB, 0x3E, 0x51, 0x64,
+    0x9E, 0x99, 0x2A, 0xC5, 0x62, 0xE8, 0xAE, 0xF0, 0xFC, 0xE9, 0x53, 0x78, 0x5C, 0x62, 0xA7, 0xB9,
+    0x87, 0x2A, 0xF8, 0xD1, 0x98, 0xAB, 0x8B, 0x96, 0x45, 0xAF, 0xC7, 0xC6, 0x5F, 0xE9, 0xF7, 0xEB,
+    0xD2, 0xD5, 0x54, 0xC4, 0x56, 0x02, 0x58, 0x93, 0x3D, 0x93, 0x8B, 0xD8, 0x5F, 0xCA, 0xB2, 0x06,
+    0xBC, 0x94, 0xA4, 0xCA, 0x16, 0xE5, 0x73, 0xE1, 0x05, 0x71, 0x3B, 0x04, 0xCC, 0xE6, 0x4C, 0x28,
+    0x98, 0x70, 0xE5, 0xCF, 0xDC, 0xC6, 0xAA, 0x17, 0x59, 0xFA, 0x3D, 0xA3, 0xC7, 0xE6, 0x2B, 0x8A,
+    0x43, 0xC4, 0x31, 0xCF, 0x5E, 0x7F, 0x7A, 0xF7, 0xB6, 0x84, 0x80, 0xDF, 0xB4, 0x90, 0xDC, 0x72,
+    0xC9, 0x35, 0xFA, 0x2F, 0x82, 0xCA, 0x11, 0x8D, 0xEB, 0x2D, 0xB0, 0x5E, 0xF2, 0xE0, 0xDE, 0x68,
+    0x5B, 0x77, 0x2F, 0xAB, 0xF8, 0x9A, 0xD9, 0x61, 0x32, 0xAD, 0xA1, 0xF8, 0x9B, 0x4C, 0x62, 0xB7,
+    0x4E, 0xD5, 0x72, 0x71, 0x8D, 0xAC, 0xC7, 0xB8, 0xD4, 0x43, 0x9F, 0x19, 0x2C, 0x48, 0xA3, 0xCE,
+    0x42, 0x26, 0x67, 0x1A, 0x5A, 0x1E, 0xB3, 0x4B, 0x26, 0x42, 0x36, 0x0E, 0xD1, 0x52, 0xBB, 0x25,
+    0x20, 0x30, 0x0B, 0x24, 0xC7, 0x10, 0x88, 0x3B, 0x7B, 0x21, 0x8F, 0xA7, 0x6A, 0x46, 0x4B, 0xDF,
+    0x27, 0x20, 0xD9, 0x25, 0x86, 0x84, 0xE2, 0x1B, 0x2C, 0xB8, 0xAA, 0x2F, 0xAD, 0xAD, 0x8C, 0x58,
+    0xEA, 0xFA, 0xD0, 0x1F, 0x54, 0xBE, 0xA3, 0x86, 0xF7, 0x30, 0xB9, 0x40, 0x1C, 0x64, 0xDF, 0xA1,
+    0x30, 0x5F, 0x86, 0x75, 0x8B, 0xFC, 0x88, 0x20, 0x8C, 0x45, 0xFC, 0x4A, 0x04, 0xFD, 0x27, 0xDF,
+    0x7C, 0x4F, 0x04, 0xD7, 0xCE, 0xE0, 0x07, 0xFB, 0xD4, 0x6B, 0xB3, 0x41, 0xCD, 0xC5, 0x59, 0x93,
+    0xF1, 0xB5, 0xF3, 0xB9, 0x26, 0x2D, 0xF7, 0x91, 0x52, 0x3F, 0xC9, 0x02, 0x59, 0xDA, 0x45, 0x13,
+    0xC6, 0x09, 0xEA, 0x36, 0x7D, 0xA2, 0x87, 0x6B, 0xF8, 0x91, 0x1E, 0xF3, 0x54, 0x89, 0x88, 0x8F,
+    0xE4, 0xB5, 0x5C, 0x85, 0xE7, 0xFA, 0x9E, 0x09, 0x53, 0xDA, 0x97, 0xA5, 0x68, 0x11, 0x98, 0x9F,
+    0x68, 0x57, 0x06, 0xAE, 0x7D, 0xDB, 0x69, 0x18, 0xBB, 0xD9, 0xF1, 0x7E, 0x4B, 0x44, 0xEC, 0x36,
+    0x7A, 0xE3, 0x6C, 0xD0, 0x78, 0xB0, 0xBA, 0x90, 0x47, 0xE5, 0x0F, 0xD0, 0x95, 0x22, 0x74, 0xAE,
+    0xEB, 0x8A, 0xBC, 0x4B, 0x53, 0x26, 0x22, 0x54, 0x3C, 0x93, 0x9F, 0x18, 0xAA, 0xCA, 0x25, 0xA5,
+    0x39, 0xB8, 0x40, 0x7A, 0x76, 0xD4, 0x12, 0xF5, 0xCF, 0xAB, 0x46, 0x83, 0xA1, 0xE3, 0xCC, 0xCC,
+    0x58, 0x73, 0x63, 0x52, 0xC7, 0x15, 0xBB, 0xBE, 0xB6, 0x68, 0x1E, 0x1E, 0x93, 0x97, 0xDA, 0xB0,
+    0x62, 0x4E, 0x4C, 0x0A, 0x85, 0x54, 0x23, 0xED, 0xC7, 0x56, 0x56, 0x61, 0xEC, 0xBA, 0x75, 0x0D,
+    0xEE, 0xB7, 0x5C, 0x51, 0xC6, 0xFB, 0xBF, 0xE4, 0x3C, 0x5B, 0x0C, 0x79, 0x88, 0x46, 0x9F, 0x64,
+    0x87, 0x61, 0xE8, 0x36, 0x44, 0x9C, 0xE6, 0xEA, 0xCF, 0x3A, 0x25, 0x45, 0xBF, 0x33, 0x8A, 0x44,
+    0xFC, 0x2B, 0xC2, 0x9D, 0x24, 0xD9, 0x29, 0x23, 0x11, 0x85, 0xA8, 0x9E, 0xC0, 0x43, 0x42, 0xDF,
+    0x90, 0x81, 0x7A, 0x34, 0xD2, 0x13, 0x91, 0x1E, 0x9C, 0x5C, 0xE1, 0x40, 0x19, 0x12, 0xCD, 0xAC,
+    0xD5, 0x2F, 0x26, 0x7B, 0xC0, 0x6F, 0xFA, 0x61, 0x3B, 0x65, 0x28, 0xD5, 0x00, 0xC5, 0x16, 0x23,
+    0xCE, 0xA7, 0x3A, 0xC3, 0x71, 0xEB, 0x71, 0xEB, 0xF1, 0x5C, 0xC4, 0x41, 0x32, 0xF7, 0xF4, 0xC7,
+    0x61, 0x92, 0x67, 0x3E, 0xC1, 0x42, 0x1B, 0x54, 0x6F, 0x90, 0x31, 0x19, 0x8A, 0xCF, 0x2D, 0xB5,
+    0xA8, 0x09, 0xCF, 0x3B, 0x9D, 0x0E, 0xBA, 0x5E, 0x1B, 0x9C, 0x4A, 0x17, 0x6C, 0xF4, 0x42, 0x2B,
+    0x51, 0xCC, 0xE7, 0x50, 0x81, 0x85, 0x8A, 0x64, 0x12, 0xAB, 0xA5, 0xB4, 0x51, 0x67, 0x58, 0x10,
+    0xE8, 0x39, 0x6F, 0x91, 0xD7, 0x1C, 0x5D, 0x89, 0xDB, 0x90, 0x26, 0xEE, 0x37, 0x81, 0x13, 0xCB,
+    0x2A, 0x24, 0xFF, 0xD3, 0xF0, 0xC3, 0x7B, 0x4C, 0x55, 0xB0, 0x5A, 0x70, 0x31, 0x8F, 0xA4, 0xEC,
+    0x69, 0xE7, 0x76, 0x48, 0xC4, 0xBD, 0x1A, 0x1C, 0x62, 0xEA, 0xBD, 0xA1, 0x94, 0x49, 0x46, 0x05,
+    0x52, 0x19, 0xFA, 0x6F, 0x86, 0x56, 0xE1, 0xBE, 0xE5, 0x6B, 0x12, 0xEB, 0xDC, 0xAB, 0x0F, 0xC8,
+    0x77, 0x84, 0xF3, 0xAD, 0x6A, 0x93, 0x07, 0x77, 0x85, 0xB8, 0x15, 0xC1, 0x21, 0xC3, 0x69, 0x9B,
+    0x5E, 0xBB, 0x28, 0x45, 0x7A, 0x6D, 0x53, 0x56, 0xF5, 0xC6, 0x49, 0xB0, 0xD0, 0x45, 0x4A, 0x20,
+    0x2E, 0x0B, 0xFF, 0x47, 0x85, 0x11, 0x43, 0x74, 0x33, 0xC7, 0xB8, 0xC8, 0xDE, 0x6C, 0xD7, 0x54,
+    0x57, 0xE7, 0xBF, 0xC0, 0xE9, 0xFB, 0xD7, 0x87, 0xEF, 0x8F, 0x4F, 0x4F, 0x10, 0xC0, 0xAE, 0xFD,
+    0x9A, 0x16, 0xEB, 0xA2, 0x1C, 0x83, 0xB4, 0x33, 0x38, 0x0C, 0x2E, 0x75, 0x01, 0x06, 0x05, 0x2B,
+    0x40, 0xDA, 0x6C, 0x01, 0x49, 0x43, 0x8F, 0xFD, 0x71, 0x38, 0x7C, 0x03, 0xC6, 0x26, 0x69, 0x8C,
+    0xF2, 0x68, 0x9B, 0x36, 0x82, 0x75, 0xB6, 0x5E, 0xAF, 0x9D, 0x5A, 0xE0, 0x15, 0xB4, 0x0C, 0x78,
+    0x40, 0x07, 0xEC, 0x94, 0xB9, 0xAF, 0x03, 0xBA, 0x4E, 0xC0, 0x11, 0x96, 0x4D, 0x45, 0xDC, 0xC2,
+    0xFC, 0xAD, 0xFB, 0x32, 0xBD, 0x72, 0x06, 0x6F, 0x11, 0x1C, 0x41, 0x37, 0x6A, 0x0F, 0x46, 0x4B,
+    0x3C, 0x0F, 0x21, 0x23, 0xC4, 0xC1, 0xA3, 0x35, 0xE0, 0x36, 0x1E, 0x3B, 0x45, 0x50, 0xE8, 0xCD,
+    0xF6, 0x07, 0x27, 0x5C, 0xD9, 0x5C, 0xDF, 0xFA, 0x17, 0x24, 0x7A, 0xBF, 0x9C, 0x80, 0xB6, 0x1A,
+    0x21, 0x78, 0x35, 0x4B, 0x10, 0xA1, 0xF3, 0x0F, 0xC3, 0x4F, 0x0E, 0x30, 0x3D, 0x9B, 0x6A, 0x41,
+    0x0C, 0x47, 0xCE, 0x32, 0xBE, 0xF4, 0xC8, 0x5F, 0x30, 0x0C, 0x75, 0x1A, 0xF9, 0xD2, 0xC9, 0x39,
+    0xB6, 0x24, 0xB5, 0x03, 0x0E, 0x64, 0xC9, 0x1C, 0x51, 0xF9, 0x93, 0x03, 0x58, 0xF3, 0xF8, 0x7C,
+    0x96, 0x84, 0x01, 0xCF, 0xFA, 0xCE, 0xE1, 0x61, 0xF7, 0xE8, 0xA8, 0x7B, 0x7C, 0xDC, 0x84, 0xE2,
+    0xA9, 0xBB, 0xBB, 0xDB, 0xDD, 0xDB, 0xEB, 0xEE, 0xEF, 0x37, 0x21, 0x9A, 0x4C, 0xBB, 0x9D, 0xCE,
+    0xB3, 0xE3, 0x6E, 0x67, 0x6F, 0xF7, 0x79, 0x13, 0xF2, 0x5C, 0x04, 0xDD, 0xB3, 0x93, 0x17, 0x67,
+    0x90, 0x64, 0x1A, 0x7A, 0xF7, 0x93, 0x08, 0xD1, 0xFC, 0xB0, 0x3C, 0x82, 0x94, 0x67, 0x40, 0xE2,
+    0x70, 0x06, 0x58, 0x1A, 0x5B, 0x84, 0x06, 0x14, 0x22, 0xE8, 0xBF, 0x25, 0xAE, 0xDA, 0x33, 0x15,
+    0x6C, 0x19, 0xAB, 0xD8, 0x01, 0xB5, 0x48, 0x11, 0x4B, 0x99, 0x8F, 0x23, 0x81, 0xE5, 0xAE, 0xF6,
+    0xCB, 0x7D, 0x67, 0x88, 0x24, 0x16, 0x7C, 0xA9, 0x92, 0x3A, 0xCE, 0x95, 0x22, 0xCF, 0x51, 0x59,
+    0x4F, 0x9C, 0x2A, 0x59, 0x63, 0x89, 0x1D, 0xF9, 0x21, 0x67, 0x99, 0xF9, 0x56, 0x67, 0x62, 0x6D,
+    0xB7, 0x5A, 0x04, 0xA4, 0x7F, 0x92, 0xD8, 0x0F, 0x85, 0x7F, 0xD1, 0x77, 0x6C, 0x49, 0x85, 0xBA,
+    0x3A, 0x11, 0x59, 0xE4, 0x36, 0x8E, 0x09, 0x1E, 0xB0, 0x30, 0xC4, 0xF8, 0x5A, 0x88, 0xCD, 0xEE,
+    0xF5, 0x0A, 0x5D, 0x88, 0x33, 0x30, 0x13, 0x4A, 0x49, 0x1A, 0x3C, 0x4B, 0x69, 0xB6, 0x09, 0x91,
+    0xF2, 0x6D, 0x55, 0xA5, 0x51, 0xFB, 0x29, 0xB3, 0x17, 0x19, 0x3A, 0xAB, 0x7D, 0x53, 0xD4, 0x78,
+    0x70, 0x96, 0xE3, 0x66, 0xEF, 0x0E, 0x8F, 0xF1, 0xCB, 0x8B, 0x62, 0xEC, 0x03, 0xF2, 0x19, 0x4D,
+    0x0E, 0x35, 0xAE, 0xE0, 0xB6, 0x07, 0x54, 0xEE, 0xF4, 0x64, 0xCA, 0x62, 0xA3, 0xBA, 0x65, 0xB4,
+    0x72, 0x06, 0x2D, 0x34, 0x48, 0x1C, 0x1F, 0x14, 0x88, 0x7A, 0x35, 0x49, 0x14, 0x01, 0x26, 0xCB,
+    0x43, 0x74, 0x90, 0x11, 0xB9, 0x6B, 0xC8, 0xD0, 0x5A, 0x92, 0x48, 0xFC, 0x0B, 0x5A, 0x17, 0xBA,
+    0x1E, 0x34, 0x76, 0x49, 0x35, 0x54, 0xCF, 0x47, 0x57, 0x35, 0x20, 0x55, 0x78, 0x1A, 0xAA, 0x03,
+    0x2C, 0x63, 0x11, 0xE8, 0x02, 0x77, 0x7B, 0x3A, 0x55, 0x07, 0x7F, 0xD6, 0x63, 0x33, 0x7E, 0x05,
+    0x29, 0x26, 0x34, 0xE2, 0x4A, 0x8F, 0xB5, 0x8B, 0xB1, 0x88, 0xC9, 0x0B, 0x1A, 0xF9, 0xF5, 0xD7,
+    0x5E, 0x5B, 0x03, 0x69, 0x2E, 0x25, 0xA9, 0xDF, 0xB5, 0x42, 0xD1, 0xEC, 0xDD, 0x17, 0xA4, 0x52,
+    0xBB, 0x7B, 0x2F, 0x5B, 0x63, 0xA1, 0x68, 0x49, 0xB1, 0xC0, 0x4E, 0xD4, 0xCA, 0x46, 0x13, 0x97,
+    0xDB, 0xD8, 0x19, 0x1E, 0xBC, 0xC6, 0x88, 0xAF, 0x83, 0x29, 0xE1, 0xCA, 0x8A, 0xCC, 0xCA, 0x10,
+    0xAD, 0x73, 0x05, 0xE4, 0x45, 0xED, 0x95, 0x12, 0xAA, 0xA5, 0x0F, 0xB8, 0x87, 0xC9, 0x7E, 0x29,
+    0x02, 0x71, 0xCD, 0x54, 0x57, 0xC4, 0xB9, 0xC1, 0x67, 0x74, 0x9C, 0xC1, 0x51, 0x1E, 0x5E, 0x00,
+    0x0A, 0xBA, 0x4D, 0x22, 0x25, 0x10, 0x38, 0x2D, 0xC9, 0x90, 0xD1, 0xA4, 0x48, 0x94, 0x9C, 0x76,
+    0x2B, 0x52, 0xB4, 0xE9, 0x43, 0x45, 0x84, 0xC9, 0xA4, 0xF6, 0x19, 0x85, 0x5E, 0xF9, 0x48, 0x2A,
+    0x21, 0x50, 0x3F, 0x4A, 0xE6, 0x1A, 0xD7, 0xDD, 0x52, 0x94, 0xE4, 0x82, 0xD6, 0x68, 0x09, 0x68,
+    0x8F, 0x24, 0x54, 0xDC, 0x71, 0xC6, 0xAB, 0x3E, 0xF0, 0x0E, 0x5F, 0xB3, 0xCC, 0x3D, 0xF2, 0x94,
+    0x9C, 0xA8, 0x83, 0xBB, 0xF9, 0xC6, 0x88, 0x22, 0xDC, 0x43, 0x50, 0x6E, 0xA8, 0xB5, 0xBB, 0x45,
+    0x01, 0xC7, 0x59, 0xB3, 0x74, 0x33, 0x75, 0x26, 0x70, 0xE7, 0xB8, 0xF0, 0x48, 0x48, 0xB6, 0xC0,
+    0x7C, 0x75, 0x69, 0xED, 0xBB, 0xD5, 0x75, 0x98, 0x9A, 0xF3, 0x70, 0x50, 0x5B, 0x5E, 0x74, 0x67,
+    0x0A, 0x00, 0x11, 0xCF, 0xA6, 0xBC, 0xB2, 0x1A, 0x6C, 0xD7, 0x66, 0x00, 0xEF, 0xE8, 0x8B, 0x09,
+    0x04, 0xFC, 0x0A, 0xB1, 0x26, 0x27, 0x6D, 0xD9, 0xD3, 0x6B, 0x1B, 0xC8, 0x9B, 0x31, 0x44, 0xFD,
+    0xE0, 0x05, 0xF8, 0x92, 0x66, 0xE2, 0x83, 0xCF, 0x53, 0xD5, 0x77, 0x3C, 0x75, 0xA5, 0x9A, 0x9E,
+    0x2F, 0x2F, 0x9B, 0x94, 0xA6, 0x3B, 0x0F, 0x77, 0x6C, 0x9F, 0x35, 0x17, 0xA1, 0xD4, 0xA4, 0x2A,
+    0xE5, 0xAC, 0xB6, 0xDC, 0xEA, 0x71, 0x89, 0x8C, 0xD9, 0xF8, 0x24, 0x99, 0xEB, 0xC8, 0x4D, 0x3A,
+    0xBC, 0xBD, 0x5B, 0xAC, 0x64, 0x9D, 0x37, 0x39, 0x46, 0x1A, 0x29, 0x45, 0xCB, 0xD2, 0x14, 0xB5,
+    0x86, 0xD1, 0xEA, 0xF6, 0x55, 0x6B, 0x3E, 0x9F, 0xB7, 0xB4, 0x88, 0xF3, 0x0C, 0xCB, 0x22, 0xB2,
+    0xBA, 0x60, 0xDD, 0x75, 0xD6, 0xA9, 0xBD, 0xC3, 0x91, 0x52, 0x67, 0xAB, 0xC4, 0xA9, 0xEA, 0x40,
+    0x2B, 0x16, 0x76, 0x2F, 0x17, 0xFA, 0x09, 0x23, 0x0E, 0xB8, 0x14, 0x87, 0xC8, 0x99, 0xA2, 0x2B,
+    0x21, 0x33, 0x2B, 0x9C, 0x64, 0x13, 0x7E, 0xA0, 0xEE, 0x1B, 0xE5, 0xCA, 0x72, 0x87, 0x3E, 0xD2,
+    0xF6, 0xC8, 0x4D, 0x86, 0x8E, 0x94, 0xB8, 0x6A, 0x78, 0xA5, 0xBC, 0x07, 0xF9, 0x84, 0xA2, 0x21,
+    0x0C, 0x65, 0xCB, 0x87, 0xBA, 0x17, 0x5B, 0xC7, 0xF2, 0x22, 0x8B, 0x19, 0xE9, 0x2E, 0xC4, 0x9A,
+    0x1D, 0xDC, 0xEA, 0x5A, 0xC6, 0x09, 0x72, 0x28, 0x32, 0x19, 0x09, 0x6D, 0x0A, 0x94, 0x53, 0x76,
+    0xD7, 0xF5, 0x7C, 0x83, 0x45, 0x65, 0x98, 0xBF, 0x24, 0xA5, 0x39, 0xE1, 0xB2, 0x52, 0x41, 0xE7,
+    0x62, 0x22, 0x2A, 0x06, 0xF5, 0x45, 0xB4, 0xCE, 0xC4, 0x77, 0x82, 0x44, 0x2F, 0xE4, 0x0C, 0xE0,
+    0xE8, 0xED, 0xE9, 0xF7, 0xC2, 0x49, 0xD4, 0xCC, 0xB1, 0x28, 0xC1, 0x53, 0x16, 0xA5, 0x07, 0x1B,
+    0x81, 0x56, 0xCC, 0x62, 0xD5, 0x48, 0xCD, 0xCC, 0x93, 0x3C, 0xD3, 0xAA, 0x0D, 0x2E, 0x0A, 0x34,
+    0x89, 0x03, 0xB9, 0xD3, 0xAD, 0x3B, 0x83, 0x38, 0x8F, 0xC6, 0x98, 0x9F, 0x02, 0x96, 0x42, 0x7D,
+    0xE7, 0x39, 0xFE, 0xB2, 0xAB, 0xBE, 0xF3, 0xA2, 0xD3, 0x29, 0x31, 0x79, 0xD1, 0x29, 0x10, 0x44,
+    0x08, 0xCB, 0x34, 0x51, 0x77, 0xF7, 0xBB, 0xBB, 0x7B, 0x1D, 0x92, 0xC8, 0xBD, 0xF1, 0x5A, 0x51,
+    0x69, 0x24, 0x4D, 0xA7, 0xB6, 0x18, 0x59, 0x13, 0xF2, 0x4E, 0x1B, 0x04, 0x2B, 0x75, 0xCD, 0x57,
+    0x60, 0x82, 0x73, 0x47, 0x76, 0xAE, 0x53, 0xED, 0x3E, 0xF4, 0x92, 0x54, 0x53, 0x6B, 0x71, 0x4F,
+    0x71, 0x13, 0x41, 0x09, 0xE4, 0xB9, 0x79, 0xC0, 0xEC, 0x7E, 0xDE, 0x4A, 0x93, 0x39, 0x1A, 0x8B,
+    0xBB, 0xDB, 0xF9, 0x87, 0x9D, 0x5E, 0xDB, 0xCC, 0xBF, 0x05, 0xC4, 0x98, 0x85, 0x5A, 0xE7, 0x11,
+    0x49, 0xFB, 0x04, 0xEE, 0xFE, 0xFE, 0x56, 0x4B, 0x23, 0x8A, 0x5C, 0x94, 0xB3, 0xD8, 0x64, 0x9C,
+    0xF6, 0xDC, 0x6E, 0x53, 0x32, 0x19, 0x44, 0x1B, 0x0C, 0xD1, 0xA8, 0x9B, 0x87, 0x7A, 0x00, 0x7E,
+    0x34, 0x5C, 0xC2, 0x6C, 0x25, 0xC5, 0x72, 0x8F, 0xDF, 0x84, 0x09, 0x06, 0x4B, 0xBD, 0xF0, 0xC1,
+    0xF2, 0x30, 0x6A, 0x47, 0x7B, 0x3D, 0xC0, 0xC4, 0xB4, 0x70, 0x68, 0xDC, 0x59, 0x25, 0xA7, 0xB4,
+    0x34, 0x43, 0xCE, 0xEF, 0x01, 0xBA, 0x94, 0x30, 0x58, 0x11, 0xDF, 0x04, 0xF4, 0x64, 0xCE, 0x31,
+    0xC9, 0x24, 0x37, 0xE9, 0xA3, 0x13, 0x8B, 0x91, 0x64, 0x37, 0xBA, 0xDD, 0x18, 0xF6, 0x3B, 0xD6,
+    0x1A, 0x76, 0x9F, 0x57, 0xCC, 0x01, 0x35, 0xBE, 0xC0, 0x26, 0x20, 0x90, 0xA3, 0x68, 0xCD, 0x26,
+    0x3A, 0xBF, 0x8B, 0x4D, 0x0C, 0x93, 0x4C, 0x77, 0x77, 0xA8, 0x30, 0xC5, 0xA4, 0xF8, 0x4E, 0x93,
+    0xC0, 0xE9, 0xA3, 0xF1, 0xE2, 0x36, 0x6B, 0xA0, 0x23, 0xAF, 0x8A, 0x4E, 0x1D, 0x71, 0xCC, 0xCC,
+    0xA8, 0x84, 0xDC, 0x46, 0x95, 0x39, 0xC3, 0x50, 0xF0, 0x0E, 0xFF, 0x6E, 0xBB, 0x42, 0xA2, 0xCF,
+    0xC2, 0x6C, 0x1B, 0xE9, 0x10, 0xD3, 0x19, 0xE5, 0x26, 0x72, 0x9B, 0x45, 0x0A, 0x6B, 0x69, 0xCC,
+    0x5F, 0x30, 0x38, 0x0C, 0x8B, 0x47, 0x90, 0x62, 0x1A, 0x33, 0x14, 0x97, 0x3E, 0x6D, 0x4A, 0x74,
+    0x24, 0xD3, 0xF5, 0xC3, 0x36, 0x86, 0x84, 0x1C, 0x55, 0x23, 0xC9, 0x31, 0x1F, 0x1B, 0xE8, 0xDE,
+    0x3A, 0x3D, 0x6E, 0xB1, 0x4C, 0xC3, 0xB7, 0xEB, 0xCE, 0x74, 0xAD, 0xB2, 0xE5, 0xC2, 0x4B, 0x8E,
+    0x55, 0x05, 0x56, 0xFB, 0x3F, 0xEB, 0x5F, 0x70, 0x31, 0x42, 0x6F, 0x83, 0xA6, 0x55, 0xC9, 0xC2,
+    0xF0, 0xEC, 0xEB, 0x1F, 0x60, 0xD8, 0xBA, 0x63, 0xF0, 0x09, 0xD3, 0x2D, 0x49, 0x35, 0x31, 0xB8,
+    0xA6, 0x54, 0x80, 0x18, 0xF3, 0x91, 0xF1, 0xA2, 0xE8, 0xA7, 0xEE, 0x6C, 0xD0, 0xB5, 0x6A, 0x66,
+    0x10, 0x0A, 0xAC, 0xA6, 0x5B, 0xAB, 0xBD, 0x8D, 0x42, 0x29, 0x29, 0x73, 0xDF, 0x1C, 0xC9, 0x31,
+    0x8C, 0x1B, 0x0B, 0x79, 0xA1, 0x0D, 0xE4, 0x0B, 0x67, 0x17, 0x36, 0xAD, 0xAF, 0x02, 0xA8, 0x1B,
+    0x7F, 0x3C, 0x2D, 0x53, 0x55, 0x52, 0xDF, 0x91, 0x2A, 0x70, 0x77, 0xEA, 0xE8, 0x58, 0x9B, 0x6D,
+    0xED, 0x76, 0x0A, 0xAB, 0xC5, 0xC7, 0xD2, 0x68, 0xCD, 0xF0, 0x5A, 0x1E, 0x87, 0xA9, 0x9B, 0xDE,
+    0xAD, 0xEF, 0xAC, 0x9E, 0x21, 0xAB, 0x99, 0x90, 0xA6, 0x6F, 0xBA, 0xF3, 0x50, 0xF2, 0x86, 0x2A,
+    0x4B, 0xE2, 0xE9, 0x06, 0x02, 0xAB, 0x20, 0x2C, 0x2F, 0xF5, 0x4E, 0xA6, 0x21, 0x53, 0x9E, 0x4B,
+    0x63, 0xD1, 0x83, 0x58, 0xD3, 0x29, 0xF4, 0x2A, 0x0C, 0x9B, 0xB2, 0x95, 0xAF, 0x6B, 0x35, 0x76,
+    0x1C, 0x2E, 0x4C, 0xA0, 0xB0, 0x02, 0xAD, 0x74, 0x8B, 0x06, 0xFD, 0xD2, 0x01, 0x18, 0xE6, 0x78,
+    0xA0, 0xB7, 0xE9, 0x97, 0x41, 0x0A, 0x0B, 0xFF, 0x26, 0xB4, 0x9E, 0x77, 0x74, 0x23, 0x51, 0xAB,
+    0x45, 0x82, 0xF0, 0x2A, 0x35, 0x54, 0x55, 0xE9, 0x2A, 0x6A, 0x21, 0xE2, 0x49, 0xD2, 0xA2, 0xC2,
+    0xA5, 0x46, 0xEC, 0x8A, 0x1E, 0xAD, 0x49, 0x78, 0xB5, 0xDC, 0x29, 0x0E, 0x09, 0x6C, 0x1F, 0xCB,
+    0xF0, 0xA4, 0x7E, 0x44, 0xAE, 0x33, 0xEE, 0x19, 0x69, 0x46, 0xDF, 0xD9, 0x7C, 0x0A, 0x8F, 0xD1,
+    0xA0, 0xBE, 0xA3, 0xD4, 0xB2, 0x18, 0xD8, 0xBE, 0x1E, 0x65, 0x52, 0x60, 0xD7, 0x48, 0x70, 0x0F,
+    0x83, 0x4B, 0x9E, 0x29, 0x21, 0xF5, 0x29, 0x32, 0x9C, 0x50, 0x2F, 0x11, 0x39, 0x6E, 0x56, 0x54,
+    0x49, 0x69, 0xAF, 0xD1, 0x72, 0x7B, 0x39, 0x4C, 0xC9, 0x2A, 0x74, 0xF0, 0xDF, 0xBD, 0x67, 0x69,
+    0x9D, 0x2B, 0x00, 0x45, 0x87, 0x11, 0x32, 0x36, 0xD7, 0xE8, 0xB0, 0x1A, 0x12, 0x54, 0x5F, 0x82,
+    0xC0, 0xBA, 0x22, 0x37, 0xAD, 0x37, 0x16, 0xE7, 0x13, 0x0C, 0xA2, 0xB8, 0x22, 0x03, 0xE2, 0x73,
+    0x13, 0x3E, 0x7F, 0x7E, 0x73, 0x22, 0x9B, 0xBA, 0xE5, 0x27, 0x79, 0x46, 0x52, 0xD6, 0x8B, 0xBC,
+    0xDA, 0x2E, 0x9F, 0x25, 0x9F, 0xE4, 0x21, 0xA5, 0xFC, 0x56, 0x13, 0xD0, 0x71, 0x22, 0xDB, 0xB2,
+    0x34, 0x13, 0xB1, 0x2A, 0x3A, 0x86, 0x0C, 0x9D, 0xEB, 0x42, 0x0A, 0xE9, 0xD5, 0x68, 0x4D, 0x6F,
+    0x54, 0xB7, 0x3F, 0x50, 0xF8, 0xD4, 0xEC, 0x1B, 0x59, 0x61, 0xDF, 0x24, 0x43, 0xDD, 0x2D, 0x3B,
+    0x32, 0x05, 0x4D, 0x21, 0x4F, 0x95, 0x80, 0x3E, 0xF4, 0xFA, 0xC3, 0xC5, 0xF6, 0x13, 0xE7, 0xA9,
+    0x04, 0x06, 0xBA, 0x31, 0xE4, 0x53, 0x2B, 0x26, 0x5D, 0x00, 0x53, 0x50, 0x9C, 0x6D, 0x51, 0x85,
+    0xE5, 0xC1, 0x09, 0xA7, 0xBA, 0xD1, 0x18, 0x9D, 0x4A, 0x92, 0x50, 0xB6, 0x03, 0x3D, 0x52, 0x90,
+    0xE6, 0xA5, 0x8B, 0xBF, 0x03, 0x66, 0x93, 0xFF, 0x16, 0x71, 0x9E, 0xE4, 0xF2, 0x46, 0x73, 0x29,
+    0x67, 0xC0, 0x30, 0xCF, 0x2E, 0xF9, 0x62, 0x5B, 0xFE, 0xDE, 0x5D, 0xCE, 0x85, 0x7C, 0xA2, 0xB0,
+    0x78, 0xD0, 0x7E, 0x32, 0x66, 0x29, 0x7A, 0x74, 0x05, 0x1C, 0x2D, 0x60, 0x71, 0x33, 0xFE, 0xB5,
+    0xDC, 0x6C, 0xB7, 0xF0, 0xF2, 0xFB, 0x37, 0x94, 0x2A, 0x16, 0xE8, 0x68, 0x43, 0xCD, 0xF2, 0x52,
+    0xBB, 0x67, 0x90, 0xBF, 0xAB, 0x66, 0xBC, 0x99, 0xC6, 0x09, 0xD9, 0x33, 0x95, 0xDB, 0x41, 0x51,
+    0x73, 0x91, 0x79, 0x65, 0x79, 0x2C, 0x21, 0x47, 0x46, 0x86, 0xD4, 0x05, 0xA3, 0x3B, 0x11, 0x1E,
+    0x9C, 0xA3, 0xCB, 0xB7, 0x06, 0x29, 0xF3, 0x08, 0x81, 0x63, 0x9E, 0xA3, 0x9B, 0x56, 0x17, 0x3C,
+    0x55, 0x68, 0xE0, 0xC0, 0x6A, 0xB0, 0xC7, 0x49, 0x1E, 0x53, 0x33, 0x8B, 0x9A, 0xFC, 0x07, 0x10,
+    0xD8, 0xAE, 0x08, 0xB4, 0xA5, 0x16, 0x8A, 0xAE, 0xEA, 0x69, 0xA7, 0xE0, 0x26, 0xB5, 0xB3, 0xF3,
+    0xBE, 0x53, 0xEB, 0xEC, 0x75, 0x22, 0xAD, 0x78, 0xDA, 0x2B, 0xD7, 0xEF, 0x1D, 0x95, 0xBC, 0xB2,
+    0x17, 0x8D, 0xBA, 0x74, 0x91, 0x68, 0x25, 0x76, 0x1A, 0xE5, 0xF9, 0x8F, 0xBF, 0xFE, 0xED, 0x3F,
+    0xFF, 0xFD, 0xDF, 0xEC, 0x55, 0x18, 0xB0, 0xCB, 0x37, 0xAA, 0xD6, 0xED, 0xD2, 0x78, 0x66, 0xA5,
+    0xD1, 0x59, 0x11, 0xC5, 0x79, 0xFD, 0x08, 0x84, 0x2E, 0x2A, 0x99, 0xB3, 0x8B, 0x96, 0xA0, 0x36,
+    0x30, 0x15, 0x09, 0x1E, 0xBC, 0x15, 0x91, 0xA0, 0x18, 0x88, 0xAE, 0x03, 0x43, 0x5D, 0x11, 0x27,
+    0xA9, 0x2F, 0xDB, 0xF9, 0xE9, 0x08, 0x47, 0x15, 0x0B, 0xEB, 0xBE, 0xF4, 0x2D, 0x22, 0xA7, 0x83,
+    0xAA, 0x24, 0x01, 0xF9, 0x59, 0x32, 0x27, 0x91, 0x50, 0xE7, 0x9F, 0x3A, 0xCA, 0x0B, 0x98, 0x09,
+    0xBA, 0xD7, 0x82, 0x40, 0x1F, 0xE0, 0x48, 0x6B, 0x69, 0x5B, 0x85, 0xE5, 0xB8, 0x49, 0x9D, 0x83,
+    0x1B, 0x7A, 0x5F, 0xB5, 0x5E, 0x14, 0x26, 0x1D, 0x0C, 0xAB, 0x86, 0xB5, 0x3E, 0xCD, 0x6A, 0x87,
+    0xE9, 0xE6, 0x16, 0x5C, 0xD9, 0xA3, 0xB1, 0x95, 0x07, 0xF5, 0x01, 0x97, 0x9D, 0x38, 0x38, 0x1E,
+    0xFE, 0x5C, 0xEB, 0xC6, 0x6D, 0x0B, 0x66, 0x14, 0x70, 0x4C, 0x16, 0x43, 0x54, 0x7E, 0x75, 0xA5,
+    0x2A, 0xF0, 0x4E, 0xEC, 0x30, 0x7C, 0xE4, 0x74, 0x95, 0xB0, 0xDE, 0xE9, 0xAB, 0xB2, 0x6B, 0xA5,
+    0x27, 0xB6, 0x65, 0x9B, 0x29, 0x49, 0x6F, 0x3C, 0xD6, 0x7A, 0x74, 0x1F, 0xA6, 0x26, 0xE9, 0xB2,
+    0xE5, 0xD5, 0x2E, 0x9D, 0xE1, 0x2A, 0x4F, 0x37, 0xB3, 0x62, 0x69, 0xA5, 0x15, 0xBA, 0x0D, 0x08,
+    0x28, 0x7C, 0x9F, 0xAC, 0x10, 0x7E, 0x47, 0xF7, 0x6F, 0xD9, 0x1A, 0xAF, 0x5E, 0x3B, 0x72, 0x06,
+    0x95, 0xDB, 0x3D, 0x36, 0x5F, 0xAC, 0xB6, 0xBD, 0x57, 0xA1, 0xFC, 0x92, 0xE4, 0x0D, 0x2C, 0x87,
+    0x67, 0xD4, 0x87, 0xDC, 0x87, 0xB1, 0x0E, 0x6B, 0xF3, 0x19, 0x8F, 0x97, 0x27, 0x8D, 0x98, 0x29,
+    0x08, 0x39, 0xE3, 0xF2, 0xA0, 0xAC, 0x41, 0x19, 0x3A, 0x2F, 0x9C, 0x8E, 0x2E, 0x33, 0x99, 0x7B,
+    0xB7, 0x00, 0xDF, 0xDC, 0xB9, 0xD3, 0x2E, 0x73, 0x58, 0xBF, 0x5C, 0xE2, 0x6A, 0x7F, 0x57, 0x9C,
+    0x0A, 0xA0, 0x04, 0xB3, 0x44, 0x62, 0x4A, 0xC4, 0xE9, 0x16, 0x07, 0x26, 0x37, 0x74, 0x6A, 0x87,
+    0xA5, 0x57, 0x90, 0x69, 0xB7, 0x69, 0x8B, 0xBE, 0x6E, 0x75, 0xE7, 0xCD, 0x67, 0x9A, 0xC5, 0x2D,
+    0x99, 0xF2, 0xEC, 0x72, 0x79, 0x5A, 0x79, 0xDF, 0x8E, 0xE7, 0xF2, 0xE0, 0x92, 0xFA, 0x8D, 0x5B,
+    0x77, 0x3A, 0xCD, 0xC1, 0xD9, 0x7A, 0x9F, 0xF3, 0x36, 0xDB, 0x5E, 0xAF, 0x2C, 0x06, 0xE6, 0x64,
+    0xB6, 0x7A, 0x5A, 0x52, 0x5E, 0xCF, 0x5B, 0x1E, 0x89, 0xDC, 0x55, 0x1D, 0xCC, 0xB2, 0x42, 0x20,
+    0xE3, 0x24, 0xC3, 0x62, 0xA3, 0xDB, 0x39, 0x30, 0x0F, 0xDA, 0x16, 0x76, 0xD1, 0x89, 0xCA, 0x04,
+    0xAB, 0x10, 0xF8, 0x61, 0x6F, 0x6F, 0x7F, 0xF7, 0x19, 0x3B, 0xB0, 0xDE, 0x95, 0x82, 0x73, 0xCD,
+    0xB5, 0x6E, 0x6E, 0x52, 0x50, 0x95, 0x11, 0x3D, 0xAC, 0x15, 0x1B, 0x8C, 0xFE, 0x80, 0x66, 0xEC,
+    0x0A, 0xD0, 0xEF, 0x68, 0xC7, 0xAE, 0x42, 0xBA, 0xB5, 0x21, 0xFB, 0xBF, 0xA7, 0xCD, 0x59, 0xE9,
+    0x0F, 0xFD, 0xB7, 0xF7, 0x3B, 0x1F, 0xDA, 0xE6, 0xBC, 0x4F, 0x53, 0xB3, 0xE8, 0xFE, 0xCD, 0xD0,
+    0xA9, 0xA0, 0x6B, 0xB8, 0x4B, 0x04, 0x38, 0xED, 0x36, 0xCE, 0xE7, 0xB1, 0x20, 0x3F, 0xE0, 0x0C,
+    0x3E, 0x9B, 0x87, 0x2D, 0x68, 0x9D, 0x73, 0x6A, 0x88, 0xD5, 0x38, 0xFD, 0xC5, 0x0E, 0x01, 0x16,
+    0xDB, 0x9A, 0x15, 0x42, 0x2D, 0xB6, 0x69, 0x6E, 0x25, 0x64, 0x2A, 0xE4, 0xE5, 0xE8, 0x77, 0x9B,
+    0x6E, 0xD1, 0x46, 0xBE, 0xD0, 0x72, 0x64, 0x4B, 0xF7, 0xF6, 0x43, 0xC3, 0x22, 0xFD, 0x36, 0x6C,
+    0xA1, 0xAD, 0x47, 0xFE, 0xCC, 0x66, 0xE3, 0x65, 0xA3, 0x74, 0xBF, 0x34, 0x97, 0xCE, 0x4A, 0xD2,
+    0x6D, 0x7A, 0x22, 0x8F, 0x6E, 0xF3, 0x76, 0x2E, 0xB5, 0x1C, 0x26, 0x49, 0x88, 0xCA, 0x0B, 0xE8,
+    0x38, 0xA7, 0x9C, 0x3A, 0x7C, 0xC6, 0xC5, 0x6D, 0x67, 0x5D, 0x4C, 0x29, 0x4E, 0x37, 0x54, 0x30,
+    0xC8, 0x64, 0x4D, 0xC2, 0xA8, 0x72, 0x81, 0x21, 0xE0, 0x94, 0x93, 0xDE, 0x8B, 0x44, 0x86, 0xC9,
+    0xA2, 0xBF, 0x18, 0xC9, 0x15, 0x22, 0x5F, 0x74, 0xBE, 0x87, 0x48, 0x0C, 0x7A, 0x44, 0xA6, 0xD6,
+    0xEF, 0x65, 0x05, 0x16, 0x2E, 0xEE, 0x47, 0xEA, 0x47, 0x73, 0xD2, 0x88, 0xC9, 0xEB, 0xE1, 0x39,
+    0xB0, 0x09, 0x92, 0x7D, 0x2F, 0xD2, 0xEC, 0x3D, 0xB9, 0x55, 0xE9, 0x3D, 0x7B, 0x76, 0x33, 0x69,
+    0x7F, 0xBA, 0x9B, 0x34, 0x04, 0x66, 0x88, 0x33, 0xD5, 0xCE, 0xD1, 0x87, 0x0F, 0x9F, 0x28, 0xF7,
+    0x4E, 0xF5, 0xDD, 0x8A, 0xE0, 0x0E, 0x02, 0x6F, 0x3F, 0x04, 0xA7, 0xBE, 0x70, 0x88, 0xFE, 0xB7,
+    0x72, 0x88, 0x0E, 0x43, 0x33, 0x06, 0xEE, 0xDB, 0xD3, 0x13, 0xDD, 0xA2, 0xDA, 0xB9, 0xD9, 0x19,
+    0x6F, 0x99, 0x37, 0x9B, 0x68, 0x0F, 0x2E, 0x65, 0x1C, 0x12, 0x59, 0xBB, 0x73, 0xCF, 0x93, 0xD9,
+    0x73, 0x22, 0xD5, 0x10, 0x8E, 0xA2, 0xA1, 0xF4, 0x53, 0x17, 0x66, 0x63, 0x7D, 0x3B, 0x8B, 0x2A,
+    0x43, 0x94, 0xD6, 0x98, 0xF9, 0x17, 0x07, 0x86, 0x29, 0x80, 0x25, 0x03, 0x9B, 0x32, 0xA1, 0x05,
+    0x49, 0x59, 0x56, 0xC4, 0xF5, 0x2C, 0x6A, 0x5A, 0xEB, 0xA0, 0xFA, 0xB0, 0x53, 0xDA, 0xD7, 0xC8,
+    0x7F, 0x70, 0x29, 0xD6, 0x58, 0xAE, 0x6C, 0x99, 0xB4, 0xCC, 0x70, 0xDD, 0x7A, 0xCA, 0xB2, 0xD5,
+    0x8D, 0x8F, 0xCF, 0x98, 0xD2, 0xC1, 0x22, 0xC9, 0x33, 0x7B, 0x7D, 0x78, 0xED, 0xBE, 0x97, 0x07,
+    0x9F, 0x53, 0xA2, 0xF2, 0xA5, 0xB9, 0x7D, 0x63, 0xCB, 0x5D, 0x95, 0x31, 0xF2, 0x5C, 0x07, 0x3A,
+    0x01, 0x85, 0x8C, 0xAE, 0xE4, 0x1A, 0xFB, 0x37, 0x75, 0xF4, 0x24, 0xF1, 0x73, 0x69, 0x5D, 0x01,
+    0xB5, 0xFF, 0xA9, 0x3E, 0xA4, 0x84, 0x30, 0x8F, 0x43, 0xE2, 0x1E, 0xEE, 0x07, 0x29, 0xD5, 0xBE,
+    0x74, 0x00, 0xBE, 0xE3, 0xD5, 0x4B, 0xAD, 0xFF, 0x5B, 0xA7, 0x8C, 0xCB, 0x50, 0xF2, 0xF7, 0x1B,
+    0x7E, 0x75, 0xFB, 0x59, 0x46, 0x98, 0xDA, 0xCF, 0xB6, 0x88, 0xBB, 0x66, 0xE2, 0x6D, 0x5C, 0x0F,
+    0x29, 0x66, 0x62, 0xF4, 0xA2, 0x1F, 0x70, 0x27, 0x68, 0x33, 0x4D, 0xF8, 0x2D, 0x8F, 0xD2, 0xC5,
+    0x36, 0x14, 0xC7, 0x74, 0x0B, 0x22, 0xAC, 0xF0, 0xED, 0xBD, 0x1E, 0xD8, 0x62, 0x25, 0x96, 0x4C,
+    0x97, 0x0B, 0x67, 0xF0, 0x9A, 0x7E, 0x50, 0x29, 0x51, 0xD4, 0x4D, 0xD0, 0xC7, 0x56, 0x8B, 0xEF,
+    0x67, 0xD1, 0x99, 0x56, 0x78, 0xD4, 0xE6, 0x3B, 0xBC, 0x39, 0xDD, 0x39, 0x2C, 0xAF, 0x3C, 0xD2,
+    0x9A, 0x95, 0x7B, 0x8E, 0x2C, 0x47, 0x53, 0x5B, 0x1A, 0xCC, 0xCE, 0xEA, 0x01, 0xA5, 0x71, 0xE6,
+    0xFF, 0x1F, 0x6A, 0xFE, 0x07, 0x43, 0x8D, 0x71, 0xD2, 0x0F, 0x0D, 0x34, 0x7A, 0xB5, 0xEE, 0x2C,
+    0xA2, 0x4F, 0x6B, 0x11, 0x46, 0xBA, 0xC9, 0x8F, 0xCE, 0x7B, 0x2C, 0x42, 0x4C, 0x1E, 0x3D, 0x58,
+    0x0F, 0x45, 0xCD, 0xD5, 0x58, 0x73, 0x4B, 0x74, 0xD1, 0xA5, 0xA6, 0x29, 0xFB, 0xE9, 0x20, 0xDB,
+    0x16, 0x94, 0xF6, 0x01, 0x71, 0xD5, 0x57, 0x9D, 0x31, 0xB0, 0xE8, 0xFF, 0xAF, 0xF4, 0xBF, 0x00,
+    0xFF, 0xD7, 0x6B, 0x27, 0x6F, 0x3A, 0x00, 0x00,
+};
+
+// style.css: 2841 bytes, 1116 gzipped
+static const uint8_t WEB_STYLE_CSS_GZ[] = {
+    0x1F, 0x8B, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x9D, 0x56, 0xCF, 0xAF, 0xA3, 0x36,
+    0x10, 0xBE, 0xE7, 0xAF, 0x40, 0x5A, 0x55, 0xBB, 0xFB, 0x14, 0xB2, 0x36, 0x21, 0xBC, 0x04, 0xD4,
+    0x43, 0xD5, 0x53, 0x0F, 0xBD, 0x74, 0xB7, 0xA7, 0x6A, 0x0F, 0x06, 0xDB, 0x60, 0x3D, 0x62, 0x23,
+    0xDB, 0x6C, 0x92, 0xA2, 0xF7, 0xBF, 0x77, 0x6C, 0x20, 0x40, 0x82, 0xD4, 0xAA, 0xEF, 0x49, 0x51,
+    0x3C, 0x9E, 0x9F, 0xDF, 0xCC, 0x7C, 0xCE, 0x97, 0x97, 0xE0, 0x6B, 0x45, 0x34, 0xA3, 0x41, 0x7E,
+    0x0B, 0x6C, 0xC5, 0x02, 0x21, 0x29, 0xBB, 0x06, 0x0D, 0x29, 0xD9, 0xD6, 0x9F, 0x35, 0x33, 0x6D,
+    0x6D, 0x8D, 0x97, 0x04, 0x44, 0x52, 0x2F, 0x34, 0x96, 0xD8, 0xB6, 0x97, 0x99, 0xE0, 0xE5, 0xCB,
+    0xE6, 0xA5, 0xCB, 0xD5, 0x35, 0x34, 0xE2, 0x6F, 0x21, 0xCB, 0x34, 0x57, 0x9A, 0x32, 0x1D, 0x82,
+    0xE4, 0x7D, 0x93, 0x2B, 0x7A, 0xEB, 0xCE, 0x44, 0x97, 0x42, 0xA6, 0x28, 0x6B, 0x08, 0xA5, 0x4E,
+    0x23, 0x8A, 0x9B, 0x6B, 0x96, 0x93, 0xE2, 0xAD, 0xD4, 0xAA, 0x95, 0x34, 0xFD, 0x80, 0x38, 0xE2,
+    0xD1, 0x3E, 0x2B, 0x54, 0xAD, 0x74, 0xFA, 0x81, 0x25, 0x9C, 0x33, 0x96, 0x71, 0x25, 0x6D, 0xC8,
+    0xC9, 0x59, 0xD4, 0xB7, 0xF4, 0xE3, 0x57, 0x56, 0x2A, 0x16, 0xFC, 0xF9, 0xDB, 0xC7, 0xED, 0x37,
+    0x52, 0xA9, 0x33, 0xD9, 0xFE, 0xA2, 0x05, 0xA9, 0xB7, 0x86, 0x48, 0x13, 0x1A, 0xA6, 0x05, 0x7F,
+    0xDF, 0xEC, 0x0A, 0x30, 0x20, 0x42, 0x32, 0xBD, 0xDD, 0x15, 0x44, 0xD3, 0x7B, 0xDC, 0x80, 0xB4,
+    0x56, 0x2D, 0xE2, 0x61, 0x82, 0x79, 0x94, 0x67, 0x7D, 0xA6, 0x29, 0x6E, 0xAE, 0x81, 0x51, 0xB5,
+    0xA0, 0xC1, 0x87, 0x28, 0xDA, 0xE3, 0x98, 0x0C, 0x17, 0xA1, 0x26, 0x54, 0xB4, 0x26, 0xC5, 0x2E,
+    0xDD, 0x4D, 0xF0, 0xF8, 0xE7, 0x4B, 0xAE, 0x08, 0x55, 0x17, 0x08, 0x81, 0x11, 0x38, 0x89, 0x8E,
+    0xF0, 0xA1, 0xCB, 0x9C, 0x7C, 0x42, 0x5B, 0xF7, 0xBF, 0x8B, 0x0F, 0x9F, 0xA7, 0xA2, 0x23, 0xF0,
+    0xA2, 0x7E, 0x30, 0xCD, 0x6B, 0xB0, 0xA8, 0x04, 0xA5, 0x4C, 0xCE, 0x93, 0x86, 0x74, 0xAF, 0xE1,
+    0x45, 0x50, 0x5B, 0xA5, 0xA7, 0x23, 0x78, 0x73, 0x77, 0x7D, 0x15, 0xA3, 0xF8, 0x35, 0x9A, 0xC4,
+    0x3B, 0x10, 0xB1, 0xD9, 0x1D, 0xC6, 0xC8, 0x5F, 0x56, 0x78, 0x2A, 0x1B, 0x05, 0x2E, 0x1F, 0xD4,
+    0x03, 0x09, 0xCD, 0x61, 0xE9, 0x1E, 0x74, 0xFA, 0xE3, 0x85, 0x89, 0xB2, 0xB2, 0xE9, 0x2B, 0x42,
+    0x23, 0xEA, 0xA7, 0x9C, 0xBD, 0x92, 0x04, 0x3C, 0x44, 0xDD, 0x83, 0x64, 0x67, 0x58, 0x61, 0x85,
+    0x92, 0x41, 0xB5, 0x1F, 0x9C, 0x87, 0x56, 0x35, 0xE9, 0x93, 0xE5, 0xEE, 0xDC, 0x5A, 0x46, 0x47,
+    0x6B, 0x72, 0x2C, 0xF2, 0xFC, 0x30, 0x0B, 0xEE, 0x60, 0x04, 0x25, 0x2A, 0xCE, 0xA3, 0x4A, 0x4C,
+    0x12, 0x74, 0x44, 0x53, 0x80, 0x31, 0x75, 0x9C, 0xF8, 0xBC, 0x47, 0xE4, 0xDC, 0xF1, 0x3F, 0xF7,
+    0x0A, 0x3D, 0x8D, 0x16, 0x8E, 0x23, 0x88, 0x61, 0xD9, 0xD5, 0xC2, 0x9C, 0x93, 0xAD, 0x90, 0x4D,
+    0x6B, 0xFF, 0xB2, 0xB7, 0x86, 0xFD, 0x2C, 0xDB, 0x73, 0xCE, 0xF4, 0xF7, 0xB9, 0x48, 0x13, 0x59,
+    0xB2, 0xEF, 0xDD, 0x00, 0x2A, 0x42, 0x3F, 0x65, 0x0F, 0xF8, 0x4F, 0x59, 0xA1, 0x7B, 0x56, 0x63,
+    0xF0, 0xE3, 0x7A, 0x9E, 0x24, 0x46, 0x07, 0xBE, 0x32, 0x40, 0xF3, 0x59, 0x9A, 0x67, 0x7C, 0xC2,
+    0x08, 0xE7, 0x23, 0xB8, 0x94, 0xF3, 0x84, 0x25, 0x8B, 0x65, 0xF8, 0x55, 0x49, 0x70, 0x4D, 0xCC,
+    0xF6, 0x77, 0x26, 0x6B, 0xB5, 0x3D, 0x2B, 0xA9, 0x4C, 0x43, 0x0A, 0x36, 0x15, 0xD9, 0x5D, 0x2A,
+    0x61, 0x59, 0xE8, 0xA5, 0x69, 0xA3, 0x59, 0x78, 0xD1, 0xA4, 0xB9, 0x0F, 0x9F, 0x3F, 0xA5, 0x44,
+    0xDE, 0x2E, 0x15, 0xD3, 0x2C, 0xBB, 0x40, 0xC6, 0x61, 0x0E, 0x56, 0x6F, 0xA9, 0xFF, 0x0C, 0x9D,
+    0x20, 0x7B, 0xDF, 0xD4, 0x24, 0x67, 0x75, 0x47, 0x85, 0x69, 0x6A, 0x72, 0x4B, 0xF3, 0x5A, 0x15,
+    0x6F, 0xD9, 0xD0, 0x20, 0xDF, 0x1F, 0xE8, 0x5B, 0x6E, 0xE5, 0x5D, 0x41, 0xC8, 0x1A, 0xC6, 0x38,
+    0xEC, 0xF5, 0x56, 0x50, 0xE0, 0x2C, 0x4A, 0x8A, 0xE5, 0x16, 0xD2, 0xFC, 0x74, 0x88, 0xC7, 0x42,
+    0x11, 0x02, 0xB8, 0xC9, 0x00, 0xD3, 0x1C, 0xE4, 0x60, 0xD6, 0xFF, 0x39, 0xD2, 0x45, 0xAB, 0x0D,
+    0x18, 0x36, 0x4A, 0x48, 0xCB, 0x74, 0xE6, 0x6A, 0x0F, 0x29, 0x2B, 0x94, 0x26, 0x6E, 0x96, 0x52,
+    0xA9, 0x24, 0x5B, 0xCC, 0x7A, 0x02, 0xB3, 0x3E, 0xE4, 0xDF, 0x4F, 0x22, 0x64, 0x9F, 0x56, 0x0E,
+    0x94, 0x8E, 0x8B, 0x1A, 0x5C, 0x40, 0xF9, 0x4E, 0x51, 0x32, 0x63, 0x3E, 0xE1, 0x1D, 0x3A, 0x7C,
+    0x7E, 0xDF, 0x90, 0x71, 0x54, 0x5F, 0x8F, 0x1C, 0x91, 0x23, 0x08, 0x76, 0x50, 0xE5, 0x5B, 0xB7,
+    0x16, 0x0C, 0x3C, 0x6A, 0x75, 0xB9, 0xE3, 0xC1, 0x6B, 0x76, 0xCD, 0x4A, 0x00, 0xDA, 0x0F, 0x8A,
+    0x3B, 0xF5, 0xB8, 0xFB, 0x56, 0x90, 0x5A, 0x94, 0x32, 0x84, 0x1E, 0x9D, 0x4D, 0x5A, 0x30, 0x97,
+    0x3F, 0x58, 0x13, 0xBF, 0x04, 0x66, 0xBE, 0x63, 0xB8, 0xDF, 0x78, 0x03, 0x10, 0x42, 0xF1, 0x13,
+    0x57, 0x2C, 0x82, 0x3C, 0x3B, 0xEB, 0xE3, 0x3A, 0xC2, 0x19, 0x37, 0x0A, 0x0D, 0x1D, 0xEB, 0x3D,
+    0x75, 0xCE, 0x2E, 0xC5, 0xB3, 0xD9, 0x8E, 0xD1, 0x22, 0xD2, 0x0F, 0x52, 0xB7, 0x40, 0x2F, 0x90,
+    0x45, 0x7F, 0x7D, 0x7C, 0x24, 0x8E, 0xE4, 0x91, 0x38, 0xE6, 0x8B, 0x9E, 0x78, 0x57, 0x17, 0xA2,
+    0x25, 0xF4, 0xD0, 0x3D, 0x04, 0xDD, 0xBC, 0xED, 0x7B, 0x1A, 0x11, 0xB0, 0x7E, 0x1E, 0x11, 0x1E,
+    0x53, 0xB4, 0xE7, 0xD3, 0x82, 0x45, 0xAB, 0x6D, 0x7F, 0xAC, 0x48, 0x48, 0xAE, 0x5C, 0x8C, 0xAD,
+    0xFF, 0xB6, 0x88, 0x84, 0x50, 0x44, 0x30, 0x59, 0x89, 0x34, 0x4C, 0xDE, 0xFF, 0x88, 0xB4, 0xA4,
+    0xA8, 0xF7, 0xCD, 0xE6, 0xCB, 0x4B, 0xF0, 0x87, 0x7F, 0x22, 0x03, 0x4B, 0xF2, 0xBA, 0x7F, 0x0E,
+    0x77, 0xA6, 0xD0, 0xAA, 0xAE, 0x3D, 0x3D, 0x57, 0x3D, 0x5E, 0xFB, 0x04, 0xCD, 0xE8, 0x3F, 0xBC,
+    0xA5, 0xFE, 0x4D, 0xBA, 0x9F, 0xAF, 0xC3, 0x83, 0xB0, 0xC2, 0x66, 0x10, 0xB8, 0xD4, 0x82, 0xCE,
+    0x29, 0x69, 0x50, 0x02, 0xFC, 0x6B, 0xD2, 0x18, 0x96, 0x8E, 0x5F, 0xB2, 0x87, 0xC9, 0x59, 0x21,
+    0xC2, 0x35, 0xBA, 0x7C, 0x7E, 0x94, 0x5C, 0x40, 0x78, 0xE8, 0xB7, 0xC3, 0x17, 0xDA, 0xDD, 0xDF,
+    0x74, 0x6B, 0xD5, 0x79, 0xB1, 0xD6, 0xC9, 0xFE, 0x10, 0xD3, 0x6C, 0xB9, 0xAF, 0x0E, 0x4E, 0xBF,
+    0x21, 0x7E, 0x32, 0xD3, 0x9A, 0x71, 0x3B, 0x39, 0x5D, 0x76, 0xA8, 0xC0, 0x78, 0xE2, 0xBA, 0xF9,
+    0x24, 0x4D, 0x73, 0x76, 0x37, 0xD5, 0xFD, 0xB6, 0xFA, 0x7C, 0xE6, 0x34, 0x82, 0xF1, 0x29, 0x22,
+    0x83, 0x16, 0xBC, 0xA7, 0x67, 0x60, 0x3D, 0xDB, 0xF9, 0x6E, 0x84, 0xB0, 0x23, 0xAA, 0xB5, 0x29,
+    0x17, 0x57, 0x46, 0xE7, 0xE8, 0xA0, 0x07, 0xF5, 0x7B, 0xB1, 0x93, 0x80, 0x76, 0x63, 0x51, 0x6E,
+    0x16, 0x56, 0x49, 0xD2, 0x6D, 0xBC, 0x31, 0x62, 0x9D, 0x02, 0xA7, 0xE5, 0x79, 0x4D, 0x96, 0x78,
+    0x0C, 0x3B, 0x3A, 0xBA, 0x07, 0x32, 0x0A, 0x8E, 0x4F, 0x03, 0x78, 0x3A, 0x9D, 0x9E, 0xDF, 0xEA,
+    0x21, 0x60, 0xD8, 0x02, 0x05, 0xCD, 0x21, 0x88, 0xC8, 0x7E, 0x1F, 0xDF, 0x99, 0xB4, 0xC8, 0xE9,
+    0x81, 0xE1, 0x51, 0xB7, 0xEC, 0xFE, 0x8D, 0x73, 0x47, 0xCD, 0xDB, 0x42, 0x73, 0xD8, 0xC6, 0x41,
+    0x13, 0xE7, 0x38, 0x9E, 0xE2, 0x2F, 0xD7, 0x8C, 0xF3, 0x13, 0x87, 0x35, 0x1B, 0x35, 0x39, 0x8E,
+    0x26, 0x4D, 0xFD, 0xA0, 0x19, 0x53, 0x98, 0x96, 0x51, 0x13, 0x68, 0xC0, 0x6B, 0x32, 0x59, 0x84,
+    0xAA, 0x61, 0x72, 0x24, 0xDB, 0x41, 0xED, 0xB9, 0x78, 0xA7, 0x78, 0x01, 0xF4, 0x27, 0x45, 0x1F,
+    0x79, 0x5D, 0xB1, 0x54, 0x8A, 0x3E, 0xFD, 0x94, 0xF1, 0x17, 0xD0, 0x40, 0x3B, 0xDE, 0x0C, 0x80,
+    0x3C, 0xB9, 0xF8, 0x07, 0xED, 0x72, 0x59, 0xE7, 0x19, 0x0B, 0x00, 0x00,
+};
+
+static const WebAsset WEB_ASSETS[] = {
+    {"/", "text/html", WEB_INDEX_HTML_GZ, sizeof(WEB_INDEX_HTML_GZ), "\"b564e6be510c367f\"", "no-cache"},
+    {"/style.css", "text/css", WEB_STYLE_CSS_GZ, sizeof(WEB_STYLE_CSS_GZ), "\"9da02d6e7c41cdc0\"", "public, max-age=31536000, immutable"},
+};
@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+"""Decode an OUI-SPY binary baseline capture (/baseline_results.bin or /capture.bin).
+
+Usage:
+    python3 tools/decode_capture.py capture.bin            # CSV to stdout
+    python3 tools/decode_capture.py capture.bin --json     # JSON to stdout
+
+Layout (little-endian), see CaptureHeader / CaptureRecordHead in lib/ouispy_core/src/capture_format.h.
+"""
+import argparse
+import csv
+import json
+import struct
+import sys
+
+CAPTURE_MAGIC = 0x3150434F  # "OCP1"
+HEADER = struct.Struct("<IHHBBhIII")
+RECORD_HEAD = struct.Struct("<H6sBBbBI")
+
+DEV_HAS_RSSI = 0x01
+DEV_WIFI = 0x02
+DEV_HAS_PAYLOAD = 0x04
+DEV_HAS_WIFI_META = 0x08
+DEV_HIDDEN = 0x10
+DEV_RULE_MATCH = 0x20
+
+MODES = {0: "wifi", 1: "ble", 2: "both"}
+AUTH_MODES = {
+    0: "Open", 1: "WEP", 2: "WPA", 3: "WPA2", 4: "WPA/WPA2",
+    5: "WPA2-Enterprise", 6: "WPA3", 7: "WPA2/WPA3", 8: "WAPI",
+}
+CIPHERS = {
+    0: "None", 1: "WEP40", 2: "WEP104", 3: "TKIP", 4: "CCMP",
+    5: "TKIP/CCMP", 6: "AES-CMAC128", 7: "SMS4", 8: "GCMP", 9: "GCMP256",
+}
+
+
+def decode(data):
+    if len(data) < HEADER.size:
+        raise ValueError("file too short for header")
+    (magic, version, header_len, mode, capture_payload, rssi_threshold,
+     duration, built_ms, count) = HEADER.unpack_from(data, 0)
+    if magic != CAPTURE_MAGIC:
+        raise ValueError("bad magic 0x%08X" % magic)
+
+    header = {
+        "version": version,
+        "mode": MODES.get(mode, mode),
+        "capture_payload": bool(capture_payload),
+        "rssi_threshold": rssi_threshold,
+        "duration_secs": duration,
+        "built_ms": built_ms,
+        "record_count": count,
+    }
+
+    records = []
+    off = header_len
+    while off + 2 <= len(data):
+        (rec_len,) = struct.unpack_from("<H", data, off)
+        end = off + 2 + rec_len
+        if end > len(data):
+            print("warning: truncated record at offset %d" % off, file=sys.stderr)
+            break
+
+        _, mac, addr_type, flags, rssi, _, last_seen = RECORD_HEAD.unpack_from(data, off)
+        p = off + RECORD_HEAD.size
+        rec = {
+            "mac": ":".join("%02X" % b for b in mac),
+            "source": "Wi-Fi" if flags & DEV_WIFI else "BLE",
+            "rssi": rssi if flags & DEV_HAS_RSSI else None,
+            "addr_type": addr_type,
+            "last_seen_ms": last_seen,
+            "hidden": bool(flags & DEV_HIDDEN),
+            "rule_match": bool(flags & DEV_RULE_MATCH),
+        }
+
+        if flags & DEV_HAS_WIFI_META:
+            channel, auth, pairwise, group = struct.unpack_from("<BBBB", data, p)
+            p += 4
+            rec.update({
+                "channel": channel,
+                "encryption": AUTH_MODES.get(auth, str(auth)),
+                "pairwise_cipher": CIPHERS.get(pairwise, str(pairwise)),
+                "group_cipher": CIPHERS.get(group, str(group)),
+            })
+
+        name_len = data[p]
+        rec["name"] = data[p + 1:p + 1 + name_len].decode("utf-8", "replace")
+        p += 1 + name_len
+
+        payload_len = data[p]
+        rec["payload"] = data[p + 1:p + 1 + payload_len].hex()
+
+        records.append(rec)
+        off = end
+
+    if len(records) != count:
+        print("warning: header says %d records, decoded %d" % (count, len(records)),
+              file=sys.stderr)
+    return header, records
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("capture")
+    ap.add_argument("--json", action="store_true", help="emit JSON instead of CSV")
+    args = ap.parse_args()
+
+    with open(args.capture, "rb") as f:
+        header, records = decode(f.read())
+
+    if args.json:
+        json.dump({"header": header, "records": records}, sys.stdout, indent=2)
+        sys.stdout.write("\n")
+        return
+
+    cols = ["mac", "source", "rssi", "channel", "encryption", "pairwise_cipher",
+            "group_cipher", "hidden", "rule_match", "name", "addr_type", "last_seen_ms", "payload"]
+    w = csv.DictWriter(sys.stdout, fieldnames=cols, extrasaction="ignore")
+    w.writeheader()
+    for rec in records:
+        w.writerow(rec)
+
+
+if __name__ == "__main__":
+    main()
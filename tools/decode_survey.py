@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+"""Decode OUI-SPY continuous survey snapshots (/survey.bin).
+
+Usage:
+    python3 tools/decode_survey.py survey.bin            # CSV to stdout
+    python3 tools/decode_survey.py survey.bin --json     # JSON to stdout
+
+Layout (little-endian), see SurveySnapshotHeader in src/main.cpp. Each
+snapshot lists only devices seen since the previous one; "samples" is the
+running total reconstructed from the per-snapshot deltas (it starts from the
+oldest snapshot still in the ring).
+"""
+import argparse
+import csv
+import json
+import struct
+import sys
+
+SURVEY_MAGIC = 0x3153534F  # "OSS1"
+HEADER = struct.Struct("<IIIIHHB3x")
+SURVEY_TRUNCATED = 0x01
+
+DEV_WIFI = 0x02
+
+
+def read_varint(data, p):
+    v = 0
+    shift = 0
+    while True:
+        b = data[p]
+        p += 1
+        v |= (b & 0x7F) << shift
+        if not b & 0x80:
+            return v, p
+        shift += 7
+
+
+def i8(b):
+    return b - 256 if b > 127 else b
+
+
+def decode(data):
+    snapshots = []
+    totals = {}
+    off = 0
+    while off + HEADER.size <= len(data):
+        magic, total_len, snap_id, time_ms, count, interval, flags = HEADER.unpack_from(data, off)
+        if magic != SURVEY_MAGIC:
+            raise ValueError("bad magic 0x%08X at offset %d" % (magic, off))
+        end = off + total_len
+        if end > len(data):
+            print("warning: truncated snapshot %d at offset %d" % (snap_id, off), file=sys.stderr)
+            break
+
+        p = off + HEADER.size
+        records = []
+        for _ in range(count):
+            mac = ":".join("%02X" % b for b in data[p:p + 6])
+            dev_flags = data[p + 6]
+            p += 7
+            first_ago_s, p = read_varint(data, p)
+            last_ago_ds, p = read_varint(data, p)
+            delta, p = read_varint(data, p)
+            rssi_min, rssi_max, rssi_mean = (i8(b) for b in data[p:p + 3])
+            p += 3
+            totals[mac] = totals.get(mac, 0) + delta
+            records.append({
+                "mac": mac,
+                "source": "Wi-Fi" if dev_flags & DEV_WIFI else "BLE",
+                "first_seen_ms": time_ms - first_ago_s * 1000,
+                "last_seen_ms": time_ms - last_ago_ds * 100,
+                "samples_delta": delta,
+                "samples": totals[mac],
+                "rssi_min": rssi_min,
+                "rssi_max": rssi_max,
+                "rssi_mean": rssi_mean,
+            })
+
+        snapshots.append({
+            "id": snap_id,
+            "time_ms": time_ms,
+            "interval_secs": interval,
+            "truncated": bool(flags & SURVEY_TRUNCATED),
+            "records": records,
+        })
+        off = end
+    return snapshots
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("survey")
+    ap.add_argument("--json", action="store_true", help="emit JSON instead of CSV")
+    args = ap.parse_args()
+
+    with open(args.survey, "rb") as f:
+        snapshots = decode(f.read())
+
+    if args.json:
+        json.dump({"snapshots": snapshots}, sys.stdout, indent=2)
+        sys.stdout.write("\n")
+        return
+
+    cols = ["snapshot", "time_ms", "mac", "source", "first_seen_ms", "last_seen_ms",
+            "samples_delta", "samples", "rssi_min", "rssi_max", "rssi_mean"]
+    w = csv.DictWriter(sys.stdout, fieldnames=cols)
+    w.writeheader()
+    for snap in snapshots:
+        for rec in snap["records"]:
+            w.writerow(dict(rec, snapshot=snap["id"], time_ms=snap["time_ms"]))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+"""Generate lib/ouispy_core/src/company_ids.h from the Bluetooth SIG company identifier list.
+
+Usage:
+    python3 tools/gen_company_ids.py company_identifiers.yaml > lib/ouispy_core/src/company_ids.h
+
+The input is assigned_numbers/company_identifiers/company_identifiers.yaml
+from the Bluetooth SIG "public" assigned numbers repository. Only the
+`value:` / `name:` pairs are read, so PyYAML is not required. The output is
+sorted by ID for the binary search in getCompanyName().
+"""
+import argparse
+import re
+import sys
+
+VALUE_RE = re.compile(r"^\s*-\s*value:\s*(0x[0-9A-Fa-f]+|\d+)\s*$")
+NAME_RE = re.compile(r"^\s*name:\s*(.+?)\s*$")
+
+
+def unquote(s):
+    if len(s) >= 2 and s[0] == s[-1] == "'":
+        return s[1:-1].replace("''", "'")
+    if len(s) >= 2 and s[0] == s[-1] == '"':
+        return s[1:-1].replace('\\"', '"').replace("\\\\", "\\")
+    return s
+
+
+def read_ids(lines):
+    ids = {}
+    value = None
+    for line in lines:
+        m = VALUE_RE.match(line)
+        if m:
+            value = int(m.group(1), 0)
+            continue
+        m = NAME_RE.match(line)
+        if m and value is not None:
+            ids[value] = unquote(m.group(1))
+            value = None
+    return ids
+
+
+def c_string(s):
+    # UTF-8 bytes outside printable ASCII become octal escapes
+    out = []
+    for b in s.encode("utf-8"):
+        c = chr(b)
+        if c in "\\\"":
+            out.append("\\" + c)
+        elif 0x20 <= b < 0x7F:
+            out.append(c)
+        else:
+            out.append("\\%03o" % b)
+    return '"' + "".join(out) + '"'
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("yaml")
+    args = ap.parse_args()
+
+    with open(args.yaml, encoding="utf-8") as f:
+        ids = read_ids(f)
+    if not ids:
+        sys.exit("no company identifiers found in %s" % args.yaml)
+
+    w = sys.stdout.write
+    w("// Bluetooth SIG company identifiers, sorted by ID.\n")
+    w("// Generated by tools/gen_company_ids.py, do not edit by hand.\n")
+    w("#pragma once\n\n")
+    w("#include <stdint.h>\n\n")
+    w("struct CompanyId {\n")
+    w("    uint16_t id;\n")
+    w("    const char* name;\n")
+    w("};\n\n")
+    w("constexpr CompanyId COMPANY_IDS[] = {\n")
+    for value in sorted(ids):
+        w("    {0x%04X, %s},\n" % (value, c_string(ids[value])))
+    w("};\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+"""Generate src/web_assets.h from the static web UI in web/.
+
+Usage:
+    python3 tools/gen_web_assets.py web > src/web_assets.h
+    python3 tools/gen_web_assets.py web -o src/web_assets.h   # rewrite only if changed
+
+Every file in the directory is gzipped (fixed mtime, so the output only
+changes when the input does) and emitted as a byte array with its content
+type, Cache-Control and an ETag derived from the file contents. index.html
+is served at "/", everything else at "/<file name>".
+
+Pages are revalidated on every load (no-cache + ETag, so usually a 304).
+Other assets are cached for a year: references to them in the HTML files
+get a ?v=<hash> suffix here, and the firmware links them through the
+WEB_<NAME>_URL constants, so a changed file always gets a new URL.
+
+platformio.ini runs this before every build (tools/pio_web_assets.py).
+"""
+import argparse
+import gzip
+import hashlib
+import io
+import os
+import re
+import sys
+
+CONTENT_TYPES = {
+    ".html": "text/html",
+    ".css": "text/css",
+    ".js": "application/javascript",
+    ".json": "application/json",
+    ".svg": "image/svg+xml",
+    ".png": "image/png",
+    ".ico": "image/x-icon",
+}
+
+
+PAGE_CACHE = "no-cache"
+ASSET_CACHE = "public, max-age=31536000, immutable"
+
+
+def symbol(name, suffix):
+    return "WEB_" + re.sub(r"[^0-9A-Za-z]", "_", name).upper() + "_" + suffix
+
+
+def content_hash(raw):
+    return hashlib.sha1(raw).hexdigest()[:16]
+
+
+def generate(webdir, out):
+    names = sorted(n for n in os.listdir(webdir)
+                   if os.path.isfile(os.path.join(webdir, n)) and not n.startswith("."))
+    if not names:
+        sys.exit("no assets found in %s" % webdir)
+
+    sources = {}
+    for name in names:
+        with open(os.path.join(webdir, name), "rb") as f:
+            sources[name] = f.read()
+
+    # Version the non-page assets first so the pages can reference them
+    versions = {n: content_hash(raw)[:8] for n, raw in sources.items() if not n.endswith(".html")}
+    for name in names:
+        if not name.endswith(".html"):
+            continue
+        text = sources[name].decode("utf-8")
+        for ref, ver in versions.items():
+            text = re.sub(r'((?:href|src)=")/%s"' % re.escape(ref), r'\1/%s?v=%s"' % (ref, ver), text)
+        sources[name] = text.encode("utf-8")
+
+    w = out.write
+    w("// Gzipped web UI assets, sorted by file name.\n")
+    w("// Generated by tools/gen_web_assets.py from web/, do not edit by hand.\n")
+    w("#pragma once\n\n")
+    w("#include <stddef.h>\n")
+    w("#include <stdint.h>\n\n")
+    w("struct WebAsset {\n")
+    w("    const char* path;\n")
+    w("    const char* contentType;\n")
+    w("    const uint8_t* gz;\n")
+    w("    size_t gzLen;\n")
+    w("    const char* etag;\n")
+    w("    const char* cacheControl;\n")
+    w("};\n\n")
+
+    for name, ver in sorted(versions.items()):
+        w('static const char* const %s = "/%s?v=%s";\n' % (symbol(name, "URL"), name, ver))
+    if versions:
+        w("\n")
+
+    table = []
+    for name in names:
+        ext = os.path.splitext(name)[1].lower()
+        if ext not in CONTENT_TYPES:
+            sys.exit("unknown content type for %s" % name)
+        raw = sources[name]
+        gz = gzip.compress(raw, compresslevel=9, mtime=0)
+        etag = content_hash(raw)
+        sym = symbol(name, "GZ")
+
+        w("// %s: %d bytes, %d gzipped\n" % (name, len(raw), len(gz)))
+        w("static const uint8_t %s[] = {\n" % sym)
+        for i in range(0, len(gz), 16):
+            w("    " + ", ".join("0x%02X" % b for b in gz[i:i + 16]) + ",\n")
+        w("};\n\n")
+        path = "/" if name == "index.html" else "/" + name
+        cache = PAGE_CACHE if ext == ".html" else ASSET_CACHE
+        table.append((path, CONTENT_TYPES[ext], sym, etag, cache))
+
+    w("static const WebAsset WEB_ASSETS[] = {\n")
+    for path, ctype, sym, etag, cache in table:
+        w('    {"%s", "%s", %s, sizeof(%s), "\\"%s\\"", "%s"},\n' % (path, ctype, sym, sym, etag, cache))
+    w("};\n")
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("webdir")
+    ap.add_argument("-o", "--output", help="write here instead of stdout, only if the content changed")
+    args = ap.parse_args()
+
+    if not args.output:
+        generate(args.webdir, sys.stdout)
+        return
+
+    buf = io.StringIO()
+    generate(args.webdir, buf)
+    text = buf.getvalue()
+    try:
+        with open(args.output, encoding="utf-8") as f:
+            if f.read() == text:
+                return
+    except FileNotFoundError:
+        pass
+    with open(args.output, "w", encoding="utf-8") as f:
+        f.write(text)
+    print("gen_web_assets: wrote %s" % args.output, file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,7 @@
+# PlatformIO pre-build hook for env:native_asan: compile and link the core
+# and the host harness with AddressSanitizer and UndefinedBehaviorSanitizer.
+# Set here because build_flags only reach the compiler, not the linker.
+Import("env")  # noqa: F821 (provided by PlatformIO)
+
+SANITIZE = ["-fsanitize=address,undefined", "-fno-sanitize-recover=undefined"]
+env.Append(CCFLAGS=SANITIZE, LINKFLAGS=SANITIZE)  # noqa: F821
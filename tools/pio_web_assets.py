@@ -0,0 +1,15 @@
+# PlatformIO pre-build hook: regenerate src/web_assets.h from web/.
+# The generator leaves the header untouched when nothing changed, so
+# unchanged assets don't trigger a rebuild.
+import os
+import subprocess
+
+Import("env")  # noqa: F821 (provided by PlatformIO)
+
+root = env.subst("$PROJECT_DIR")  # noqa: F821
+subprocess.check_call([
+    env.subst("$PYTHONEXE"),  # noqa: F821
+    os.path.join(root, "tools", "gen_web_assets.py"),
+    os.path.join(root, "web"),
+    "-o", os.path.join(root, "src", "web_assets.h"),
+])